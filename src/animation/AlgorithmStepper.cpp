@@ -0,0 +1,52 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+
+#include "AlgorithmStepper.hpp"
+#include "graph/Graph.hpp"
+#include "stats/Trace.hpp"
+
+/*
+Initializes the variables.
+*/
+AlgorithmStepper::AlgorithmStepper(Graph* graph) :
+    graph(graph),
+    graph_representation(graph->getGraphRepresentation()) {
+}
+
+/*
+Advances the algorithm until the time budget (in milliseconds) is spent
+or the given number of steps is done. Returns false when the algorithm
+is over.
+*/
+bool AlgorithmStepper::run_for(double budget, int max_steps) {
+    TRACE_SCOPE("AlgorithmStepper::run_for");
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(int i=0 ; i<max_steps ; i++) {
+        if(!step()) return false;
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now()-start;
+        if(elapsed.count()>=budget) break;
+    }
+    return true;
+}
@@ -0,0 +1,53 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AlgorithmStepper_hpp
+#define AlgorithmStepper_hpp
+
+class Graph;
+class GraphRepresentation;
+
+/*
+Base class of the step-wise algorithms. Each call to step() runs the
+algorithm until its next event (a vertex settled, an edge relaxed, a path
+augmented...) and returns, so that the render loop can draw the graph in
+between. The batch algorithms of the Graph class are left untouched.
+*/
+class AlgorithmStepper {
+
+    public:
+    
+        AlgorithmStepper(Graph*);
+virtual ~AlgorithmStepper() {}
+    
+virtual bool step() = 0;
+        bool run_for(double, int);
+    
+    protected:
+    
+        Graph*               graph;                  /* graph the algorithm runs on */
+        GraphRepresentation* graph_representation;   /* representation of the graph */
+
+};
+
+#endif
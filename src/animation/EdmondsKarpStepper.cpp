@@ -0,0 +1,120 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+#include "EdmondsKarpStepper.hpp"
+#include "graph/Graph.hpp"
+
+/*
+Creates the residual network, as in Graph::algo_edmonds_karp().
+*/
+EdmondsKarpStepper::EdmondsKarpStepper(Graph* graph, const Vertex* source, const Vertex* sink) :
+    AlgorithmStepper(graph),
+    max_flow(0),
+    residual_graph(new Graph(*graph)),
+    state(BFS_START) {
+    res_source = residual_graph->getGraphRepresentation()->getVertices()->at(source->getId());
+    res_sink   = residual_graph->getGraphRepresentation()->getVertices()->at(sink->getId());
+}
+
+/*
+Deletes the residual network.
+*/
+EdmondsKarpStepper::~EdmondsKarpStepper() {
+    delete residual_graph;
+}
+
+/*
+Gives the vertices their default color, except the source and the sink.
+*/
+void EdmondsKarpStepper::reset_vertices_color() {
+    for(Vertex* v : *graph_representation->getVertices()) {
+        if(v->getId()!=res_source->getId() && v->getId()!=res_sink->getId()) graph_representation->set_color(v, Constants::VERTEX_COLOR_R, Constants::VERTEX_COLOR_G, Constants::VERTEX_COLOR_B);
+    }
+}
+
+/*
+Runs the algorithm until the next event.
+*/
+bool EdmondsKarpStepper::step() {
+    GraphRepresentation* residual = residual_graph->getGraphRepresentation();
+    while(true) {
+        switch(state) {
+            case BFS_START : {
+                bfs           = std::queue<const Vertex*>();
+                parents.clear();
+                path_capacity.clear();
+                bfs.push(res_source);
+                parents[res_source]       = res_source;
+                path_capacity[res_source] = std::numeric_limits<Weight>::max();
+                state                     = BFS;
+                break;
+            }
+            case BFS : {
+                if(bfs.empty()) {
+                    reset_vertices_color();
+                    std::cout << "maximum flow: " << max_flow << std::endl;
+                    state = DONE;
+                    break;
+                }
+                const Vertex* v = bfs.front();
+                bfs.pop();
+                for(const Neighbor& neighbor : residual->neighbors(v)) {
+                    const Vertex* n = neighbor.vertex;
+                    Weight capacity_v_n = residual->get_capacity_from_to(v, n);
+                    if(capacity_v_n>0 && !parents.count(n)) {
+                        parents[n]       = v;
+                        path_capacity[n] = std::min(path_capacity[v], capacity_v_n);
+                        if(n==res_sink) {
+                            state = AUGMENT;
+                            break;
+                        }
+                        bfs.push(n);
+                        graph_representation->set_color(graph_representation->getVertices()->at(n->getId()), Constants::VERTEX_VISITED_COLOR_R, Constants::VERTEX_VISITED_COLOR_G, Constants::VERTEX_VISITED_COLOR_B);
+                    }
+                }
+                return true;
+            }
+            case AUGMENT : {
+                Weight        flow = path_capacity[res_sink];
+                const Vertex* v    = res_sink;
+                max_flow += flow;
+                while(v!=res_source) {
+                    const Vertex* p = parents[v];
+                    graph_representation->set_color(graph_representation->get_edge_from_to(v->getId(), p->getId()), Constants::EDGE_ALGO_RESULT_COLOR_R, Constants::EDGE_ALGO_RESULT_COLOR_G, Constants::EDGE_ALGO_RESULT_COLOR_B);
+                    residual->set_capacity_from_to(p, v, residual->get_capacity_from_to(p, v)-flow);
+                    residual->set_capacity_from_to(v, p, residual->get_capacity_from_to(v, p)+flow);
+                    v = p;
+                }
+                reset_vertices_color();
+                state = BFS_START;
+                return true;
+            }
+            case DONE :
+                return false;
+        }
+    }
+}
@@ -0,0 +1,64 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EdmondsKarpStepper_hpp
+#define EdmondsKarpStepper_hpp
+
+#include <map>
+#include <queue>
+
+#include "AlgorithmStepper.hpp"
+#include "components/Vertex.hpp"
+#include "components/Weight.hpp"
+
+/*
+Step-wise Edmonds-Karp algorithm. The events are the expansion of a vertex
+by the breadth-first search and the augmentation of a path.
+*/
+class EdmondsKarpStepper : public AlgorithmStepper {
+
+    public:
+    
+        EdmondsKarpStepper(Graph*, const Vertex*, const Vertex*);
+        ~EdmondsKarpStepper();
+    
+        bool step();
+    
+    private:
+    
+        enum STATE {BFS_START, BFS, AUGMENT, DONE};
+    
+        void reset_vertices_color();
+    
+        std::queue<const Vertex*>              bfs;              /* vertices to expand */
+        WeightSum                              max_flow;         /* flow found so far */
+        std::map<const Vertex*, const Vertex*> parents;          /* parent of each discovered vertex in the residual graph */
+        std::map<const Vertex*, Weight>        path_capacity;    /* capacity of the path to each discovered vertex */
+        Graph*                                 residual_graph;   /* residual network */
+        const Vertex*                          res_sink;         /* sink in the residual network */
+        const Vertex*                          res_source;       /* source in the residual network */
+        STATE                                  state;            /* what the next step does */
+
+};
+
+#endif
@@ -0,0 +1,71 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <iostream>
+
+#include "graph/Graph.hpp"
+#include "PrimStepper.hpp"
+
+/*
+Starts from the first vertex, as in Graph::algo_prim().
+*/
+PrimStepper::PrimStepper(Graph* graph) :
+    AlgorithmStepper(graph),
+    weight(0) {
+    Vertex* v_begin = graph_representation->getVertices()->at(0);
+    visited.insert(v_begin);
+    add_adjacent_edges(v_begin);
+}
+
+/*
+Adds the edges adjacent to the vertex to the search set.
+*/
+void PrimStepper::add_adjacent_edges(const Vertex* v) {
+    for(const Neighbor& n : graph_representation->neighbors(v)) search.insert(n.edge);
+}
+
+/*
+Selects the edge with minimum capacity and adds it to the tree if it
+links it to a new vertex. Returns false when no edge is left.
+*/
+bool PrimStepper::step() {
+    while(!search.empty()) {
+        std::set<const Edge*>::iterator it_min;
+        it_min = std::min_element(search.begin(), search.end(), [this](const Edge* e1, const Edge* e2){ return graph_representation->get_capacity_v1_to_v2(e1)<graph_representation->get_capacity_v1_to_v2(e2); });
+        const Edge* e_min = *it_min;
+        search.erase(it_min);
+        Vertex* v1 = graph_representation->get_v1(e_min);
+        Vertex* v2 = graph_representation->get_v2(e_min);
+        if(!visited.count(v1) || !visited.count(v2)) {
+            graph_representation->set_color(e_min, Constants::EDGE_ALGO_RESULT_COLOR_R, Constants::EDGE_ALGO_RESULT_COLOR_G, Constants::EDGE_ALGO_RESULT_COLOR_B);
+            weight += graph_representation->get_capacity_v1_to_v2(e_min);
+            Vertex* v = visited.count(v1) ? v2 : v1;
+            visited.insert(v);
+            add_adjacent_edges(v);
+            return true;
+        }
+    }
+    std::cout << "prim graph weight: " << weight << std::endl;
+    return false;
+}
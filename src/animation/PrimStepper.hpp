@@ -0,0 +1,55 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PrimStepper_hpp
+#define PrimStepper_hpp
+
+#include <set>
+
+#include "AlgorithmStepper.hpp"
+#include "components/Edge.hpp"
+#include "components/Vertex.hpp"
+#include "components/Weight.hpp"
+
+/*
+Step-wise Prim algorithm. The event is the selection of an edge.
+*/
+class PrimStepper : public AlgorithmStepper {
+
+    public:
+    
+        PrimStepper(Graph*);
+    
+        bool step();
+    
+    private:
+    
+        void add_adjacent_edges(const Vertex*);
+    
+        std::set<const Edge*>   search;    /* edges that can be selected */
+        WeightSum               weight;    /* weight of the selected edges */
+        std::set<const Vertex*> visited;   /* vertices of the tree */
+
+};
+
+#endif
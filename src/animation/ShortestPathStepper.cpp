@@ -0,0 +1,116 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "graph/Graph.hpp"
+#include "ShortestPathStepper.hpp"
+
+/*
+Initializes the search from the source, as in Graph::algo_dijkstra()
+and Graph::algo_astar().
+*/
+ShortestPathStepper::ShortestPathStepper(Graph* graph, const Vertex* source, const Vertex* destination, bool astar) :
+    AlgorithmStepper(graph),
+    astar(astar),
+    current(0),
+    destination(destination),
+    next_neighbor(0),
+    source(source),
+    state(SELECT) {
+    unsigned int inf_unsigned = -1; inf_unsigned /= 2;
+    int          inf_signed   = inf_unsigned;
+    for(const Vertex* v : *graph_representation->getVertices()) {
+        costs[v]    = inf_signed;
+        previous[v] = 0;
+    }
+    costs[source] = 0;
+    search.insert(source);
+}
+
+/*
+Runs the algorithm until the next event.
+*/
+bool ShortestPathStepper::step() {
+    while(true) {
+        switch(state) {
+            case SELECT : {
+                if(search.empty()) {
+                    state = DONE;
+                    break;
+                }
+                /* finds the best potential vertex and extracts it from the list */
+                std::set<const Vertex*>::iterator it_min = std::min_element(search.begin(), search.end(), [&](const Vertex* v1, const Vertex* v2) {
+                    if(astar) return costs[v1]+v1->distanceTo(destination)<costs[v2]+v2->distanceTo(destination);
+                    else      return costs[v1]<costs[v2];
+                });
+                current = *it_min;
+                search.erase(it_min);
+                visited.insert(current);
+                if(current==destination) {
+                    state = PATH;
+                }
+                else {
+                    neighbors     = graph_representation->neighbors(current);
+                    next_neighbor = neighbors.begin();
+                    state         = RELAX;
+                }
+                return true;
+            }
+            case RELAX : {
+                if(next_neighbor==neighbors.end()) {
+                    state = SELECT;
+                    break;
+                }
+                const Neighbor& n = *next_neighbor++;
+                Vertex*         v = n.vertex;
+                if(graph->getOrientation()==ONE_WAY && graph_representation->get_v1_id(n.edge)!=current->getId()) break;
+                if(!visited.count(v)) {
+                    search.insert(v);
+                    graph_representation->set_color(v, Constants::VERTEX_VISITED_COLOR_R, Constants::VERTEX_VISITED_COLOR_G, Constants::VERTEX_VISITED_COLOR_B);
+                    double diff = costs[current] + current->distanceTo(v);
+                    if(diff<costs[v]) {
+                        costs[v]    = diff;
+                        previous[v] = current;
+                    }
+                    return true;
+                }
+                break;
+            }
+            case PATH : {
+                if(current==source) {
+                    graph_representation->set_color(destination, Constants::EDGE_ALGO_DESTINATION_COLOR_R, Constants::EDGE_ALGO_DESTINATION_COLOR_G, Constants::EDGE_ALGO_DESTINATION_COLOR_B);
+                    graph_representation->set_color(source, Constants::EDGE_ALGO_SOURCE_COLOR_R, Constants::EDGE_ALGO_SOURCE_COLOR_G, Constants::EDGE_ALGO_SOURCE_COLOR_B);
+                    state = DONE;
+                    break;
+                }
+                graph_representation->set_color(graph_representation->get_edge_from_to(current, previous[current]), Constants::EDGE_ALGO_RESULT_COLOR_R, Constants::EDGE_ALGO_RESULT_COLOR_G, Constants::EDGE_ALGO_RESULT_COLOR_B);
+                current = previous[current];
+                graph_representation->set_color(current, Constants::VERTEX_PATH_COLOR_R, Constants::VERTEX_PATH_COLOR_G, Constants::VERTEX_PATH_COLOR_B);
+                return true;
+            }
+            case DONE :
+                return false;
+        }
+    }
+}
@@ -0,0 +1,64 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ShortestPathStepper_hpp
+#define ShortestPathStepper_hpp
+
+#include <map>
+#include <set>
+
+#include "AlgorithmStepper.hpp"
+#include "components/Vertex.hpp"
+#include "graph_representation/NeighborRange.hpp"
+
+/*
+Step-wise Dijkstra or A* algorithm. The events are the settlement of a
+vertex, the relaxation of an edge and the display of an edge of the path.
+*/
+class ShortestPathStepper : public AlgorithmStepper {
+
+    public:
+    
+        ShortestPathStepper(Graph*, const Vertex*, const Vertex*, bool);
+    
+        bool step();
+    
+    private:
+    
+        enum STATE {SELECT, RELAX, PATH, DONE};
+    
+        bool                                   astar;           /* uses the euclidian distance to the destination as heuristic */
+        std::map<const Vertex*, double>        costs;           /* cost of the best known path to each vertex */
+        const Vertex*                          current;         /* vertex being studied, or current vertex of the path */
+        const Vertex*                          destination;     /* destination of the path */
+        NeighborRange                          neighbors;       /* neighbors of the current vertex */
+        const Neighbor*                        next_neighbor;   /* next neighbor to relax */
+        std::map<const Vertex*, const Vertex*> previous;        /* previous vertex in the best known path to each vertex */
+        std::set<const Vertex*>                search;          /* vertices that can be selected */
+        const Vertex*                          source;          /* source of the path */
+        STATE                                  state;           /* what the next step does */
+        std::set<const Vertex*>                visited;         /* settled vertices */
+
+};
+
+#endif
@@ -24,44 +24,34 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef Edge_hpp
 #define Edge_hpp
 
-#include "constants/Constants.hpp"
+#include <cstdint>
+
 #include "Vertex.hpp"
 
+/*
+Edge of the topology of a graph. Edges are immutable and shared between
+the copies of a graph: their color, capacities and direction are stored
+in columns of the GraphRepresentation, so that an edge is only a handle
+made of its identifier and of the identifiers of its end points. v1 and
+v2 are the end points given when the edge was created, see
+GraphRepresentation::get_v1() for the direction and for the vertices.
+*/
 class Edge {
 
     public:
     
-        Edge(const Vertex*, const Vertex*);
-        Edge(const Vertex*, const Vertex*, double, double);
-        Edge(const Vertex*, const Vertex*, double, double, unsigned char, unsigned char, unsigned char);
-        Edge(const Vertex*, const Vertex*, unsigned char, unsigned char, unsigned char);
-        Edge(const Vertex*, const Vertex*, unsigned char, unsigned char, unsigned char, double, double);
+        Edge(const Vertex*, const Vertex*, int);
         ~Edge() {}
     
-        Edge& operator=(const Edge&);
-    
-        unsigned char getColorR()         const { return color_r; }
-        unsigned char getColorG()         const { return color_g; }
-        unsigned char getColorB()         const { return color_b; }
-        double        getCapacityV1ToV2() const { return capacity_v1_v2; }
-        double        getCapacityV2ToV1() const { return capacity_v2_v1; }
-        Vertex*       getV1()             const { return v1; }
-        Vertex*       getV2()             const { return v2; }
-    
-        void setColor(unsigned char r, unsigned char g, unsigned char b) { color_r = r; color_g = g; color_b = b; }
-        void setCapacityV1ToV2(double c)                                 { capacity_v1_v2 = c; }
-        void setCapacityV2ToV1(double c)                                 { capacity_v2_v1 = c; }
-        void switch_vertices();
+        int getId()   const { return id; }
+        int getV1Id() const { return v1; }
+        int getV2Id() const { return v2; }
     
     private:
     
-        unsigned char color_r;          /* red color of the edge */
-        unsigned char color_g;          /* green color of the edge */
-        unsigned char color_b;          /* blue color of the edge */
-        double        capacity_v1_v2;   /* capacity of the arc from v1 to v2 */
-        double        capacity_v2_v1;   /* capacity of the arc from v2 to v1 */
-        Vertex*       v1;               /* vertex v1 */
-        Vertex*       v2;               /* vertex v2 */
+  const std::int32_t id;   /* identifier of the edge, index of its attributes */
+  const std::int32_t v1;   /* identifier of vertex v1 */
+  const std::int32_t v2;   /* identifier of vertex v2 */
 
 };
 
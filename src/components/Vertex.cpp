@@ -29,36 +29,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 /*
 Initializes the variables.
 */
-Vertex::Vertex(double x, double y, int id, unsigned char color_r, unsigned char color_g, unsigned char color_b) :
+Vertex::Vertex(double x, double y, int id) :
     id(id),
     x(x),
-    y(y),
-    color_r(color_r),
-    color_g(color_g),
-    color_b(color_b) {
-}
-
-/*
-Copy constructor.
-*/
-Vertex::Vertex(const Vertex& v) :
-    Vertex(v.getX(), v.getY(), v.getId()) {
-    *this = v;
-}
-
-/*
-Assignment operator.
-*/
-Vertex &Vertex::operator=(const Vertex& v) {
-    if(this==&v) {
-        return *this;
-    }
-    else {
-        color_r = v.getColorR();
-        color_g = v.getColorG();
-        color_b = v.getColorB();
-        return *this;
-    }
+    y(y) {
 }
 
 /*
@@ -24,37 +24,29 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef Vertex_hpp
 #define Vertex_hpp
 
-#include "constants/Constants.hpp"
-
+/*
+Vertex of the topology of a graph. Vertices are immutable and shared
+between the copies of a graph: their color is stored by the
+GraphRepresentation.
+*/
 class Vertex {
     
     public:
     
-        Vertex(double x, double y, int id, unsigned char=Constants::VERTEX_COLOR_R, unsigned char=Constants::VERTEX_COLOR_G, unsigned char=Constants::VERTEX_COLOR_B);
-        Vertex(const Vertex&);
+        Vertex(double x, double y, int id);
         ~Vertex() {}
     
-        Vertex &operator=(const Vertex&);
-    
-        unsigned char getColorR()                const { return color_r; }
-        unsigned char getColorG()                const { return color_g; }
-        unsigned char getColorB()                const { return color_b; }
-        double        distanceTo(const Vertex*)  const;
-        double        distanceTo(double, double) const;
-        int           getId()                    const { return id; }
-        double        getX()                     const { return x; }
-        double        getY()                     const { return y; }
-    
-        void setColor(unsigned char r, unsigned char g, unsigned char b) { color_r = r; color_g = g; color_b = b; }
+        double distanceTo(const Vertex*)  const;
+        double distanceTo(double, double) const;
+        int    getId()                    const { return id; }
+        double getX()                     const { return x; }
+        double getY()                     const { return y; }
 
     private:
     
-  const int           id;        /* identifier of the vertex */
-  const double        x;         /* x coordinate of the vertex */
-  const double        y;         /* y coordinate of the vertex */
-        unsigned char color_r;   /* red color of the vertex */
-        unsigned char color_g;   /* green color of the vertex */
-        unsigned char color_b;   /* blue color of the vertex */
+  const int    id;   /* identifier of the vertex */
+  const double x;    /* x coordinate of the vertex */
+  const double y;    /* y coordinate of the vertex */
 
 };
 
@@ -0,0 +1,61 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef Weight_hpp
+#define Weight_hpp
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+/*
+Capacities of the arcs, which are also the weights of the minimum
+spanning tree. The type is chosen when compiling, with
+'make linux WEIGHT=int32|int64|float|double', double by default. The
+32-bit types halve the memory used by the capacities.
+*/
+#if   defined(GRAPHS_WEIGHT_INT32)
+typedef std::int32_t Weight;
+#elif defined(GRAPHS_WEIGHT_INT64)
+typedef std::int64_t Weight;
+#elif defined(GRAPHS_WEIGHT_FLOAT)
+typedef float        Weight;
+#else
+typedef double       Weight;
+#endif
+
+/*
+Arithmetic on the weight type W. Sums of weights (flows, total weights)
+are 64-bit integers for the integer types, so that they are exact, and
+doubles otherwise. round() converts a value to W, rounding it to the
+nearest integer for the integer types instead of truncating it.
+*/
+template<typename W>
+struct WeightTraits {
+    typedef typename std::conditional<std::is_integral<W>::value, std::int64_t, double>::type Sum;
+    static W round(double x) { return std::is_integral<W>::value ? static_cast<W>(std::llround(x)) : static_cast<W>(x); }
+};
+
+typedef WeightTraits<Weight>::Sum WeightSum;
+
+#endif
@@ -0,0 +1,85 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "graph/Graph.hpp"
+#include "JobRunner.hpp"
+
+/*
+Initializes the variables.
+*/
+JobRunner::JobRunner() :
+    cancelled(false),
+    finished(false),
+    running(false),
+    snapshot(0) {
+}
+
+/*
+Cancels the running job, waits for the worker and deletes the snapshot.
+*/
+JobRunner::~JobRunner() {
+    cancel();
+    if(worker.joinable()) worker.join();
+    delete snapshot;
+}
+
+/*
+Asks the running job to stop. The job stops at its next check of the
+cancel flag, and its result is discarded when collected.
+*/
+void JobRunner::cancel() {
+    if(running) cancelled = true;
+}
+
+/*
+Returns the snapshot once the job is over, or 0 if no job is over. The
+ownership of the snapshot goes to the caller. The boolean tells if the
+job was cancelled, in which case its result should be ignored.
+*/
+Graph* JobRunner::collect(bool* was_cancelled) {
+    if(!running || !finished) return 0;
+    worker.join();
+    Graph* result  = snapshot;
+    *was_cancelled = cancelled;
+    snapshot       = 0;
+    running        = false;
+    return result;
+}
+
+/*
+Runs the job on a worker thread, on the given snapshot of the graph. The
+runner takes ownership of the snapshot. Returns false, and leaves the
+snapshot to the caller, if a job is already running.
+*/
+bool JobRunner::start(Graph* graph_snapshot, const std::function<void(Graph*)>& job) {
+    if(running) return false;
+    cancelled = false;
+    finished  = false;
+    running   = true;
+    snapshot  = graph_snapshot;
+    worker    = std::thread([this, job]() {
+        job(snapshot);
+        finished = true;
+    });
+    return true;
+}
@@ -0,0 +1,57 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JobRunner_hpp
+#define JobRunner_hpp
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+class Graph;
+
+class JobRunner {
+
+    public:
+    
+        JobRunner();
+        ~JobRunner();
+    
+        const std::atomic<bool>* getCancelFlag() const { return &cancelled; }
+        bool                     busy()          const { return running; }
+    
+        void   cancel();
+        Graph* collect(bool*);
+        bool   start(Graph*, const std::function<void(Graph*)>&);
+    
+    private:
+    
+        std::atomic<bool> cancelled;   /* set to ask the running job to stop as soon as possible */
+        std::atomic<bool> finished;    /* set by the worker when the job is over */
+        bool              running;     /* true from the start of a job until it is collected */
+        Graph*            snapshot;    /* copy of the graph the job works on */
+        std::thread       worker;      /* thread executing the job */
+
+};
+
+#endif
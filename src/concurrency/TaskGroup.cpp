@@ -0,0 +1,94 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <thread>
+
+#include "TaskGroup.hpp"
+
+/*
+Creates a group running on the threads of the given pool.
+*/
+TaskGroup::TaskGroup(ThreadPool* pool) :
+    deques(pool->getNbThreads()),
+    nb_idle(0),
+    nb_pending(0),
+    nb_threads(pool->getNbThreads()),
+    pool(pool) {
+}
+
+/*
+Runs the task on the first thread, and the tasks it spawns on all the
+threads, until they are all over.
+*/
+void TaskGroup::run(const Task& task) {
+    spawn(0, task);
+    pool->parallel_for(nb_threads, [this](int i) { work(i); });
+}
+
+/*
+Adds a task to the deque of the given thread.
+*/
+void TaskGroup::spawn(int thread, const Task& task) {
+    nb_pending++;
+    std::lock_guard<std::mutex> lock(deques[thread].mutex);
+    deques[thread].tasks.push_back(task);
+}
+
+/*
+Takes the last task of the thread, or steals the first task of the next
+thread that has one. Returns false if there is none.
+*/
+bool TaskGroup::take(int thread, Task* task) {
+    for(int i=0 ; i<nb_threads ; i++) {
+        Deque&                      deque = deques[(thread+i)%nb_threads];
+        std::lock_guard<std::mutex> lock(deque.mutex);
+        if(deque.tasks.empty()) continue;
+        if(i==0) { *task = deque.tasks.back();  deque.tasks.pop_back(); }
+        else     { *task = deque.tasks.front(); deque.tasks.pop_front(); }
+        return true;
+    }
+    return false;
+}
+
+/*
+Loop of a thread: runs its tasks and steals the others' until no task
+is left.
+*/
+void TaskGroup::work(int thread) {
+    bool idle = false;
+    Task task;
+    while(nb_pending>0) {
+        if(take(thread, &task)) {
+            if(idle) nb_idle--;
+            idle = false;
+            task(thread);
+            nb_pending--;
+        }
+        else {
+            if(!idle) nb_idle++;
+            idle = true;
+            std::this_thread::yield();
+        }
+    }
+    if(idle) nb_idle--;
+}
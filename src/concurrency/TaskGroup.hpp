@@ -0,0 +1,79 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TaskGroup_hpp
+#define TaskGroup_hpp
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+/*
+Tasks run on the threads of a ThreadPool with work stealing. Each
+thread has its own deque of tasks: it runs the last task it added, and
+when its deque is empty, it steals the oldest task of another thread.
+A task can spawn other tasks, and hungry() tells it that a thread is
+waiting for work, so that it can give some away. run() returns when all
+the tasks are over. Tasks do not wait for each other.
+*/
+class TaskGroup {
+
+    public:
+    
+        typedef std::function<void(int)> Task;   /* called with the index of the thread running it */
+    
+        TaskGroup(ThreadPool*);
+    
+        int  getNbThreads() const { return nb_threads; }
+        bool hungry()       const { return nb_idle>0; }
+    
+        void run(const Task&);
+        void spawn(int, const Task&);
+    
+    private:
+    
+        /*
+        Tasks of a thread, taken from the back by the thread itself and
+        from the front by the others.
+        */
+        struct Deque {
+            std::mutex       mutex;   /* protects the tasks */
+            std::deque<Task> tasks;   /* tasks waiting to run */
+        };
+    
+        bool take(int, Task*);
+        void work(int);
+    
+        std::vector<Deque> deques;       /* tasks of each thread */
+        std::atomic<int>   nb_idle;      /* threads looking for a task */
+        std::atomic<long>  nb_pending;   /* tasks spawned and not over yet */
+        int                nb_threads;   /* number of threads of the pool */
+        ThreadPool*        pool;         /* runs the threads */
+
+};
+
+#endif
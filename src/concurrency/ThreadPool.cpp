@@ -0,0 +1,122 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "ThreadPool.hpp"
+
+/*
+Static variables.
+*/
+int               ThreadPool::default_nb_threads(0);
+thread_local bool ThreadPool::in_task(false);
+
+/*
+Starts nb_threads-1 workers, the calling thread being the last one. If
+nb_threads is 0 or less, one thread per core is used.
+*/
+ThreadPool::ThreadPool(int nb_threads) :
+    generation(0),
+    nb_running(0),
+    nb_tasks(0),
+    next_task(0),
+    stopping(false),
+    task(0) {
+    if(nb_threads<=0) nb_threads = std::max(1u, std::thread::hardware_concurrency());
+    for(int i=1 ; i<nb_threads ; i++) workers.push_back(std::thread(&ThreadPool::work, this));
+}
+
+/*
+Stops and joins the workers.
+*/
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for(std::thread& t : workers) t.join();
+}
+
+/*
+Pool shared by the whole process, created on first use with the number
+of threads given to setNbThreads().
+*/
+ThreadPool* ThreadPool::get() {
+    static ThreadPool pool(default_nb_threads);
+    return &pool;
+}
+
+/*
+Runs f(0) to f(n-1) on the threads of the pool and returns when all of
+them are over. The tasks are handed out one at a time, in order.
+*/
+void ThreadPool::parallel_for(int n, const std::function<void(int)>& f) {
+    if(n<=0) return;
+    if(in_task || workers.empty() || n==1) {
+        for(int i=0 ; i<n ; i++) f(i);
+        return;
+    }
+    std::lock_guard<std::mutex> call_lock(call_mutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task       = &f;
+        nb_tasks   = n;
+        next_task  = 0;
+        nb_running = static_cast<int>(workers.size());
+        generation++;
+    }
+    wake.notify_all();
+    run_tasks();
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]() { return nb_running==0; });
+    task = 0;
+}
+
+/*
+Runs tasks of the current call until there is none left.
+*/
+void ThreadPool::run_tasks() {
+    in_task = true;
+    for(int i=next_task++ ; i<nb_tasks ; i=next_task++) (*task)(i);
+    in_task = false;
+}
+
+/*
+Loop of the workers: waits for a call, runs its tasks, and tells the
+caller when it is done.
+*/
+void ThreadPool::work() {
+    unsigned long seen = 0;
+    while(true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, seen]() { return stopping || generation!=seen; });
+            if(stopping) return;
+            seen = generation;
+        }
+        run_tasks();
+        std::lock_guard<std::mutex> lock(mutex);
+        if(--nb_running==0) done.notify_one();
+    }
+}
@@ -0,0 +1,77 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+Fixed set of worker threads running indexed tasks. parallel_for() runs
+tasks 0 to n-1 on the workers and the calling thread, and returns when
+they are all over. Work that must give the same result whatever the
+number of threads is split in a number of tasks that does not depend on
+it. Calls from different threads are run one after the other, and a
+call from inside a task runs its tasks serially on the calling worker.
+*/
+class ThreadPool {
+
+    public:
+    
+        ThreadPool(int);
+        ~ThreadPool();
+    
+ static ThreadPool* get();
+ static void        setNbThreads(int n) { default_nb_threads = n; }
+    
+        int  getNbThreads() const { return static_cast<int>(workers.size())+1; }
+        void parallel_for(int, const std::function<void(int)>&);
+    
+    private:
+    
+ static int               default_nb_threads;   /* number of threads of the shared pool, 0 for the number of cores */
+ static thread_local bool in_task;              /* true on a thread running tasks of a pool */
+    
+        void run_tasks();
+        void work();
+    
+        std::mutex                      call_mutex;   /* serializes the calls of parallel_for() */
+        std::condition_variable         done;         /* signaled when the last worker is done with the current call */
+        unsigned long                   generation;   /* incremented at each call, wakes the workers up */
+        std::mutex                      mutex;        /* protects the state of the current call */
+        int                             nb_running;   /* workers not done yet with the current call */
+        int                             nb_tasks;     /* number of tasks of the current call */
+        std::atomic<int>                next_task;    /* index of the next task to run */
+        bool                            stopping;     /* set by the destructor to stop the workers */
+  const std::function<void(int)>*       task;         /* task of the current call */
+        std::condition_variable         wake;         /* signaled when a call starts or the pool stops */
+        std::vector<std::thread>        workers;      /* threads of the pool, the calling thread is the last one */
+
+};
+
+#endif
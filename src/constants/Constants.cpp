@@ -25,9 +25,16 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 namespace Constants {
 
+    const double        ANIMATION_FRAME_BUDGET(2);
+    const int           ANIMATION_FRAME_DELAY(16);
+    const int           ANIMATION_STEPS_PER_FRAME(2);
     const int           AREA_HEIGHT(1900);
+    const int           AREA_POISSON_ATTEMPTS(16);
+    const double        AREA_POISSON_DENSITY(0.82);
     const int           AREA_WIDTH(1900);
-    const int           AREA_SPACING(4);
+    const int           BENCH_RUNS(3);
+    const int           BFS_ALPHA(14);
+    const int           BFS_BETA(24);
     const unsigned char EDGE_ALGO_RESULT_COLOR_R(255);
     const unsigned char EDGE_ALGO_RESULT_COLOR_G(0);
     const unsigned char EDGE_ALGO_RESULT_COLOR_B(0);
@@ -42,9 +49,41 @@ namespace Constants {
     const unsigned char EDGE_COLOR_B(140);
     const int           EDGE_MAXIMUM_CAPACITY(10);
     const int           EDGE_DEFAULT_CAPACITY(0);
+    const int           GENERATOR_CHUNKS(64);
+    const double        GENERATOR_DEGREE(6);
+    const double        GENERATOR_RMAT_A(0.57);
+    const double        GENERATOR_RMAT_B(0.19);
+    const double        GENERATOR_RMAT_C(0.19);
     const int           GRAPH_MINIMUM_VERTICES(10);
     const int           GRAPH_NB_VERTICES_TRAVELING_SALESMAN(6);
+    const int           GRAPH_NB_VERTICES_TRAVELING_HEURISTIC(200);
     const int           GRAPH_VERTICES_INCREMENTATION(70);
+    const double        MEMORY_BUDGET_GB(4);
+    const int           PARALLEL_GRAIN(1024);
+    const int           PARALLEL_TASKS_PER_THREAD(4);
+    const int           RENDER_DETAIL_MAX_EDGES(20000);
+    const int           RENDER_FRAME_DELAY(100);
+    const int           RENDER_LABEL_MIN_PIXELS(40);
+    const int           RENDER_LOD_MAX_VERTICES(50000);
+    const int           RENDER_LOD_TILE_PIXELS(6);
+    const double        RENDER_PAN_STEP(0.1);
+    const int           RENDER_PICKING_RADIUS_PIXELS(12);
+    const int           RENDER_QUADTREE_LEAF_SIZE(16);
+    const int           RENDER_QUADTREE_MAX_DEPTH(24);
+    const double        RENDER_ZOOM_MAX(1000);
+    const double        RENDER_ZOOM_MIN(0.5);
+    const double        RENDER_ZOOM_STEP(1.25);
+    const int           SERVER_BACKLOG(64);
+    const int           SERVER_LOAD_TABLE_SIZE(4);
+    const int           SERVER_MAX_QUEUED(64);
+    const int           SERVER_MAX_REQUEST(1<<20);
+    const int           SERVER_POLL_DELAY(100);
+    const int           SERVER_READ_SIZE(1<<16);
+    const char* const   SERVER_SOCKET_PATH("/tmp/graphsd.sock");
+    const double        SSSP_DELTA_FACTOR(2);
+    const double        TSP_MIN_GAIN(1e-7);
+    const int           TSP_NEIGHBORS(8);
+    const int           TSP_OR_OPT_LENGTH(3);
     const unsigned char VERTEX_COLOR_R(130);
     const unsigned char VERTEX_COLOR_G(255);
     const unsigned char VERTEX_COLOR_B(180);
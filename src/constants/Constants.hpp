@@ -26,9 +26,16 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 namespace Constants {
 
+    extern const double        ANIMATION_FRAME_BUDGET;                 /* time spent running an animated algorithm per frame, in milliseconds */
+    extern const int           ANIMATION_FRAME_DELAY;                  /* delay between two frames during an animation, in milliseconds */
+    extern const int           ANIMATION_STEPS_PER_FRAME;              /* maximum number of algorithm events per frame during an animation */
     extern const int           AREA_HEIGHT;                            /*  */
+    extern const int           AREA_POISSON_ATTEMPTS;                  /* candidates tried around a point before it leaves the Poisson-disk active list */
+    extern const double        AREA_POISSON_DENSITY;                   /* points per unit of area of a full Poisson-disk sampling of radius 1 */
     extern const int           AREA_WIDTH;                             /*  */
-    extern const int           AREA_SPACING;                           /*  */
+    extern const int           BENCH_RUNS;                             /* number of runs of each algorithm in the benchmark */
+    extern const int           BFS_ALPHA;                              /* the BFS goes bottom-up when the frontier has more than 1/BFS_ALPHA of the unvisited edges */
+    extern const int           BFS_BETA;                               /* the BFS goes back top-down when the frontier has less than 1/BFS_BETA of the vertices */
     extern const unsigned char EDGE_ALGO_RESULT_COLOR_R;               /* red color of the edges that are the result of an algorithm */
     extern const unsigned char EDGE_ALGO_RESULT_COLOR_G;               /* green color of the edges that are the result of an algorithm */
     extern const unsigned char EDGE_ALGO_RESULT_COLOR_B;               /* blue color of the edges that are the result of an algorithm */
@@ -43,9 +50,41 @@ namespace Constants {
     extern const unsigned char EDGE_COLOR_B;                           /* default blue color of the edges */
     extern const int           EDGE_DEFAULT_CAPACITY;                  /* default capacity of an edge */
     extern const int           EDGE_MAXIMUM_CAPACITY;                  /* maximum capacity of an edge */
+    extern const int           GENERATOR_CHUNKS;                       /* the generators split their work in this many tasks, whatever the number of threads */
+    extern const double        GENERATOR_DEGREE;                       /* average degree of the geometric, Erdos-Renyi and R-MAT graphs */
+    extern const double        GENERATOR_RMAT_A;                       /* R-MAT probability of the top left quadrant */
+    extern const double        GENERATOR_RMAT_B;                       /* R-MAT probability of the top right quadrant */
+    extern const double        GENERATOR_RMAT_C;                       /* R-MAT probability of the bottom left quadrant, the bottom right one gets the rest */
     extern const int           GRAPH_MINIMUM_VERTICES;                 /* minimum number of vertices for a graph */
     extern const int           GRAPH_NB_VERTICES_TRAVELING_SALESMAN;   /* defines the number of customers for the traveling salesman problem */
+    extern const int           GRAPH_NB_VERTICES_TRAVELING_HEURISTIC;  /* number of customers for the traveling salesman heuristic */
     extern const int           GRAPH_VERTICES_INCREMENTATION;          /* vertices added/deleted when changing the number of vertices of the graph */
+    extern const double        MEMORY_BUDGET_GB;                       /* memory available to a graph and its algorithms, used to recommend a representation */
+    extern const int           PARALLEL_GRAIN;                         /* minimum number of vertices of a task of the parallel algorithms */
+    extern const int           PARALLEL_TASKS_PER_THREAD;              /* maximum number of tasks of a step of the parallel algorithms, per thread */
+    extern const int           RENDER_DETAIL_MAX_EDGES;                /* above this number of visible edges, edges are drawn without arrows nor labels */
+    extern const int           RENDER_FRAME_DELAY;                     /* delay between two frames, in milliseconds */
+    extern const int           RENDER_LABEL_MIN_PIXELS;                /* capacity labels are only drawn on edges longer than this, in pixels */
+    extern const int           RENDER_LOD_MAX_VERTICES;                /* above this number of visible vertices, the graph is drawn as density tiles */
+    extern const int           RENDER_LOD_TILE_PIXELS;                 /* size of the density tiles, in pixels */
+    extern const double        RENDER_PAN_STEP;                        /* fraction of the view moved by a pan */
+    extern const int           RENDER_PICKING_RADIUS_PIXELS;           /* a click picks the closest vertex if it is nearer than this, in pixels */
+    extern const int           RENDER_QUADTREE_LEAF_SIZE;              /* maximum number of vertices in a leaf of the rendering quadtree */
+    extern const int           RENDER_QUADTREE_MAX_DEPTH;              /* maximum depth of the rendering quadtree */
+    extern const double        RENDER_ZOOM_MAX;                        /* maximum zoom factor */
+    extern const double        RENDER_ZOOM_MIN;                        /* minimum zoom factor */
+    extern const double        RENDER_ZOOM_STEP;                       /* zoom factor applied by a zoom in or zoom out */
+    extern const int           SERVER_BACKLOG;                         /* connections the daemon lets wait before accepting them */
+    extern const int           SERVER_LOAD_TABLE_SIZE;                 /* sources and destinations of the distance tables sent by the load generator */
+    extern const int           SERVER_MAX_QUEUED;                      /* requests of a connection the daemon reads ahead of their responses */
+    extern const int           SERVER_MAX_REQUEST;                     /* maximum size of a request to the daemon, in bytes */
+    extern const int           SERVER_POLL_DELAY;                      /* the daemon checks if it must stop at least this often, in milliseconds */
+    extern const int           SERVER_READ_SIZE;                       /* size of the reads on the socket of the daemon, in bytes */
+    extern const char* const   SERVER_SOCKET_PATH;                     /* default path of the socket of the daemon */
+    extern const double        SSSP_DELTA_FACTOR;                      /* width of the delta-stepping buckets, in mean lengths of the arcs */
+    extern const double        TSP_MIN_GAIN;                           /* smallest decrease of the trip cost for a move of the heuristic to be applied */
+    extern const int           TSP_NEIGHBORS;                          /* number of closest stops the heuristic tries to link each stop to */
+    extern const int           TSP_OR_OPT_LENGTH;                      /* maximum number of stops moved at once by the heuristic */
     extern const unsigned char VERTEX_COLOR_R;                         /* default red color of vertices */
     extern const unsigned char VERTEX_COLOR_G;                         /* default green color of vertices */
     extern const unsigned char VERTEX_COLOR_B;                         /* default blue color of vertices */
@@ -58,8 +97,11 @@ namespace Constants {
 
 }
 
-enum GRAPH_TYPE        {ADJACENCY_MATRIX};          /* INCOMPLETE graph type enum - defines how the vertices and edges are stored */
-enum GRAPH_ALGO        {FORD_FULKERSON};            /* INCOMPLETE algo enum - used for set_ready_for_algo() function */
-enum GRAPH_ORIENTATION {ONE_WAY, TWO_WAYS, NONE};   /* if the graph is oriented, doubly oriented, or not oriented */
+enum GRAPH_TYPE        {ADJACENCY_MATRIX, ADJACENCY_BIT_MATRIX};   /* INCOMPLETE graph type enum - defines how the vertices and edges are stored */
+enum GRAPH_ALGO        {FORD_FULKERSON};                           /* INCOMPLETE algo enum - used for set_ready_for_algo() function */
+enum GRAPH_ORIENTATION {ONE_WAY, TWO_WAYS, NONE};                  /* if the graph is oriented, doubly oriented, or not oriented */
+enum GRAPH_GENERATOR   {GABRIEL, GRID, GEOMETRIC, ERDOS_RENYI, RMAT}; /* topology built by Graph::generate() */
+enum TSP_SOLVER        {TSP_EXACT, TSP_NEAREST_NEIGHBOR, TSP_SPACE_FILLING_CURVE}; /* exact search, or heuristic and how it builds its first trip */
+enum VERTEX_ORDERING   {ORDER_HILBERT, ORDER_BFS, ORDER_RCM};     /* order in which Graph::reorder() numbers the vertices */
 
 #endif
@@ -0,0 +1,148 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "CliqueSearch.hpp"
+#include "graph_representation/GraphRepresentationBitMatrix.hpp"
+
+/*
+Prepares the search on the given rows of neighbors.
+*/
+CliqueSearch::CliqueSearch(const std::vector<const std::uint64_t*>& rows, std::size_t words, const std::atomic<bool>* cancel_flag) :
+    best_size(0),
+    cancel_flag(cancel_flag),
+    rows(rows),
+    words(words) {
+}
+
+/*
+Number of nodes of the search tree visited by the last run.
+*/
+unsigned long CliqueSearch::getNbNodes() const {
+    unsigned long nodes = 0;
+    for(const Worker& w : workers) nodes += w.nodes;
+    return nodes;
+}
+
+/*
+Searches a maximum clique on the threads of the shared pool, and writes
+its vertices in increasing order. Returns false if the search was
+cancelled.
+*/
+bool CliqueSearch::run(std::vector<int>* clique) {
+    TaskGroup                  group(ThreadPool::get());
+    std::vector<std::uint64_t> root(2*words, 0);
+    for(std::size_t v=0 ; v<rows.size() ; v++) root[v/64] |= std::uint64_t(1)<<(v%64);
+    best.clear();
+    best_size = 0;
+    workers.assign(group.getNbThreads(), Worker());
+    for(Worker& w : workers) w.nodes = 0;
+    group.run([this, &group, &root](int thread) { task(&group, thread, std::vector<int>(), root); });
+    *clique = best;
+    return !cancelled();
+}
+
+/*
+True if a branch holding the clique R_ and at most bound vertices cannot
+give a better clique than the best one: it would be smaller, or as big
+but after the best one in the order of the sequential search, which is
+the case if the best clique starts with vertices smaller than R_.
+*/
+bool CliqueSearch::beaten(const std::vector<int>& R_, std::size_t bound) {
+    std::size_t size = best_size.load(std::memory_order_relaxed);
+    if(bound!=size) return bound<size;
+    std::lock_guard<std::mutex> lock(best_mutex);
+    return best.size()==bound && std::lexicographical_compare(best.begin(), best.begin()+R_.size(), R_.begin(), R_.end());
+}
+
+/*
+Keeps the maximal clique R_ if it is better than the best one.
+*/
+void CliqueSearch::found(const std::vector<int>& R_) {
+    std::lock_guard<std::mutex> lock(best_mutex);
+    if(R_.size()>best.size() || (R_.size()==best.size() && R_<best)) {
+        best      = R_;
+        best_size = R_.size();
+    }
+}
+
+/*
+Bron-Kerbosch recursion. P and X are the buffer of the given level of
+the thread, the intersections with the neighbors of the vertex added to
+the clique go to the next level. The vertices of P are picked by
+increasing number. If another thread is idle, the branches left are
+spawned as a task holding the current P and X, and this node only
+explores the current one.
+*/
+void CliqueSearch::search(TaskGroup* group, int thread, std::vector<int>* R_, std::size_t level) {
+    if(cancelled()) return;
+    Worker& w = workers[thread];
+    w.nodes++;
+    if(w.levels.size()==level+1) w.levels.push_back(std::vector<std::uint64_t>(2*words));
+    std::uint64_t* P          = w.levels[level].data();
+    std::uint64_t* X          = P+words;
+    std::size_t    candidates = GraphRepresentationBitMatrix::row_count(P, words);
+    if(!candidates) {
+        if(GraphRepresentationBitMatrix::row_empty(X, words)) found(*R_);
+        return;
+    }
+    int v;
+    while((v=GraphRepresentationBitMatrix::row_first(P, words))!=-1) {
+        if(beaten(*R_, R_->size()+candidates)) return;
+        std::uint64_t bit  = std::uint64_t(1)<<(v%64);
+        bool          last = false;
+        if(candidates>1 && group->hungry()) {
+            std::vector<std::uint64_t> rest(P, P+2*words);
+            std::vector<int>           prefix(*R_);
+            rest[v/64]       &= ~bit;
+            rest[words+v/64] |=  bit;
+            group->spawn(thread, [this, group, prefix, rest](int t) { task(group, t, prefix, rest); });
+            last = true;
+        }
+        std::uint64_t* next = w.levels[level+1].data();
+        R_->push_back(v);
+        GraphRepresentationBitMatrix::row_and(P, rows[v], next, words);
+        GraphRepresentationBitMatrix::row_and(X, rows[v], next+words, words);
+        search(group, thread, R_, level+1);
+        R_->pop_back();
+        if(last || cancelled()) return;
+        P         = w.levels[level].data();
+        X         = P+words;
+        P[v/64]  &= ~bit;
+        X[v/64]  |=  bit;
+        candidates--;
+    }
+}
+
+/*
+Task exploring the node of clique R_, with P and X given one after the
+other in PX.
+*/
+void CliqueSearch::task(TaskGroup* group, int thread, const std::vector<int>& R_, const std::vector<std::uint64_t>& PX) {
+    Worker& w = workers[thread];
+    if(w.levels.empty()) w.levels.push_back(std::vector<std::uint64_t>(2*words));
+    std::copy(PX.begin(), PX.end(), w.levels[0].begin());
+    std::vector<int> clique(R_);
+    search(group, thread, &clique, 0);
+}
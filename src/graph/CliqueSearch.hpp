@@ -0,0 +1,80 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CliqueSearch_hpp
+#define CliqueSearch_hpp
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "concurrency/TaskGroup.hpp"
+
+/*
+Parallel Bron-Kerbosch search of a maximum clique, on vertices numbered
+from 0 and given by their rows of neighbors, as bits. The search tree
+runs on a TaskGroup: a thread that finds another one idle gives it the
+branches of the current node it has not explored yet. The size of the
+best clique found so far is shared, and the branches that cannot beat
+it are pruned. Among the maximum cliques, the one returned is the first
+the sequential search finds: the smallest when their vertices are
+compared in order, whatever the number of threads.
+*/
+class CliqueSearch {
+
+    public:
+    
+        CliqueSearch(const std::vector<const std::uint64_t*>&, std::size_t, const std::atomic<bool>*);
+    
+        unsigned long getNbNodes() const;
+    
+        bool run(std::vector<int>*);
+    
+    private:
+    
+        /*
+        State of a thread of the search.
+        */
+        struct Worker {
+            std::vector<std::vector<std::uint64_t>> levels;   /* P then X, for each level of the recursion */
+            unsigned long                           nodes;    /* nodes of the search tree visited */
+        };
+    
+        bool beaten(const std::vector<int>&, std::size_t);
+        bool cancelled() const { return cancel_flag && *cancel_flag; }
+        void found(const std::vector<int>&);
+        void search(TaskGroup*, int, std::vector<int>*, std::size_t);
+        void task(TaskGroup*, int, const std::vector<int>&, const std::vector<std::uint64_t>&);
+    
+        std::vector<int>                        best;          /* best clique found so far */
+        std::mutex                              best_mutex;    /* protects best */
+        std::atomic<std::size_t>                best_size;     /* size of best, read without the lock */
+  const std::atomic<bool>*                      cancel_flag;   /* set to stop the search, may be null */
+  const std::vector<const std::uint64_t*>&      rows;          /* neighbors of each vertex */
+        std::vector<Worker>                     workers;       /* state of each thread */
+        std::size_t                             words;         /* number of 64 bits words of a row */
+
+};
+
+#endif
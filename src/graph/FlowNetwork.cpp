@@ -0,0 +1,90 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "FlowNetwork.hpp"
+
+/*
+Builds the network of the given number of vertices from its arcs, given
+as (tail, head) with their capacities, in O(n+m).
+*/
+FlowNetwork::FlowNetwork(int nb_vertices, const std::vector<std::pair<int, int>>& arcs, const std::vector<Weight>& arc_capacities) :
+    capacities(2*arcs.size(), 0),
+    heads(2*arcs.size()),
+    offsets(nb_vertices+1, 0),
+    reverses(2*arcs.size()) {
+    for(const std::pair<int, int>& a : arcs) {
+        offsets[a.first+1]++;
+        offsets[a.second+1]++;
+    }
+    for(int v=0 ; v<nb_vertices ; v++) offsets[v+1] += offsets[v];
+    std::vector<int> position(offsets.begin(), offsets.end()-1);
+    for(std::size_t i=0 ; i<arcs.size() ; i++) {
+        int forward         = position[arcs[i].first]++;
+        int backward        = position[arcs[i].second]++;
+        capacities[forward] = arc_capacities[i];
+        heads[forward]      = arcs[i].second;
+        heads[backward]     = arcs[i].first;
+        reverses[forward]   = backward;
+        reverses[backward]  = forward;
+    }
+}
+
+/*
+Edmonds-Karp on a copy of the capacities: while a breadth-first search
+finds a path with some capacity left from source to sink, in the
+residual network, the smallest capacity left on the path is sent along
+it. Returns the maximum flow, or the flow sent so far if cancel_flag
+becomes true.
+*/
+WeightSum FlowNetwork::max_flow(int source, int sink, const std::atomic<bool>* cancel_flag) const {
+    std::vector<Weight> residual(capacities);
+    std::vector<int>    parent_arc(offsets.size()-1);
+    std::vector<int>    queue;
+    WeightSum           flow = 0;
+    queue.reserve(offsets.size()-1);
+    while(source!=sink && !(cancel_flag && *cancel_flag)) {
+        std::fill(parent_arc.begin(), parent_arc.end(), -1);
+        queue.assign(1, source);
+        for(std::size_t i=0 ; i<queue.size() && parent_arc[sink]<0 ; i++) {
+            int u = queue[i];
+            for(int a=offsets[u] ; a<offsets[u+1] ; a++) {
+                int v = heads[a];
+                if(residual[a]>0 && v!=source && parent_arc[v]<0) {
+                    parent_arc[v] = a;
+                    queue.push_back(v);
+                }
+            }
+        }
+        if(parent_arc[sink]<0) break;
+        Weight bottleneck = residual[parent_arc[sink]];
+        for(int v=sink ; v!=source ; v=heads[reverses[parent_arc[v]]]) bottleneck = std::min(bottleneck, residual[parent_arc[v]]);
+        for(int v=sink ; v!=source ; v=heads[reverses[parent_arc[v]]]) {
+            residual[parent_arc[v]]           -= bottleneck;
+            residual[reverses[parent_arc[v]]] += bottleneck;
+        }
+        flow += bottleneck;
+    }
+    return flow;
+}
@@ -0,0 +1,61 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FlowNetwork_hpp
+#define FlowNetwork_hpp
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "components/Weight.hpp"
+
+/*
+Flow network held as a compact array of arcs sorted by tail, for the
+maximum flows of a graph whose representation is not built, see
+server/ShardCluster.hpp. Each arc is paired with its reverse arc, of
+capacity zero, so that the residual network can send flow back. The
+network is never written: each maximum flow runs on its own copy of the
+capacities, so that several can run at once.
+*/
+class FlowNetwork {
+
+    public:
+    
+        FlowNetwork(int, const std::vector<std::pair<int, int>>&, const std::vector<Weight>&);
+        ~FlowNetwork() {}
+    
+        int getNbVertices() const { return static_cast<int>(offsets.size())-1; }
+    
+        WeightSum max_flow(int, int, const std::atomic<bool>* =0) const;
+    
+    private:
+    
+        std::vector<Weight> capacities;   /* capacity of each arc, zero for the reverse ones */
+        std::vector<int>    heads;        /* head of each arc */
+        std::vector<int>    offsets;      /* first arc of each vertex, the last one being the number of arcs */
+        std::vector<int>    reverses;     /* arc paired with each arc */
+
+};
+
+#endif
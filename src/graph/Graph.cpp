@@ -30,33 +30,57 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <stack>
 #include <vector>
 
+#include "algorithms.hpp"
+#include "animation/EdmondsKarpStepper.hpp"
+#include "animation/PrimStepper.hpp"
+#include "animation/ShortestPathStepper.hpp"
 #include "constants/Constants.hpp"
+#include "cross_platform/GLUT.hpp"
 #include "Graph.hpp"
 #include "graph_representation/GraphRepresentation.hpp"
 #include "graph_representation/GraphRepresentationAdjacencyMatrix.hpp"
+#include "graph_representation/GraphRepresentationBitMatrix.hpp"
+#include "stats/AllocationCounter.hpp"
+#include "stats/StatsRegistry.hpp"
+#include "stats/Trace.hpp"
 #include "components/Vertex.hpp"
 
 /*
 Static variables.
 */
-Window* Graph::window(0);
-int     Graph::graph_counter(0);
+Window*  Graph::window(0);
+int      Graph::graph_counter(0);
+uint64_t Graph::seed(0);
 
 /*
 Graph constructor.
 */
 Graph::Graph(GRAPH_TYPE type, int nb_vertices) :
     nb_vertices(nb_vertices),
+    animation(0),
     type(type),
     arc_integer_capacities_defined(false),
+    cancel_flag(0),
+    generator(GABRIEL),
     is_displayed(false),
+    job_runner(new JobRunner),
+    kdtree(0),
     orientation(NONE),
-    window_id(-1) {
+    picked_destination(-1),
+    picked_source(-1),
+    quadtree(0),
+    rng(seed),
+    stats_depth(0),
+    window_id(-1),
+    workspace(0) {
     graph_counter++;
     switch(type) {
         case ADJACENCY_MATRIX :
             graph_representation = new GraphRepresentationAdjacencyMatrix(nb_vertices);
             break;
+        case ADJACENCY_BIT_MATRIX :
+            graph_representation = new GraphRepresentationBitMatrix(nb_vertices);
+            break;
     }
 }
 
@@ -73,6 +97,11 @@ Graph desctructor.
 */
 Graph::~Graph() {
     graph_counter--;
+    delete animation;
+    delete job_runner;
+    delete kdtree;
+    delete quadtree;
+    delete workspace;
     delete graph_representation;
 }
 
@@ -82,23 +111,34 @@ same number of vertices. All the parameters are copied expect the
 window handling that has to be manually set.
 */
 Graph &Graph::operator=(const Graph &g) {
+    TRACE_SCOPE("Graph::operator=");
     if(this==&g) {
         return *this;
     }
     else {
         arc_integer_capacities_defined = g.arc_integer_capacities_defined;
+        generator                      = g.generator;
         is_displayed                   = g.is_displayed;
         orientation                    = g.orientation;
+        picked_destination             = g.picked_destination;
+        picked_source                  = g.picked_source;
+        rng                            = g.rng;
+        viewport                       = g.viewport;
         *graph_representation          = *g.graph_representation;
+        delete kdtree;
+        delete quadtree;
+        kdtree                         = 0;
+        quadtree                       = 0;
         return *this;
     }
 }
 
 /*
-Creates an Edge that binds two vertices.
+Creates an Edge that binds two vertices. The capacity is rounded if the
+capacities are integers, see components/Weight.hpp.
 */
 Edge* Graph::add_edge(const Vertex* v1, const Vertex* v2, double capacity) {
-    return graph_representation->add_edge(v1, v2, capacity, 0);
+    return graph_representation->add_edge(v1, v2, WeightTraits<Weight>::round(capacity), 0);
 }
 
 /*
@@ -109,44 +149,89 @@ Vertex* Graph::add_vertex(double x, double y) {
 }
 
 /*
-Generates random vertices and build edges to form a Gabriel graph.
+Builds the topology given by the generator of the graph, see
+generate_topology().
 */
 void Graph::generate() {
-    generate_random_vertices();
-    generate_gabriel_naive();
+    TRACE_SCOPE("Graph::generate");
+    std::vector<std::pair<double, double>> points;
+    std::vector<std::pair<int, int>>       edges;
+    std::vector<Weight>                    capacities;
+    generate_topology(generator, nb_vertices, &rng, &points, &edges, &capacities);
+    for(const std::pair<double, double>& p : points) graph_representation->add_vertex(p.first, p.second);
+    graph_representation->add_edges(edges);
+    if(!capacities.empty()) {
+        for(Edge* e : *graph_representation->getEdges()) {
+            graph_representation->set_capacity_v1_to_v2(e, capacities[e->getId()]);
+            graph_representation->set_capacity_v2_to_v1(e, 0);
+        }
+        arc_integer_capacities_defined = true;
+    }
+}
+
+/*
+Draws the topology of a graph of n vertices with the given generator,
+without building its representation: the coordinates of the vertices,
+the end points of the edges, and for the generators which draw them the
+integer capacities of the edges (from v1 to v2, none the other way),
+empty otherwise. The default generator draws evenly spaced random
+vertices and builds edges to form a Gabriel graph, the others are in
+graph/generators.cpp.
+*/
+void Graph::generate_topology(GRAPH_GENERATOR generator, int n, Philox* rng, std::vector<std::pair<double, double>>* points, std::vector<std::pair<int, int>>* edges, std::vector<Weight>* capacities) {
+    points->clear();
+    edges->clear();
+    capacities->clear();
+    switch(generator) {
+        case GABRIEL     : generate_random_vertices_spacing(n, rng, points);
+                           generate_gabriel_naive(*points, edges);
+                           break;
+        case GRID        : generate_grid(n, rng, points, edges, capacities);
+                           break;
+        case GEOMETRIC   : generate_geometric(n, rng, points, edges);
+                           break;
+        case ERDOS_RENYI : generate_erdos_renyi(n, rng, points, edges);
+                           break;
+        case RMAT        : generate_rmat(n, rng, points, edges);
+                           break;
+    }
 }
 
 /*
-Returns the graph's total weight.
+Returns the graph's total weight, summed exactly for integer capacities.
 */
-double Graph::get_total_weight() {
+WeightSum Graph::get_total_weight() {
     std::vector<Edge*>::iterator it_begin = graph_representation->getEdges()->begin();
     std::vector<Edge*>::iterator it_end   = graph_representation->getEdges()->end();
     if(orientation==NONE || orientation==ONE_WAY) {
-        return std::accumulate(it_begin, it_end, 0, [](double sum, const Edge* v) { return sum + v->getCapacityV1ToV2(); });
+        return std::accumulate(it_begin, it_end, WeightSum(0), [this](WeightSum sum, const Edge* v) { return sum + graph_representation->get_capacity_v1_to_v2(v); });
     }
     else {
-        return std::accumulate(it_begin, it_end, 0, [](double sum, const Edge* v) { return sum + v->getCapacityV1ToV2()+v->getCapacityV2ToV1(); });
+        return std::accumulate(it_begin, it_end, WeightSum(0), [this](WeightSum sum, const Edge* v) { return sum + graph_representation->get_capacity_v1_to_v2(v)+graph_representation->get_capacity_v2_to_v1(v); });
     }
 }
 
 /*
-Naive algorithm to obtain a Gabriel graph from a set of vertices.
+Naive algorithm to obtain a Gabriel graph from a set of points.
 */
-void Graph::generate_gabriel_naive() {
-    for(int i=0 ; i<nb_vertices ; i++) {
-        for(int j=i+1 ; j<nb_vertices ; j++) {
+void Graph::generate_gabriel_naive(const std::vector<std::pair<double, double>>& points, std::vector<std::pair<int, int>>* edges) {
+    TRACE_SCOPE("Graph::generate_gabriel_naive");
+    std::vector<Vertex> vertices;
+    vertices.reserve(points.size());
+    for(std::size_t i=0 ; i<points.size() ; i++) vertices.push_back(Vertex(points[i].first, points[i].second, static_cast<int>(i)));
+    for(std::size_t i=0 ; i<vertices.size() ; i++) {
+        for(std::size_t j=i+1 ; j<vertices.size() ; j++) {
             bool valid_edge = true;
-            Vertex* v1 = graph_representation->getVertices()->at(i);
-            Vertex* v2 = graph_representation->getVertices()->at(j);
+            const Vertex* v1 = &vertices[i];
+            const Vertex* v2 = &vertices[j];
             double diameter = v1->distanceTo(v2);
-            for(Vertex* v : *graph_representation->getVertices()) {
-                if(v!=v1 && v!=v2 && pow(v1->distanceTo(v), 2)+pow(v2->distanceTo(v), 2)<diameter*diameter) {
+            for(const Vertex& v : vertices) {
+                if(&v!=v1 && &v!=v2 && pow(v1->distanceTo(&v), 2)+pow(v2->distanceTo(&v), 2)<diameter*diameter) {
                     valid_edge = false;
                     break;
                 }
             }
-            if(valid_edge) graph_representation->add_edge(v1, v2);
+            if(valid_edge) edges->push_back(std::make_pair(static_cast<int>(i), static_cast<int>(j)));
         }
     }
 }
@@ -168,6 +253,63 @@ void Graph::delete_graph() {
     }
 }
 
+/*
+Advances the animated algorithm for one frame: its steps are run until
+the time budget of the frame is spent. Called by the render loop.
+*/
+void Graph::advance_animation() {
+    if(animation && !animation->run_for(Constants::ANIMATION_FRAME_BUDGET, Constants::ANIMATION_STEPS_PER_FRAME)) {
+        delete animation;
+        animation = 0;
+    }
+}
+
+/*
+Prints the counters of the last algorithm run and shows a summary in the
+title of the window. Does nothing if the statistics are compiled out.
+*/
+void Graph::display_stats() const {
+#ifdef GRAPHS_STATS
+    std::cout << run_stats << std::endl;
+    if(is_displayed) window->setTitle(window_id, "Graph - " + std::to_string(window_id) + " - " + run_stats.summary());
+#endif
+}
+
+/*
+Name of a graph type, for the console.
+*/
+static const char* graph_type_name(GRAPH_TYPE type) {
+    switch(type) {
+        case ADJACENCY_MATRIX     : return "adjacency matrix";
+        case ADJACENCY_BIT_MATRIX : return "bit matrix";
+    }
+    return "unknown";
+}
+
+/*
+Prints the memory used by the graph and the process, and the
+representation recommended for larger graphs of the same density.
+*/
+void Graph::display_memory() const {
+    MemoryFootprint footprint = memory_footprint();
+    std::cout << "graph: " << footprint << std::endl;
+#ifdef GRAPHS_STATS
+    std::cout << "process: " << AllocationCounter::live_bytes() << " bytes allocated, "
+              << AllocationCounter::peak_bytes() << " bytes peak since the last algorithm" << std::endl;
+#endif
+    int    nb_edges = graph_representation->getEdges()->size();
+    double density  = nb_vertices ? static_cast<double>(nb_edges)/nb_vertices : 0;
+    for(int scale=1 ; scale<=1000 ; scale*=10) {
+        int        v = nb_vertices*scale;
+        int        e = static_cast<int>(density*v);
+        GRAPH_TYPE recommended;
+        std::cout << v << " vertices, " << e << " edges: matrix " << estimate_footprint(ADJACENCY_MATRIX, v, e).total() << " bytes, "
+                  << "bit matrix " << estimate_footprint(ADJACENCY_BIT_MATRIX, v, e).total() << " bytes, ";
+        if(recommend_representation(v, e, &recommended)) std::cout << "recommended: " << graph_type_name(recommended) << std::endl;
+        else                                             std::cout << "no representation fits in " << Constants::MEMORY_BUDGET_GB << " GB" << std::endl;
+    }
+}
+
 /*
 Adds a Graph handler to the Window object which subsequently creates a new window. 
 */
@@ -184,10 +326,58 @@ bool Graph::display() {
 }
 
 /*
-Keyboard function.
+Memory a graph of the given type and size would use.
+*/
+MemoryFootprint Graph::estimate_footprint(GRAPH_TYPE type, int nb_vertices, int nb_edges) {
+    switch(type) {
+        case ADJACENCY_MATRIX :
+            return GraphRepresentationAdjacencyMatrix::estimate_footprint(nb_vertices, nb_edges);
+        case ADJACENCY_BIT_MATRIX :
+            return GraphRepresentationBitMatrix::estimate_footprint(nb_vertices, nb_edges);
+    }
+    return MemoryFootprint();
+}
+
+/*
+Memory used by the graph representation.
+*/
+MemoryFootprint Graph::memory_footprint() const {
+    return graph_representation->memory_footprint();
+}
+
+/*
+Picks the smallest representation for a graph of the given size. The
+flow algorithms work on a residual copy of the graph, so twice the
+footprint has to fit in Constants::MEMORY_BUDGET_GB. Returns false if
+no representation fits.
+*/
+bool Graph::recommend_representation(int nb_vertices, int nb_edges, GRAPH_TYPE* type) {
+    const GRAPH_TYPE   types[]  = {ADJACENCY_MATRIX, ADJACENCY_BIT_MATRIX};
+    const double       budget   = Constants::MEMORY_BUDGET_GB*1024*1024*1024;
+    unsigned long long smallest = 0;
+    bool               found    = false;
+    for(GRAPH_TYPE t : types) {
+        unsigned long long bytes = estimate_footprint(t, nb_vertices, nb_edges).total();
+        if(2*bytes<=budget && (!found || bytes<smallest)) {
+            *type    = t;
+            smallest = bytes;
+            found    = true;
+        }
+    }
+    return found;
+}
+
+/*
+Keyboard function. The algorithms run on a worker thread, on a snapshot
+of the graph. Upper case letters animate the algorithm instead. While an
+algorithm is running, only 'c' (cancel) and escape are accepted.
 */
 void Graph::keyboard(unsigned char key, int x, int y) {
     bool this_deleted = false;
+    if(is_busy() && key!='c' && key!=27) {
+        std::cout << "an algorithm is already running, press 'c' to cancel it" << std::endl;
+        return;
+    }
     switch(key) {
         case '+' : rebuild_graph(nb_vertices+Constants::GRAPH_VERTICES_INCREMENTATION);
                    this_deleted = true;
@@ -204,19 +394,43 @@ void Graph::keyboard(unsigned char key, int x, int y) {
                    break;
         case '3' : keyboard_capacities();
                    break;
-        case 'a' : delete handler_astar();
+        case 'A' :
+        case 'D' :
+        case 'E' :
+        case 'P' : start_animation(key);
+                   break;
+        case 'a' : run_job([](Graph* g) { delete g->handler_astar(); });
+                   break;
+        case 'b' : run_job([](Graph* g) { delete g->handler_bron_kerbosch(); });
+                   break;
+        case 'c' : if(job_runner->busy()) {
+                       job_runner->cancel();
+                       std::cout << "cancelling..." << std::endl;
+                   }
+                   if(animation) {
+                       delete animation;
+                       animation = 0;
+                   }
                    break;
-        case 'b' : delete handler_bron_kerbosch();
+        case 'd' : run_job([](Graph* g) { delete g->handler_dijkstra(); });
                    break;
-        case 'd' : delete handler_dijkstra();
+        case 'e' : run_job([](Graph* g) { g->handler_edmonds_karp(); });
                    break;
-        case 'e' : handler_edmonds_karp();
+        case 'f' : run_job([](Graph* g) { g->handler_ford_fulkerson(); });
                    break;
-        case 'f' : handler_ford_fulkerson();
+        case 'h' : run_job([](Graph* g) { delete g->handler_bfs(); });
                    break;
-        case 'p' : delete handler_prim();
+        case 'l' : run_job([](Graph* g) { delete g->handler_delta_stepping(); });
                    break;
-        case 't' : delete handler_traveling_salesman();
+        case 'm' : display_memory();
+                   break;
+        case 'p' : run_job([](Graph* g) { delete g->handler_prim(); });
+                   break;
+        case 'r' : run_job([](Graph* g) { delete g->handler_traveling_salesman(0, 0, TSP_NEAREST_NEIGHBOR); });
+                   break;
+        case 's' : StatsRegistry::print(std::cout);
+                   break;
+        case 't' : run_job([](Graph* g) { delete g->handler_traveling_salesman(); });
                    break;
         case 13  : keyboard_dupplicate();           /* enter */
                    break;
@@ -229,19 +443,67 @@ void Graph::keyboard(unsigned char key, int x, int y) {
     if(!this_deleted) draw();
 }
 
+/*
+Special keys function. The arrows move the view, page up and page down
+zoom in and out, and home goes back to the default view.
+*/
+void Graph::special(int key, int x, int y) {
+    switch(key) {
+        case GLUT_KEY_LEFT      : viewport.pan(-Constants::RENDER_PAN_STEP, 0);
+                                  break;
+        case GLUT_KEY_RIGHT     : viewport.pan(Constants::RENDER_PAN_STEP, 0);
+                                  break;
+        case GLUT_KEY_DOWN      : viewport.pan(0, -Constants::RENDER_PAN_STEP);
+                                  break;
+        case GLUT_KEY_UP        : viewport.pan(0, Constants::RENDER_PAN_STEP);
+                                  break;
+        case GLUT_KEY_PAGE_UP   : viewport.zoom_in();
+                                  break;
+        case GLUT_KEY_PAGE_DOWN : viewport.zoom_out();
+                                  break;
+        case GLUT_KEY_HOME      : viewport.reset();
+                                  break;
+    }
+    draw();
+}
+
+/*
+Mouse function. A left click picks the vertex under the cursor as the
+source, the next one as the destination of the path and flow algorithms.
+Clicking again starts a new selection.
+*/
+void Graph::mouse(int button, int state, int x, int y) {
+    if(button!=GLUT_LEFT_BUTTON || state!=GLUT_DOWN || is_busy()) return;
+    int    width  = glutGet(GLUT_WINDOW_WIDTH);
+    int    height = glutGet(GLUT_WINDOW_HEIGHT);
+    double wx, wy;
+    viewport.to_world(x, y, width, height, &wx, &wy);
+    const Vertex* v      = nearest_vertex(wx, wy);
+    double        radius = Constants::RENDER_PICKING_RADIUS_PIXELS*viewport.pixel_size(width);
+    if(!v || (v->getX()-wx)*(v->getX()-wx)+(v->getY()-wy)*(v->getY()-wy)>radius*radius) return;
+    if(picked_source<0 || picked_destination>=0) {
+        clear_color();
+        picked_source      = v->getId();
+        picked_destination = -1;
+        graph_representation->set_color(v, Constants::EDGE_ALGO_SOURCE_COLOR_R, Constants::EDGE_ALGO_SOURCE_COLOR_G, Constants::EDGE_ALGO_SOURCE_COLOR_B);
+    }
+    else if(v->getId()!=picked_source) {
+        picked_destination = v->getId();
+        graph_representation->set_color(v, Constants::EDGE_ALGO_DESTINATION_COLOR_R, Constants::EDGE_ALGO_DESTINATION_COLOR_G, Constants::EDGE_ALGO_DESTINATION_COLOR_B);
+    }
+    draw();
+}
+
 /*
 Generates or disables arc capacities.
 */
 void Graph::keyboard_capacities() {
     if(!arc_integer_capacities_defined) {
-        generate_random_arc_integer_capacities();
+        generate_random_arc_integer_capacities(&rng);
         arc_integer_capacities_defined = true;
     }
     else {
-        for(Edge* e : *graph_representation->getEdges()) {
-            e->setCapacityV1ToV2(Constants::EDGE_DEFAULT_CAPACITY);
-            e->setCapacityV2ToV1(Constants::EDGE_DEFAULT_CAPACITY);
-        }
+        graph_representation->fill_capacities(Constants::EDGE_DEFAULT_CAPACITY);
         arc_integer_capacities_defined = false;
     }
 }
@@ -252,13 +514,49 @@ Generates or disables arc directions.
 void Graph::keyboard_directions() {
     if(orientation==NONE) {
         orientation = ONE_WAY;
-        generate_random_arc_directions();
+        generate_random_arc_directions(&rng);
     }
     else {
         orientation = NONE;
     }
 }
 
+/*
+Starts the job on a snapshot of the graph, on the worker thread. Returns
+false if an algorithm is already running. The result is copied back into
+the graph by collect_job() once the job is over.
+*/
+bool Graph::run_job(const std::function<void(Graph*)>& job) {
+    if(job_runner->busy()) return false;
+    Graph* snapshot = new Graph(*this);
+    snapshot->setCancelFlag(job_runner->getCancelFlag());
+    job_runner->start(snapshot, job);
+    return true;
+}
+
+/*
+Publishes the result of the job once it is over: the snapshot, colored
+by the algorithm, replaces the graph. The result of a cancelled job is
+dropped. Called by the render loop.
+*/
+void Graph::collect_job() {
+    bool   cancelled = false;
+    Graph* snapshot  = job_runner->collect(&cancelled);
+    if(snapshot) {
+        if(cancelled) {
+            std::cout << "algorithm cancelled" << std::endl;
+        }
+        else {
+            Viewport current_viewport = viewport;
+            *this     = *snapshot;
+            viewport  = current_viewport;
+            run_stats = snapshot->run_stats;
+            display_stats();
+        }
+        delete snapshot;
+    }
+}
+
 /*
 Creates a dupplicate of the current graph and displays it. Returns
 true if the graph can be displayed.
@@ -266,6 +564,7 @@ true if the graph can be displayed.
 bool Graph::keyboard_dupplicate() {
     Graph* graph_duplicate = new Graph(type, nb_vertices);
     *graph_duplicate       = *this;
+    graph_duplicate->rng   = rng.split();
     return graph_duplicate->display();
 }
 
@@ -275,11 +574,10 @@ Reset the graph to the initial parameters of color, arc capacity and direction.
 void Graph::clear() {
     arc_integer_capacities_defined = false;
     orientation                    = NONE;
-    for(Edge* e : *graph_representation->getEdges()) {
-        e->setCapacityV1ToV2(Constants::EDGE_DEFAULT_CAPACITY);
-        e->setCapacityV2ToV1(Constants::EDGE_DEFAULT_CAPACITY);
-        e->setColor(Constants::EDGE_COLOR_R, Constants::EDGE_COLOR_G, Constants::EDGE_COLOR_B);
-    }
+    picked_destination             = -1;
+    picked_source                  = -1;
+    graph_representation->fill_capacities(Constants::EDGE_DEFAULT_CAPACITY);
+    graph_representation->fill_edge_colors(Constants::EDGE_COLOR_R, Constants::EDGE_COLOR_G, Constants::EDGE_COLOR_B);
     clear_color_vertices();
 }
 
@@ -295,21 +593,15 @@ void Graph::clear_color() {
 Reset the vertices to the initial parameters of color.
 */
 void Graph::clear_color_vertices() {
-    for(Edge* e : *graph_representation->getEdges()) {
-        e->setColor(Constants::EDGE_COLOR_R, Constants::EDGE_COLOR_G, Constants::EDGE_COLOR_B);
-    }
-    for(Vertex* v : *graph_representation->getVertices()) {
-        v->setColor(Constants::VERTEX_COLOR_R, Constants::VERTEX_COLOR_G, Constants::VERTEX_COLOR_B);
-    }
+    graph_representation->fill_edge_colors(Constants::EDGE_COLOR_R, Constants::EDGE_COLOR_G, Constants::EDGE_COLOR_B);
+    graph_representation->fill_vertex_colors(Constants::VERTEX_COLOR_R, Constants::VERTEX_COLOR_G, Constants::VERTEX_COLOR_B);
 }
 
 /*
 Reset the edges to the initial parameters of color.
 */
 void Graph::clear_color_edges() {
-    for(Edge* e : *graph_representation->getEdges()) {
-        e->setColor(Constants::EDGE_COLOR_R, Constants::EDGE_COLOR_G, Constants::EDGE_COLOR_B);
-    }
+    graph_representation->fill_edge_colors(Constants::EDGE_COLOR_R, Constants::EDGE_COLOR_G, Constants::EDGE_COLOR_B);
 }
 
 /*
@@ -318,8 +610,12 @@ Creates a new graph with the given number of vertices. The actual graph
 graph is automatically displayed in the same window.
 */
 Graph* Graph::rebuild_graph(int new_nb_vertices) {
-    Graph* new_graph = new Graph(type, new_nb_vertices);
+    TRACE_SCOPE("Graph::rebuild_graph");
+    Graph* new_graph     = new Graph(type, new_nb_vertices);
+    new_graph->generator = generator;
+    new_graph->rng       = rng.split();
     new_graph->generate();
+    new_graph->viewport = viewport;
     if(is_displayed) {
         new_graph->setDisplayed(is_displayed);
         new_graph->setWindowId(window_id);
@@ -334,35 +630,82 @@ Graph* Graph::rebuild_graph(int new_nb_vertices) {
 Selects two random vertices from the graph. If the graph has at
 least two vertices, the two selected vertices are different.
 */
-void Graph::select_two_random_vertices(const Vertex** v1, const Vertex** v2) const {
-    *v1 = graph_representation->getVertices()->at(rand() % nb_vertices);
-    if(nb_vertices>=2) { do { *v2 = graph_representation->getVertices()->at(rand() % nb_vertices); } while(*v1==*v2); }
+void Graph::select_two_random_vertices(Philox* rng, const Vertex** v1, const Vertex** v2) const {
+    *v1 = graph_representation->getVertices()->at(rng->uniform_int(nb_vertices));
+    if(nb_vertices>=2) { do { *v2 = graph_representation->getVertices()->at(rng->uniform_int(nb_vertices)); } while(*v1==*v2); }
     else               { *v2 = *v1; }
 }
 
 /*
 Selects oen random vertices from the graph.
 */
-void Graph::select_one_random_vertices(const Vertex** v) const {
-    *v = graph_representation->getVertices()->at(rand() % nb_vertices);
+void Graph::select_one_random_vertices(Philox* rng, const Vertex** v) const {
+    *v = graph_representation->getVertices()->at(rng->uniform_int(nb_vertices));
 }
 
 /*
 Selects n random vertices from the graph. If the graph has at least
 two vertices, the two selected vertices are different.
 */
-void Graph::select_n_random_vertices(std::vector<const Vertex*>** vertices, int n, const Vertex* except) const {
+void Graph::select_n_random_vertices(Philox* rng, std::vector<const Vertex*>** vertices, int n, const Vertex* except) const {
     std::set<const Vertex*> included_vertices;
     for(int i=0 ; i<n ; i++) {
         const Vertex* v;
         do {
-            v = graph_representation->getVertices()->at(rand() % nb_vertices);
+            v = graph_representation->getVertices()->at(rng->uniform_int(nb_vertices));
         } while(included_vertices.count(v) || v==except);
         included_vertices.insert(v);
         (*vertices)->push_back(v);
     }
 }
 
+/*
+Returns the vertex closest to (x, y), or 0 if the graph has no vertices.
+The k-d tree is built on the first call.
+*/
+const Vertex* Graph::nearest_vertex(double x, double y) const {
+    if(!kdtree || kdtree->getNbVertices()!=static_cast<int>(graph_representation->getVertices()->size())) {
+        delete kdtree;
+        kdtree = new KdTree(graph_representation->getVertices());
+    }
+    return kdtree->nearest(x, y);
+}
+
+/*
+Gives the source and the destination picked with the mouse. Returns
+false, without changing them, if both were not picked.
+*/
+bool Graph::picked_vertices(Vertex** source, Vertex** destination) const {
+    if(picked_source<0 || picked_destination<0) return false;
+    *source      = graph_representation->getVertices()->at(picked_source);
+    *destination = graph_representation->getVertices()->at(picked_destination);
+    return true;
+}
+
+/*
+Starts the animation of an algorithm: A* ('A'), Dijkstra ('D'), Edmonds-Karp
+('E') or Prim ('P'). The graph is prepared as for the corresponding handler
+and the algorithm is then advanced by the render loop.
+*/
+void Graph::start_animation(unsigned char key) {
+    Vertex* source      = 0;
+    Vertex* destination = 0;
+    switch(key) {
+        case 'A' : prepare_path(&source, &destination);
+                   animation = new ShortestPathStepper(this, source, destination, true);
+                   break;
+        case 'D' : prepare_path(&source, &destination);
+                   animation = new ShortestPathStepper(this, source, destination, false);
+                   break;
+        case 'E' : prepare_flow(&source, &destination);
+                   animation = new EdmondsKarpStepper(this, source, destination);
+                   break;
+        case 'P' : prepare_prim();
+                   animation = new PrimStepper(this);
+                   break;
+    }
+}
+
 /*
 Disables the checks before an algorithm's execution and trusts the user.
 For example, assumes that all capacities and arc directions are correctly
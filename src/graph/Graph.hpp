@@ -24,14 +24,28 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef Graph_hpp
 #define Graph_hpp
 
+#include <atomic>
+#include <functional>
 #include <map>
 #include <vector>
 #include <set>
+#include <utility>
 
+#include "animation/AlgorithmStepper.hpp"
 #include "components/Edge.hpp"
+#include "concurrency/JobRunner.hpp"
 #include "graph_representation/GraphRepresentation.hpp"
+#include "KdTree.hpp"
+#include "Philox.hpp"
 #include "components/Vertex.hpp"
+#include "components/Weight.hpp"
+#include "rendering/QuadTree.hpp"
+#include "rendering/Viewport.hpp"
 #include "rendering/Window.hpp"
+#include "stats/AlgorithmStats.hpp"
+#include "stats/MemoryFootprint.hpp"
+
+namespace Algorithms { struct Workspace; }
 
 class Graph {
 
@@ -42,42 +56,73 @@ class Graph {
         ~Graph();
         Graph& operator=(const Graph&);
     
- static void setWindow(Window* w) { window = w; }
+ static uint64_t getSeed()            { return seed; }
+ static void     setSeed(uint64_t s)  { seed = s; }
+ static void     setWindow(Window* w) { window = w; }
+    
+ static void            benchmark(GRAPH_TYPE, GRAPH_GENERATOR, const std::vector<int>&, const std::vector<VERTEX_ORDERING>& = {});
+ static MemoryFootprint estimate_footprint(GRAPH_TYPE, int, int);
+ static void            generate_topology(GRAPH_GENERATOR, int, Philox*, std::vector<std::pair<double, double>>*, std::vector<std::pair<int, int>>*, std::vector<Weight>*);
+ static const char*     generator_name(GRAPH_GENERATOR);
+ static const char*     ordering_name(VERTEX_ORDERING);
+ static bool            parse_generator(const char*, GRAPH_GENERATOR*);
+ static bool            parse_ordering(const char*, VERTEX_ORDERING*);
+ static bool            recommend_representation(int, int, GRAPH_TYPE*);
     
-        int        getNbVertices() const { return nb_vertices; }
-        GRAPH_TYPE getType()       const { return type; }
-        int        getWindowId()   const { return window_id; }
+        GRAPH_GENERATOR      getGenerator()           const { return generator; }
+        GraphRepresentation* getGraphRepresentation() const { return graph_representation; }
+        int                  getNbVertices()          const { return nb_vertices; }
+        GRAPH_ORIENTATION    getOrientation()         const { return orientation; }
+        GRAPH_TYPE           getType()                const { return type; }
+        int                  getWindowId()            const { return window_id; }
+        bool                 is_busy()                const { return job_runner->busy() || animation; }
+        bool                 is_cancelled()           const { return cancel_flag && *cancel_flag; }
+  const AlgorithmStats&      last_run_stats()         const { return run_stats; }
     
-        void setDisplayed(bool displayed)        { is_displayed = displayed; }
-        void setOrientation(GRAPH_ORIENTATION o) { orientation = o; }
-        void setWindowId(int id)                 { window_id = id; }
+        void setCancelFlag(const std::atomic<bool>* f) { cancel_flag = f; }
+        void setDisplayed(bool displayed)               { is_displayed = displayed; }
+        void setGenerator(GRAPH_GENERATOR g)            { generator = g; }
+        void setOrientation(GRAPH_ORIENTATION o)        { orientation = o; }
+        void setWindowId(int id)                        { window_id = id; }
     
         Edge*                       add_edge(const Vertex*, const Vertex*, double=Constants::EDGE_DEFAULT_CAPACITY);
         Vertex*                     add_vertex(double=0, double=0);
+        void                        advance_animation();
         void                        clear();
         void                        clear_color();
         void                        clear_color_edges();
         void                        clear_color_vertices();
+        void                        collect_job();
         void                        delete_graph();
+        void                        display_memory() const;
+        void                        display_stats() const;
         bool                        display();
         void                        draw() const;
         void                        generate();
-        void                        generate_gabriel_naive();
-        void                        generate_random_arc_integer_capacities();
-        void                        generate_random_arc_directions();
-        void                        generate_random_vertices();
-        void                        generate_random_vertices_spacing();
-        double                      get_total_weight();
+        void                        generate_random_arc_integer_capacities(Philox*);
+        void                        generate_random_arc_directions(Philox*);
+        WeightSum                   get_total_weight();
         std::vector<const Edge*>*   handler_astar(Vertex* =0, Vertex* =0);
+        std::vector<int>*           handler_bfs(Vertex* =0, Vertex* =0);
         std::set<const Vertex*>*    handler_bron_kerbosch();
+        std::vector<double>*        handler_delta_stepping(Vertex* =0, Vertex* =0);
         std::vector<const Edge*>*   handler_dijkstra(Vertex* =0, Vertex* =0);
-        int                         handler_edmonds_karp(Vertex* =0, Vertex* =0);
-        int                         handler_ford_fulkerson(Vertex* =0, Vertex* =0);
+        WeightSum                   handler_edmonds_karp(Vertex* =0, Vertex* =0);
+        WeightSum                   handler_ford_fulkerson(Vertex* =0, Vertex* =0);
         std::vector<const Edge*>*   handler_prim();
-        std::vector<const Vertex*>* handler_traveling_salesman(Vertex* =0, std::vector<const Vertex*>* =0);
+        std::vector<const Vertex*>* handler_traveling_salesman(Vertex* =0, std::vector<const Vertex*>* =0, TSP_SOLVER=TSP_EXACT);
+        int                         hop_distance(const Vertex*, const Vertex*);
+        bool                        is_reachable(const Vertex*, const Vertex*);
         void                        keyboard(unsigned char, int, int);
+        WeightSum                   max_flow(const Vertex*, const Vertex*);
+        MemoryFootprint             memory_footprint() const;
+        void                        mouse(int, int, int, int);
+        const Vertex*               nearest_vertex(double, double) const;
         Graph*                      rebuild_graph(int);
+        std::vector<int>            reorder(VERTEX_ORDERING);
         void                        set_ready_for_algo(GRAPH_ALGO algo);
+        bool                        shortest_path_tree(const Vertex*, std::vector<double>*, std::vector<int>*);
+        void                        special(int, int, int);
  
     private:
     
@@ -86,39 +131,69 @@ class Graph {
         class AdjacencyMatrix;
         class AdjacencyList;
     
- static int     graph_counter;
- static Window* window;
+ static int      graph_counter;
+ static uint64_t seed;
+ static Window*  window;
+
+ static void generate_erdos_renyi(int, Philox*, std::vector<std::pair<double, double>>*, std::vector<std::pair<int, int>>*);
+ static void generate_gabriel_naive(const std::vector<std::pair<double, double>>&, std::vector<std::pair<int, int>>*);
+ static void generate_geometric(int, Philox*, std::vector<std::pair<double, double>>*, std::vector<std::pair<int, int>>*);
+ static void generate_grid(int, Philox*, std::vector<std::pair<double, double>>*, std::vector<std::pair<int, int>>*, std::vector<Weight>*);
+ static void generate_random_vertices(int, Philox*, std::vector<std::pair<double, double>>*);
+ static void generate_random_vertices_spacing(int, Philox*, std::vector<std::pair<double, double>>*);
+ static void generate_rmat(int, Philox*, std::vector<std::pair<double, double>>*, std::vector<std::pair<int, int>>*);
 
         std::vector<const Edge*>*   algo_astar(const Vertex*, const Vertex*, bool=false);
-        std::set<const Vertex*>*    algo_bron_kerbosch();
-        bool                        algo_bron_kerbosch_callback(std::vector<std::set<const Vertex*>>*, std::set<const Vertex*>, std::set<const Vertex*>, std::set<const Vertex*>);
-        std::vector<const Edge*>*   algo_dijkstra(const Vertex*, const Vertex*);
-        int                         algo_edmonds_karp(const Vertex*, const Vertex*);
-        bool                        algo_edmonds_karp_bfs(const Graph*, std::map<const Vertex*, double>*, std::map<const Vertex*, const Vertex*>*, const Vertex*, const Vertex*);
-        int                         algo_ford_fulkerson(const Vertex*, const Vertex*);
-        bool                        algo_ford_fulkerson_dfs(const Graph*, std::vector<const Vertex*>*, std::set<const Vertex*>*, const Vertex*, const Vertex*);
-        std::vector<const Edge*>*   algo_prim();
-        std::vector<const Vertex*>* algo_traveling_salesman(const Vertex*, std::vector<const Vertex*>*);
-        void                        algo_traveling_salesman_callback(double**, std::map<const Vertex*, unsigned long int>, const Vertex*, std::vector<const Vertex*>*, std::vector<const Vertex*>*, std::vector<const Vertex*>*, std::set<const Vertex*>*, double, double*);
-        double**                    algo_traveling_salesman_cost_matrix(const Vertex*, std::vector<const Vertex*>*);
-        void                        draw_edges()               const;
-        void                        draw_edge_capacity(Edge*)  const;
-        void                        draw_edge_direction(Edge*) const;
-        void                        draw_vertices()            const;
+        std::vector<int>*           algo_bfs(const Vertex*, const Vertex* =0, bool=false);
+        std::set<const Vertex*>*    algo_bron_kerbosch(bool=false);
+        bool                        algo_delta_stepping(const Vertex*, std::vector<double>*, std::vector<int>*);
+        std::vector<const Edge*>*   algo_dijkstra(const Vertex*, const Vertex*, bool=false);
+        WeightSum                   algo_edmonds_karp(const Vertex*, const Vertex*, bool=false);
+        WeightSum                   algo_ford_fulkerson(const Vertex*, const Vertex*, bool=false);
+        std::vector<const Edge*>*   algo_prim(bool=false);
+        std::vector<const Vertex*>* algo_traveling_salesman(const Vertex*, std::vector<const Vertex*>*, double* =0, bool=false, bool=false);
+        double**                    algo_traveling_salesman_cost_matrix(const Vertex*, std::vector<const Vertex*>*, std::vector<std::vector<int>>* =0);
+        std::vector<const Vertex*>* algo_traveling_salesman_heuristic(const Vertex*, std::vector<const Vertex*>*, TSP_SOLVER, double* =0, double* =0, bool=false);
+        void                        algo_traveling_salesman_route(const std::vector<const Vertex*>&, const std::vector<int>&, const std::vector<std::vector<int>>&);
+        void                        draw_edges(const std::vector<const Edge*>&, double) const;
+        void                        draw_edge_capacity(const Edge*)                     const;
+        void                        draw_edge_direction(const Edge*)                    const;
+        void                        draw_tiles(double)                                  const;
+        void                        draw_vertices(const std::vector<const Vertex*>&)    const;
         void                        keyboard_capacities();
         void                        keyboard_directions();
         bool                        keyboard_dupplicate();
-        void                        select_one_random_vertices(const Vertex**)                                 const;
-        void                        select_two_random_vertices(const Vertex**, const Vertex**)                 const;
-        void                        select_n_random_vertices(std::vector<const Vertex*>**, int, const Vertex*) const;
+        bool                        picked_vertices(Vertex**, Vertex**) const;
+        void                        prepare_flow(Vertex**, Vertex**);
+        void                        prepare_path(Vertex**, Vertex**);
+        void                        prepare_prim();
+        bool                        run_job(const std::function<void(Graph*)>&);
+        void                        select_one_random_vertices(Philox*, const Vertex**)                                 const;
+        void                        select_two_random_vertices(Philox*, const Vertex**, const Vertex**)                 const;
+        void                        select_n_random_vertices(Philox*, std::vector<const Vertex*>**, int, const Vertex*) const;
+        void                        start_animation(unsigned char);
+        Algorithms::Workspace*      search_workspace();
 
   const int                  nb_vertices;                      /* number of vertices of the graph - see enum in Constants.hpp */
+        AlgorithmStepper*    animation;                        /* algorithm being animated, advanced by the render loop */
   const GRAPH_TYPE           type;                             /* defines the type of the graph (adjacency, list...) */
         bool                 arc_integer_capacities_defined;   /* defines if the graph's adges have capacities or not */
+  const std::atomic<bool>*   cancel_flag;                      /* if set, the algorithms stop as soon as it becomes true */
+        GRAPH_GENERATOR      generator;                        /* topology built by generate() - see enum in Constants.hpp */
         GraphRepresentation* graph_representation;             /* holds the vertices and edges of the graph */
         bool                 is_displayed;                     /* true is the graph is being displayed */
+        JobRunner*           job_runner;                       /* runs the algorithms on a worker thread */
+mutable KdTree*              kdtree;                           /* spatial index used to find the vertex closest to a point, built on first use */
         GRAPH_ORIENTATION    orientation;                      /* defines if the graph is oriented - see enum in Constants.hpp */
+        int                  picked_destination;               /* identifier of the destination picked with the mouse, -1 if none */
+        int                  picked_source;                    /* identifier of the source picked with the mouse, -1 if none */
+mutable QuadTree*            quadtree;                         /* spatial index used to draw only the visible part of the graph, built when drawing */
+        Philox               rng;                              /* random generator of the graph, copied with it so that a run can be reproduced */
+        AlgorithmStats       run_stats;                        /* counters of the last algorithm run */
+        int                  stats_depth;                      /* nesting level of the running algorithms, see StatsScope */
+        Viewport             viewport;                         /* area of the graph that is displayed */
         int                  window_id;                        /* if the graph is displayed, its window's id */
+  Algorithms::Workspace*     workspace;                        /* buffers of the searches, kept so that a query does not allocate once warmed up, built on first use */
 
 };
 
@@ -0,0 +1,102 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HilbertCurve_hpp
+#define HilbertCurve_hpp
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+#include "components/Vertex.hpp"
+
+/*
+Hilbert curve over the bounding box of a set of vertices, split in
+2^16 by 2^16 cells. Vertices close on the curve are close in the plane,
+so sorting vertices by their index gives them a good spatial locality.
+*/
+class HilbertCurve {
+
+    public:
+    
+        template<typename Iterator>
+        HilbertCurve(Iterator, Iterator);
+    
+        std::uint64_t index(const Vertex*) const;
+    
+    private:
+    
+ static std::uint64_t cell_index(std::uint32_t, std::uint32_t);
+    
+        double min_x;   /* left of the bounding box */
+        double min_y;   /* bottom of the bounding box */
+        double scale;   /* cells per unit of length */
+
+};
+
+/*
+Fits the curve to the bounding box of the vertices between first and
+last, which must not be empty.
+*/
+template<typename Iterator>
+HilbertCurve::HilbertCurve(Iterator first, Iterator last) :
+    min_x((*first)->getX()),
+    min_y((*first)->getY()),
+    scale(0) {
+    double max_x = min_x, max_y = min_y;
+    for(Iterator it=first ; it!=last ; ++it) {
+        min_x = std::min(min_x, (*it)->getX()); max_x = std::max(max_x, (*it)->getX());
+        min_y = std::min(min_y, (*it)->getY()); max_y = std::max(max_y, (*it)->getY());
+    }
+    double side = std::max(max_x-min_x, max_y-min_y);
+    scale       = side>0 ? 65535/side : 0;
+}
+
+/*
+Position of the cell of the vertex along the curve.
+*/
+inline std::uint64_t HilbertCurve::index(const Vertex* v) const {
+    std::uint32_t x = static_cast<std::uint32_t>((v->getX()-min_x)*scale);
+    std::uint32_t y = static_cast<std::uint32_t>((v->getY()-min_y)*scale);
+    return cell_index(x, y);
+}
+
+/*
+Position of the cell (x, y) along the curve.
+*/
+inline std::uint64_t HilbertCurve::cell_index(std::uint32_t x, std::uint32_t y) {
+    const std::uint32_t n     = 1u<<16;
+    std::uint64_t       index = 0;
+    for(std::uint32_t s=n/2 ; s>0 ; s/=2) {
+        std::uint32_t rx = (x&s)>0;
+        std::uint32_t ry = (y&s)>0;
+        index += std::uint64_t(s)*s*((3*rx)^ry);
+        if(ry==0) {
+            if(rx==1) { x = n-1-x; y = n-1-y; }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+#endif
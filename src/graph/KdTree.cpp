@@ -0,0 +1,152 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "KdTree.hpp"
+
+/*
+Coordinate of the vertex along the axis of the given depth.
+*/
+static double coordinate(const Vertex* v, int depth) {
+    return depth%2 ? v->getY() : v->getX();
+}
+
+/*
+Squared distance from a vertex to a point.
+*/
+static double squared_distance(const Vertex* v, double x, double y) {
+    return (v->getX()-x)*(v->getX()-x) + (v->getY()-y)*(v->getY()-y);
+}
+
+/*
+Builds the tree over the vertices' coordinates, in O(n log n).
+*/
+KdTree::KdTree(const std::vector<Vertex*>* graph_vertices) {
+    vertices.assign(graph_vertices->begin(), graph_vertices->end());
+    build(0, static_cast<int>(vertices.size()), 0);
+}
+
+/*
+Places the median of [begin, end) along the axis of the depth in the
+middle of the range, with the smaller vertices before it, and recurses
+on both halves.
+*/
+void KdTree::build(int begin, int end, int depth) {
+    if(end-begin<2) return;
+    int mid = begin+(end-begin)/2;
+    std::nth_element(vertices.begin()+begin, vertices.begin()+mid, vertices.begin()+end, [depth](const Vertex* v1, const Vertex* v2) {
+        return coordinate(v1, depth)<coordinate(v2, depth);
+    });
+    build(begin, mid, depth+1);
+    build(mid+1, end, depth+1);
+}
+
+/*
+Returns the vertex closest to (x, y), or 0 if the tree is empty.
+*/
+const Vertex* KdTree::nearest(double x, double y) const {
+    std::vector<Candidate> best;
+    search_nearest(x, y, 1, 0, static_cast<int>(vertices.size()), 0, &best);
+    return best.empty() ? 0 : best.front().second;
+}
+
+/*
+Finds the k vertices closest to (x, y), by increasing distance.
+*/
+void KdTree::nearest(double x, double y, int k, std::vector<const Vertex*>* result) const {
+    std::vector<Candidate> best;
+    if(k>0) search_nearest(x, y, k, 0, static_cast<int>(vertices.size()), 0, &best);
+    std::sort_heap(best.begin(), best.end());
+    for(const Candidate& c : best) result->push_back(c.second);
+}
+
+/*
+Finds the vertices at distance r or less from (x, y).
+*/
+void KdTree::radius(double x, double y, double r, std::vector<const Vertex*>* result) const {
+    search_radius(x, y, r, 0, static_cast<int>(vertices.size()), 0, result);
+}
+
+/*
+Finds the vertices inside the rectangle [min_x, max_x] x [min_y, max_y].
+*/
+void KdTree::range(double min_x, double min_y, double max_x, double max_y, std::vector<const Vertex*>* result) const {
+    search_range(min_x, min_y, max_x, max_y, 0, static_cast<int>(vertices.size()), 0, result);
+}
+
+/*
+Nearest neighbors search in [begin, end). The k best candidates are kept
+in a max-heap on the squared distance. The side of the node containing
+the point is searched first, the other side only if it can contain a
+better candidate than the worst one kept.
+*/
+void KdTree::search_nearest(double x, double y, int k, int begin, int end, int depth, std::vector<Candidate>* best) const {
+    if(begin>=end) return;
+    int           mid = begin+(end-begin)/2;
+    const Vertex* v   = vertices[mid];
+    double        d   = squared_distance(v, x, y);
+    if(static_cast<int>(best->size())<k) {
+        best->push_back(Candidate(d, v));
+        std::push_heap(best->begin(), best->end());
+    }
+    else if(d<best->front().first) {
+        std::pop_heap(best->begin(), best->end());
+        best->back() = Candidate(d, v);
+        std::push_heap(best->begin(), best->end());
+    }
+    double diff  = (depth%2 ? y : x) - coordinate(v, depth);
+    bool   left  = diff<0;
+    search_nearest(x, y, k, left ? begin : mid+1, left ? mid : end, depth+1, best);
+    if(static_cast<int>(best->size())<k || diff*diff<best->front().first) {
+        search_nearest(x, y, k, left ? mid+1 : begin, left ? end : mid, depth+1, best);
+    }
+}
+
+/*
+Radius search in [begin, end). A side of the node is skipped when the
+circle does not cross the splitting line towards it.
+*/
+void KdTree::search_radius(double x, double y, double r, int begin, int end, int depth, std::vector<const Vertex*>* result) const {
+    if(begin>=end) return;
+    int           mid  = begin+(end-begin)/2;
+    const Vertex* v    = vertices[mid];
+    double        diff = (depth%2 ? y : x) - coordinate(v, depth);
+    if(squared_distance(v, x, y)<=r*r) result->push_back(v);
+    if(diff-r<=0) search_radius(x, y, r, begin, mid, depth+1, result);
+    if(diff+r>=0) search_radius(x, y, r, mid+1, end, depth+1, result);
+}
+
+/*
+Rectangle search in [begin, end). A side of the node is skipped when the
+rectangle does not cross the splitting line towards it.
+*/
+void KdTree::search_range(double min_x, double min_y, double max_x, double max_y, int begin, int end, int depth, std::vector<const Vertex*>* result) const {
+    if(begin>=end) return;
+    int           mid = begin+(end-begin)/2;
+    const Vertex* v   = vertices[mid];
+    double        c   = coordinate(v, depth);
+    if(v->getX()>=min_x && v->getX()<=max_x && v->getY()>=min_y && v->getY()<=max_y) result->push_back(v);
+    if((depth%2 ? min_y : min_x)<=c) search_range(min_x, min_y, max_x, max_y, begin, mid, depth+1, result);
+    if((depth%2 ? max_y : max_x)>=c) search_range(min_x, min_y, max_x, max_y, mid+1, end, depth+1, result);
+}
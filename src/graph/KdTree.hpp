@@ -0,0 +1,65 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef KdTree_hpp
+#define KdTree_hpp
+
+#include <utility>
+#include <vector>
+
+#include "components/Vertex.hpp"
+
+/*
+Static 2-d tree over the vertices' coordinates. The tree is implicit:
+the vertices are sorted so that the median of each range [begin, end)
+is its node, with the left subtree before it and the right subtree
+after it. The depth of the node gives the splitting axis.
+*/
+class KdTree {
+
+    public:
+    
+        KdTree(const std::vector<Vertex*>*);
+        ~KdTree() {}
+    
+        int getNbVertices() const { return static_cast<int>(vertices.size()); }
+    
+        const Vertex* nearest(double, double)                                            const;
+        void          nearest(double, double, int, std::vector<const Vertex*>*)          const;
+        void          radius(double, double, double, std::vector<const Vertex*>*)        const;
+        void          range(double, double, double, double, std::vector<const Vertex*>*) const;
+    
+    private:
+    
+        typedef std::pair<double, const Vertex*> Candidate;
+    
+        void build(int, int, int);
+        void search_nearest(double, double, int, int, int, int, std::vector<Candidate>*)              const;
+        void search_radius(double, double, double, int, int, int, std::vector<const Vertex*>*)        const;
+        void search_range(double, double, double, double, int, int, int, std::vector<const Vertex*>*) const;
+    
+        std::vector<const Vertex*> vertices;   /* vertices in the order of the implicit tree */
+
+};
+
+#endif
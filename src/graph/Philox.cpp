@@ -0,0 +1,131 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Philox.hpp"
+
+/*
+Multipliers and key increments of Philox4x32.
+*/
+static const uint32_t PHILOX_M0 = 0xD2511F53;
+static const uint32_t PHILOX_M1 = 0xCD9E8D57;
+static const uint32_t PHILOX_W0 = 0x9E3779B9;
+static const uint32_t PHILOX_W1 = 0xBB67AE85;
+
+/*
+Mixing function of SplitMix64, used to derive the identifiers of the
+child streams.
+*/
+static uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x  = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x  = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/*
+Initializes the generator on the given seed and stream.
+*/
+Philox::Philox(uint64_t seed, uint64_t stream_id) :
+    seed(seed),
+    stream_id(stream_id),
+    counter(0),
+    children(0),
+    position(4) {
+}
+
+/*
+Computes the block of four words for a counter and a key, with ten
+rounds.
+*/
+void Philox::block(const uint32_t* counter, const uint32_t* key, uint32_t* output) {
+    uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    uint32_t k0 = key[0],     k1 = key[1];
+    for(int round=0 ; round<10 ; round++) {
+        uint64_t p0 = static_cast<uint64_t>(PHILOX_M0)*c0;
+        uint64_t p1 = static_cast<uint64_t>(PHILOX_M1)*c2;
+        c0 = static_cast<uint32_t>(p1>>32) ^ c1 ^ k0;
+        c1 = static_cast<uint32_t>(p1);
+        c2 = static_cast<uint32_t>(p0>>32) ^ c3 ^ k1;
+        c3 = static_cast<uint32_t>(p0);
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    output[0] = c0; output[1] = c1; output[2] = c2; output[3] = c3;
+}
+
+/*
+Returns the next 32 random bits.
+*/
+uint32_t Philox::next() {
+    if(position==4) {
+        uint32_t c[4] = {static_cast<uint32_t>(counter), static_cast<uint32_t>(counter>>32), static_cast<uint32_t>(stream_id), static_cast<uint32_t>(stream_id>>32)};
+        uint32_t k[2] = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed>>32)};
+        block(c, k, output);
+        counter++;
+        position = 0;
+    }
+    return output[position++];
+}
+
+/*
+Returns a new generator on a stream of its own, and advances this one
+so that the next split gives another stream.
+*/
+Philox Philox::split() {
+    return stream(children++);
+}
+
+/*
+Returns the generator of the i-th child stream. It only depends on the
+seed, the stream and i, so work split in fixed chunks gets the same
+numbers whatever the number of threads processing the chunks.
+*/
+Philox Philox::stream(uint64_t i) const {
+    return Philox(seed, mix(stream_id ^ mix(i)));
+}
+
+/*
+Returns a double uniformly distributed in [0, 1).
+*/
+double Philox::uniform() {
+    uint64_t high = next() >> 5;
+    uint64_t low  = next() >> 6;
+    return static_cast<double>((high << 26) | low) / 9007199254740992.0;
+}
+
+/*
+Returns an integer uniformly distributed in [0, n), without the bias of
+a modulo, with Lemire's multiply and reject method. n must be positive.
+*/
+uint32_t Philox::uniform_int(uint32_t n) {
+    uint64_t m         = static_cast<uint64_t>(next())*n;
+    uint32_t low       = static_cast<uint32_t>(m);
+    if(low<n) {
+        uint32_t threshold = (0u-n) % n;
+        while(low<threshold) {
+            m   = static_cast<uint64_t>(next())*n;
+            low = static_cast<uint32_t>(m);
+        }
+    }
+    return static_cast<uint32_t>(m>>32);
+}
@@ -0,0 +1,64 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef Philox_hpp
+#define Philox_hpp
+
+#include <cstdint>
+
+/*
+Counter-based random number generator, Philox4x32-10 (Salmon et al.,
+"Parallel random numbers: as easy as 1, 2, 3"). The output is a pure
+function of the key (the seed), the stream and the index of the block,
+so a generator can be copied or split without sharing any state.
+*/
+class Philox {
+
+    public:
+    
+        Philox(uint64_t=0, uint64_t=0);
+        ~Philox() {}
+    
+        uint64_t getSeed()   const { return seed; }
+        uint64_t getStream() const { return stream_id; }
+    
+        uint32_t next();
+        Philox   split();
+        Philox   stream(uint64_t) const;
+        double   uniform();
+        uint32_t uniform_int(uint32_t);
+    
+ static void     block(const uint32_t*, const uint32_t*, uint32_t*);
+    
+    private:
+    
+        uint64_t seed;          /* key of the generator */
+        uint64_t stream_id;     /* stream of the generator, stored in the two high words of the counter */
+        uint64_t counter;       /* index of the next block, stored in the two low words of the counter */
+        uint64_t children;      /* number of streams split from this one */
+        uint32_t output[4];     /* last generated block */
+        int      position;      /* next word of output to return, 4 if a new block is needed */
+
+};
+
+#endif
@@ -0,0 +1,125 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef RadixHeap_hpp
+#define RadixHeap_hpp
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+Maps the non-negative keys of type K to unsigned integers in the same
+order: integers are used as they are, and the bits of a non-negative
+IEEE double, read as an integer, grow with the double.
+*/
+template<typename K, bool = std::is_floating_point<K>::value>
+struct RadixKey {
+    static std::uint64_t encode(K k)             { return static_cast<std::uint64_t>(k); }
+    static K             decode(std::uint64_t u) { return static_cast<K>(u); }
+};
+
+template<typename K>
+struct RadixKey<K, true> {
+    static std::uint64_t encode(K k)             { double d = k; std::uint64_t u; std::memcpy(&u, &d, sizeof(u)); return u; }
+    static K             decode(std::uint64_t u) { double d; std::memcpy(&d, &u, sizeof(d)); return static_cast<K>(d); }
+};
+
+/*
+Monotone priority queue: the keys pushed must not be smaller than the
+last key popped, which holds for the distances of Dijkstra's algorithm.
+Bucket i holds the keys whose highest bit differing from the last
+popped key is bit i-1, bucket 0 the keys equal to it. Popping from an
+empty bucket 0 redistributes the first non-empty bucket around its
+minimum, and every key moves to a lower bucket each time it is moved,
+so that a push and a pop cost O(log C) amortized, C the largest key.
+*/
+template<typename K, typename T>
+class RadixHeap {
+
+    public:
+    
+        RadixHeap() : buckets(65), last(0), size(0) {}
+    
+        bool        empty()   const { return size==0; }
+        std::size_t getSize() const { return size; }
+    
+        void            clear();
+        std::pair<K, T> pop();
+        void            push(K, const T&);
+    
+    private:
+    
+        typedef std::pair<std::uint64_t, T> Entry;
+    
+        static int bucket(std::uint64_t key, std::uint64_t last) { return key==last ? 0 : 64-__builtin_clzll(key^last); }
+    
+        std::vector<std::vector<Entry>> buckets;   /* entries by highest bit differing from last */
+        std::uint64_t                   last;      /* encoded key of the last popped entry */
+        std::size_t                     size;      /* number of entries */
+
+};
+
+/*
+Removes all the entries. The buckets keep their capacity, so that a
+heap reused for searches of the same size does not allocate again.
+*/
+template<typename K, typename T>
+void RadixHeap<K, T>::clear() {
+    for(std::vector<Entry>& b : buckets) b.clear();
+    last = 0;
+    size = 0;
+}
+
+/*
+Removes and returns an entry of minimum key. The heap must not be empty.
+*/
+template<typename K, typename T>
+std::pair<K, T> RadixHeap<K, T>::pop() {
+    if(buckets[0].empty()) {
+        std::size_t i = 1;
+        while(buckets[i].empty()) i++;
+        last = buckets[i][0].first;
+        for(const Entry& e : buckets[i]) if(e.first<last) last = e.first;
+        for(const Entry& e : buckets[i]) buckets[bucket(e.first, last)].push_back(e);
+        buckets[i].clear();
+    }
+    Entry e = buckets[0].back();
+    buckets[0].pop_back();
+    size--;
+    return std::make_pair(RadixKey<K>::decode(e.first), e.second);
+}
+
+/*
+Adds an entry, whose key is not smaller than the last popped one.
+*/
+template<typename K, typename T>
+void RadixHeap<K, T>::push(K key, const T& value) {
+    std::uint64_t k = RadixKey<K>::encode(key);
+    buckets[bucket(k, last)].push_back(Entry(k, value));
+    size++;
+}
+
+#endif
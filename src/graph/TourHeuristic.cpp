@@ -0,0 +1,241 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "HilbertCurve.hpp"
+#include "TourHeuristic.hpp"
+
+/*
+Prepares the heuristic on the given cost matrix and stops, the source
+being the first one.
+*/
+TourHeuristic::TourHeuristic(double** cost_matrix, const std::vector<const Vertex*>& stops, const std::atomic<bool>* cancel_flag) :
+    cancel_flag(cancel_flag),
+    cost_matrix(cost_matrix),
+    nb_moves(0),
+    size(static_cast<int>(stops.size())),
+    stops(stops) {
+}
+
+/*
+Builds a tour and improves it until no move makes it cheaper. Writes the
+stops in the order of the tour, starting with the source. Returns false
+if the search was cancelled.
+*/
+bool TourHeuristic::run(TSP_SOLVER solver, std::vector<int>* result) {
+    nb_moves = 0;
+    if(solver==TSP_SPACE_FILLING_CURVE) space_filling_curve();
+    else                                nearest_neighbor();
+    position.assign(size, 0);
+    for(int i=0 ; i<size ; i++) position[tour[i]] = i;
+    active.assign(size, 0);
+    queue.clear();
+    if(size>=4) {
+        make_candidates();
+        for(int a : tour) activate(a);
+    }
+    while(!queue.empty() && !cancelled()) {
+        int a = queue.front();
+        queue.pop_front();
+        active[a] = 0;
+        if(improve_2opt(a) || improve_or_opt(a)) nb_moves++;
+    }
+    result->clear();
+    for(int i=0 ; i<size ; i++) result->push_back(tour[(position[0]+i)%size]);
+    return !cancelled();
+}
+
+/*
+Puts the stop back in the queue, if it is not already in it.
+*/
+void TourHeuristic::activate(int a) {
+    if(active[a]) return;
+    active[a] = 1;
+    queue.push_back(a);
+}
+
+/*
+Tries to replace an edge of a in the tour, (a, b), and the edge (c, d)
+with (a, c) and (b, d), c being one of the closest stops of a. Applies
+the first move that makes the tour cheaper.
+*/
+bool TourHeuristic::improve_2opt(int a) {
+    for(int forward=1 ; forward>=0 ; forward--) {
+        int    b  = forward ? next(a) : previous(a);
+        double ab = cost(a, b);
+        for(int c : candidates[a]) {
+            double gain = ab-cost(a, c);
+            if(gain<=0) break;
+            int d = forward ? next(c) : previous(c);
+            if(c==b || d==a) continue;
+            gain += cost(c, d)-cost(b, d);
+            if(gain>Constants::TSP_MIN_GAIN) {
+                if(forward) reverse(position[b], position[c]);
+                else        reverse(position[c], position[b]);
+                activate(a);
+                activate(b);
+                activate(c);
+                activate(d);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*
+Tries to move a segment of a few stops starting or ending with a between
+two other stops, one of them being among the closest stops of an end of
+the segment. The segment may be reversed. Applies the first move that
+makes the tour cheaper.
+*/
+bool TourHeuristic::improve_or_opt(int a) {
+    int max_length = std::min(Constants::TSP_OR_OPT_LENGTH, size-3);
+    for(int length=1 ; length<=max_length ; length++) {
+        for(int starts=1 ; starts>=0 ; starts--) {
+            int s1 = a;
+            int s2 = a;
+            for(int i=1 ; i<length ; i++) {
+                if(starts) s2 = next(s2);
+                else       s1 = previous(s1);
+            }
+            int    p       = previous(s1);
+            int    n       = next(s2);
+            double removed = cost(p, s1)+cost(s2, n)-cost(p, n);
+            if(removed<=Constants::TSP_MIN_GAIN) continue;
+            auto in_segment = [&](int c) { return (position[c]-position[s1]+size)%size<length; };
+            for(int s : {s1, s2}) {
+                for(int c : candidates[s]) {
+                    if(cost(s, c)>=removed) break;
+                    if(in_segment(c)) continue;
+                    for(int after=1 ; after>=0 ; after--) {
+                        /* the segment goes between x and y, next to c */
+                        int x = after ? c       : previous(c);
+                        int y = after ? next(c) : c;
+                        if(in_segment(x) || in_segment(y)) continue;
+                        bool   reversed = after ? s==s2 : s==s1;
+                        double added    = (reversed ? cost(x, s2)+cost(s1, y) : cost(x, s1)+cost(s2, y))-cost(x, y);
+                        if(removed-added>Constants::TSP_MIN_GAIN) {
+                            move_segment(s1, length, x, reversed);
+                            for(int e : {p, n, s1, s2, x, y}) activate(e);
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/*
+Lists the closest stops of each stop, by cost.
+*/
+void TourHeuristic::make_candidates() {
+    int              k = std::min(Constants::TSP_NEIGHBORS, size-1);
+    std::vector<int> others;
+    candidates.assign(size, std::vector<int>());
+    for(int a=0 ; a<size ; a++) {
+        others.clear();
+        for(int b=0 ; b<size ; b++) if(b!=a) others.push_back(b);
+        std::partial_sort(others.begin(), others.begin()+k, others.end(), [&](int b, int c) {
+            return cost(a, b)<cost(a, c) || (cost(a, b)==cost(a, c) && b<c);
+        });
+        candidates[a].assign(others.begin(), others.begin()+k);
+    }
+}
+
+/*
+Moves the segment of the given length starting with s1 between x and the
+stop after it, reversed or not.
+*/
+void TourHeuristic::move_segment(int s1, int length, int x, bool reversed) {
+    std::vector<int> segment;
+    std::vector<int> moved;
+    int              start = position[s1];
+    for(int i=0 ; i<length ; i++) segment.push_back(tour[(start+i)%size]);
+    if(reversed) std::reverse(segment.begin(), segment.end());
+    moved.reserve(size);
+    for(int i=length ; i<size ; i++) {
+        int s = tour[(start+i)%size];
+        moved.push_back(s);
+        if(s==x) moved.insert(moved.end(), segment.begin(), segment.end());
+    }
+    tour.swap(moved);
+    for(int i=0 ; i<size ; i++) position[tour[i]] = i;
+}
+
+/*
+Builds the tour by going from the source to the closest stop left, until
+all the stops are visited.
+*/
+void TourHeuristic::nearest_neighbor() {
+    std::vector<char> visited(size, 0);
+    tour.assign(1, 0);
+    visited[0] = 1;
+    for(int i=1 ; i<size ; i++) {
+        int last = tour.back();
+        int best = -1;
+        for(int s=1 ; s<size ; s++) {
+            if(!visited[s] && (best<0 || cost(last, s)<cost(last, best))) best = s;
+        }
+        visited[best] = 1;
+        tour.push_back(best);
+    }
+}
+
+/*
+Reverses the part of the tour between the positions i and j, both
+included, going forward from i. The rest of the tour is reversed
+instead when it is shorter, which gives the same edges.
+*/
+void TourHeuristic::reverse(int i, int j) {
+    int length = (j-i+size)%size+1;
+    if(2*length>size) {
+        int first = (j+1)%size;
+        j      = (i+size-1)%size;
+        i      = first;
+        length = size-length;
+    }
+    for(int k=0 ; k<length/2 ; k++) {
+        int p = (i+k)%size;
+        int q = (j-k+size)%size;
+        std::swap(tour[p], tour[q]);
+        position[tour[p]] = p;
+        position[tour[q]] = q;
+    }
+}
+
+/*
+Builds the tour by visiting the stops in the order of a Hilbert curve
+over the bounding box of their coordinates.
+*/
+void TourHeuristic::space_filling_curve() {
+    HilbertCurve                               curve(stops.begin(), stops.end());
+    std::vector<std::pair<std::uint64_t, int>> keys;
+    for(int s=0 ; s<size ; s++) keys.push_back(std::make_pair(curve.index(stops[s]), s));
+    std::sort(keys.begin(), keys.end());
+    tour.clear();
+    for(const std::pair<std::uint64_t, int>& k : keys) tour.push_back(k.second);
+}
@@ -0,0 +1,82 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TourHeuristic_hpp
+#define TourHeuristic_hpp
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "components/Vertex.hpp"
+#include "constants/Constants.hpp"
+
+/*
+Heuristic for the Traveling Salesman problem, for routes with too many
+stops for the exact search. Stop 0 is the source, and the cost between
+two stops is given by a symmetric matrix. A first tour is built by going
+to the nearest stop left, or by following a space-filling curve over
+the coordinates of the stops. It is then improved with 2-opt and Or-opt
+moves, only tried towards the closest stops. A stop is looked at again
+only when one of its edges in the tour changed (don't-look bits).
+*/
+class TourHeuristic {
+
+    public:
+    
+        TourHeuristic(double**, const std::vector<const Vertex*>&, const std::atomic<bool>*);
+    
+        unsigned long getNbMoves() const { return nb_moves; }
+    
+        bool run(TSP_SOLVER, std::vector<int>*);
+    
+    private:
+    
+        void   activate(int);
+        bool   cancelled()          const { return cancel_flag && *cancel_flag; }
+        double cost(int a, int b)   const { return cost_matrix[a][b]; }
+        bool   improve_2opt(int);
+        bool   improve_or_opt(int);
+        void   make_candidates();
+        void   move_segment(int, int, int, bool);
+        void   nearest_neighbor();
+        int    next(int a)          const { return tour[(position[a]+1)%size]; }
+        int    previous(int a)      const { return tour[(position[a]+size-1)%size]; }
+        void   reverse(int, int);
+        void   space_filling_curve();
+    
+        std::vector<char>             active;        /* true if the stop is in the queue, false if its don't-look bit is set */
+        std::vector<std::vector<int>> candidates;    /* closest stops of each stop, the closest first */
+  const std::atomic<bool>*            cancel_flag;   /* set to stop the search, may be null */
+        double**                      cost_matrix;   /* cost of the route between two stops */
+        unsigned long                 nb_moves;      /* moves applied by the last run */
+        std::vector<int>              position;      /* position of each stop in the tour */
+        std::deque<int>               queue;         /* stops to look at */
+        int                           size;          /* number of stops, the source included */
+  const std::vector<const Vertex*>&   stops;         /* vertex of each stop */
+        std::vector<int>              tour;          /* stops in the order of the tour */
+
+};
+
+#endif
@@ -22,206 +22,209 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <mutex>
 #include <numeric>
-#include <queue>
 #include <set>
 
+#include "algorithms.hpp"
+#include "concurrency/ThreadPool.hpp"
 #include "Graph.hpp"
+#include "graph_representation/GraphRepresentationAdjacencyMatrix.hpp"
+#include "graph_representation/GraphRepresentationBitMatrix.hpp"
+#include "stats/Trace.hpp"
+#include "TourHeuristic.hpp"
 
 /*
-A* algorithm. While there is an unvisited vertex, select the one with
-minimum cost and study its neighbors. Stops when the current vertex
-is the destination. A* is more efficient that Dijkstra thanks to how
-it finds the vertex with minimum cost. Instead of just looking at the
-cost of the vertex, it also takes into account the minimal remaining
-cost to go to the destination. This value is the euclidian distance.
+Runs the algorithm Kernel instantiated for the concrete representation
+and the orientation of the graph, see graph/algorithms.hpp.
 */
-std::vector<const Edge*>* Graph::algo_astar(const Vertex* source, const Vertex* destination, bool print_path) {
-    unsigned int                           inf_unsigned = -1; inf_unsigned /= 2;
-    int                                    inf_signed   = inf_unsigned;
-    bool                                   path_found   = false;
-    std::map<const Vertex*, double>        costs;
-    std::map<const Vertex*, const Vertex*> previous;
-    std::set<const Vertex*>                search;
-    std::set<const Vertex*>                visited;
-    /* initialization */
-    for(const Vertex* v : *graph_representation->getVertices()) {
-        costs[v]    = inf_signed;
-        previous[v] = 0;
+template<template<typename, typename> class Kernel, typename... Args>
+static typename Kernel<GraphRepresentationAdjacencyMatrix, Algorithms::NoOrientation>::result_type run_kernel(GRAPH_TYPE type, GRAPH_ORIENTATION orientation, GraphRepresentation* graph_representation, Args... args) {
+    switch(type) {
+        case ADJACENCY_BIT_MATRIX : return Algorithms::run_oriented<Kernel>(orientation, *static_cast<GraphRepresentationBitMatrix*>(graph_representation), args...);
+        case ADJACENCY_MATRIX     :
+        default                   : return Algorithms::run_oriented<Kernel>(orientation, *static_cast<GraphRepresentationAdjacencyMatrix*>(graph_representation), args...);
     }
-    costs[source] = 0;
-    search.insert(source);
-    while(!search.empty()) {
-        /* finds the best potential vertex and extracts it from the list - updated search compared to Dijkstra */
-        std::set<const Vertex*>::iterator it_min;
-        it_min = std::min_element(search.begin(), search.end(), [&](const Vertex* v1, const Vertex* v2) {
-            return costs[v1]+v1->distanceTo(destination)<costs[v2]+v2->distanceTo(destination);
-        });
-        const Vertex* v_min = *it_min;
-        search.erase(it_min);
-        visited.insert(v_min);
-        /* stop if destination is found */
-        if(v_min==destination) {
-            path_found = true;
-            break;
-        }
-        /* same treatment for all neighbors */
-        std::vector<Vertex*> neighbors = orientation==ONE_WAY ? graph_representation->get_direct_neighbors(v_min, orientation) : graph_representation->get_all_neighbors(v_min);
-        for(const Vertex* v : neighbors) {
-            if(!visited.count(v)) {
-                search.insert(v);
-                if(print_path) const_cast<Vertex*>(v)->setColor(Constants::VERTEX_VISITED_COLOR_R, Constants::VERTEX_VISITED_COLOR_G, Constants::VERTEX_VISITED_COLOR_B);
-                double diff = costs[v_min] + v_min->distanceTo(v);
-                if(diff<costs[v]) {
-                    costs[v]    = diff;
-                    previous[v] = v_min;
-                }
-            }
+}
+
+/*
+Runs the algorithm Kernel as run_kernel() does, with a visitor that
+colors the run on the representation if render is true, and with one
+that ignores it otherwise, so that the batch runs write no color.
+*/
+template<template<typename, typename> class Kernel, typename... Args>
+static typename Kernel<GraphRepresentationAdjacencyMatrix, Algorithms::NoOrientation>::result_type run_visited(bool render, const Vertex* source, const Vertex* destination, GRAPH_TYPE type, GRAPH_ORIENTATION orientation, GraphRepresentation* graph_representation, const Algorithms::Context& ctx, Args... args) {
+    if(render) return run_kernel<Kernel>(type, orientation, graph_representation, ctx, Algorithms::RenderVisitor(graph_representation, source, destination), args...);
+    else       return run_kernel<Kernel>(type, orientation, graph_representation, ctx, Algorithms::NoVisitor(), args...);
+}
+
+/*
+State of the branch and bound search of the Traveling Salesman problem,
+shared by its tasks. Vertex 0 is the source and vertex i is destination
+i-1. The cost of the best trip is published atomically so that all the
+tasks prune against it, the trip itself is written under the lock.
+*/
+struct TravelingSalesmanSearch {
+    std::vector<int>         best_path;     /* destinations of the best trip, in order */
+    int                      best_task;     /* task that found the best trip */
+    const std::atomic<bool>* cancel_flag;   /* set to stop the search, may be null */
+    double**                 cost_matrix;   /* cost of the route between two vertices */
+    std::atomic<double>      min_cost;      /* cost of the best trip */
+    std::mutex               mutex;         /* protects best_path and best_task */
+    int                      size;          /* number of vertices, the source included */
+};
+
+/*
+First destinations of a path, and their cost.
+*/
+typedef std::pair<std::vector<int>, double> Prefix;
+
+/*
+True if a path of the given cost, explored by the given task, can lead
+to the trip the sequential search keeps: the first one it finds among
+the cheapest. The tasks are numbered in the order the sequential search
+explores their paths, so an earlier task wins on equal costs.
+*/
+static bool traveling_salesman_promising(TravelingSalesmanSearch* search, int task, double cost) {
+    double min_cost = search->min_cost.load(std::memory_order_relaxed);
+    if(cost!=min_cost) return cost<min_cost;
+    std::lock_guard<std::mutex> lock(search->mutex);
+    return task<search->best_task;
+}
+
+/*
+True if every vertex of the cost matrix can reach every other one. A
+trip through all of them only exists in this case.
+*/
+static bool traveling_salesman_reachable(double** cost_matrix, int size) {
+    for(int i=0 ; i<size ; i++) {
+        for(int j=0 ; j<size ; j++) {
+            if(std::isinf(cost_matrix[i][j])) return false;
         }
     }
-    /* prints the path */
-    if(path_found) {
-        const Vertex* v = destination;
-        std::vector<const Edge*>* path = new std::vector<const Edge*>;
-        while(v!=source) {
-            Edge* e = graph_representation->get_edge_from_to(v, previous[v]);
-            if(print_path) e->setColor(Constants::EDGE_ALGO_RESULT_COLOR_R, Constants::EDGE_ALGO_RESULT_COLOR_G, Constants::EDGE_ALGO_RESULT_COLOR_B);
-            path->push_back(e);
-            v = previous[v];
-            if(print_path) const_cast<Vertex *>(v)->setColor(Constants::VERTEX_PATH_COLOR_R, Constants::VERTEX_PATH_COLOR_G, Constants::VERTEX_PATH_COLOR_B);
-        }
-        if(print_path) {
-            const_cast<Vertex*>(destination)->setColor(Constants::EDGE_ALGO_DESTINATION_COLOR_R, Constants::EDGE_ALGO_DESTINATION_COLOR_G, Constants::EDGE_ALGO_DESTINATION_COLOR_B);
-            const_cast<Vertex*>(source)->setColor(Constants::EDGE_ALGO_SOURCE_COLOR_R, Constants::EDGE_ALGO_SOURCE_COLOR_G, Constants::EDGE_ALGO_SOURCE_COLOR_B);
+    return true;
+}
+
+/*
+Lists the paths of the given number of destinations, in the order the
+sequential search explores them.
+*/
+static void traveling_salesman_prefixes(TravelingSalesmanSearch* search, int depth, std::vector<int>* path, std::vector<char>* visited, double cost, std::vector<Prefix>* prefixes) {
+    if(static_cast<int>(path->size())==depth) {
+        prefixes->push_back(Prefix(*path, cost));
+        return;
+    }
+    int last = path->empty() ? 0 : path->back();
+    for(int d=1 ; d<search->size ; d++) {
+        if((*visited)[d]) continue;
+        path->push_back(d);
+        (*visited)[d] = 1;
+        traveling_salesman_prefixes(search, depth, path, visited, cost+search->cost_matrix[last][d], prefixes);
+        (*visited)[d] = 0;
+        path->pop_back();
+    }
+}
+
+/*
+Branch and bound search of the Traveling Salesman problem, from a path
+given by a task. A path is only extended while it is cheaper than the
+best trip found by all the tasks.
+*/
+static void traveling_salesman_search(TravelingSalesmanSearch* search, int task, std::vector<int>* path, std::vector<char>* visited, double cost, unsigned long* nodes) {
+    if(search->cancel_flag && *search->cancel_flag) return;
+    (*nodes)++;
+    int last = path->empty() ? 0 : path->back();
+    if(static_cast<int>(path->size())==search->size-1) {
+        if(!path->empty()) cost += search->cost_matrix[last][0];
+        if(!traveling_salesman_promising(search, task, cost)) return;
+        std::lock_guard<std::mutex> lock(search->mutex);
+        if(cost<search->min_cost || (cost==search->min_cost && task<search->best_task)) {
+            search->min_cost  = cost;
+            search->best_path = *path;
+            search->best_task = task;
         }
-        return path;
+        return;
     }
-    else {
-        return 0;
+    for(int d=1 ; d<search->size ; d++) {
+        if((*visited)[d]) continue;
+        double next = cost+search->cost_matrix[last][d];
+        path->push_back(d);
+        (*visited)[d] = 1;
+        if(traveling_salesman_promising(search, task, next)) traveling_salesman_search(search, task, path, visited, next, nodes);
+        (*visited)[d] = 0;
+        path->pop_back();
     }
 }
 
+/*
+A* algorithm. While there is an unvisited vertex, select the one with
+minimum cost and study its neighbors. Stops when the current vertex
+is the destination. A* is more efficient that Dijkstra thanks to how
+it finds the vertex with minimum cost. Instead of just looking at the
+cost of the vertex, it also takes into account the minimal remaining
+cost to go to the destination. This value is the euclidian distance.
+The visited vertices and the path are colored if render is true.
+*/
+std::vector<const Edge*>* Graph::algo_astar(const Vertex* source, const Vertex* destination, bool render) {
+    TRACE_SCOPE("Graph::algo_astar");
+    STATS_SCOPE(run_stats, stats_depth, "astar");
+    return run_visited<Algorithms::AStar>(render, source, destination, type, orientation, graph_representation, Algorithms::Context(run_stats, cancel_flag, search_workspace()), source, destination);
+}
+
+/*
+Breadth-first search. Returns the number of hops from the source to
+every vertex, by identifier, or -1 if it cannot be reached. If there is
+a destination, the search stops once its level is over, and the farther
+vertices are left at -1. The levels are explored in parallel. The
+reached vertices and the path are colored if render is true.
+*/
+std::vector<int>* Graph::algo_bfs(const Vertex* source, const Vertex* destination, bool render) {
+    TRACE_SCOPE("Graph::algo_bfs");
+    STATS_SCOPE(run_stats, stats_depth, "bfs");
+    return run_visited<Algorithms::Bfs>(render, source, destination, type, orientation, graph_representation, Algorithms::Context(run_stats, cancel_flag), source, destination);
+}
+
 /*
 Bron-Kerbosch algorithm. Returns only the first found biggest clique.
+The orientation of the graph is ignored. The clique is colored if
+render is true.
 */
-std::set<const Vertex*>* Graph::algo_bron_kerbosch() {
-    std::vector<std::set<const Vertex*>> cliques;
-    std::set<const Vertex*>*             max_clique = new std::set<const Vertex*>;
-    std::set<const Vertex*>              R;
-    std::set<const Vertex*>              X;
-    std::set<const Vertex*>              P;
-    for(const Vertex* v : *graph_representation->getVertices()) P.insert(v);
-    algo_bron_kerbosch_callback(&cliques, R, P, X);
-    /* finds the first biggest clique */
-    std::vector<std::set<const Vertex*>>::iterator max_clique_it = std::max_element(cliques.begin(), cliques.end(), [&](std::set<const Vertex*> s1, std::set<const Vertex*> s2) {
-        return s1.size() < s2.size();
-    });
-    for(const Vertex* v : *max_clique_it) max_clique->insert(v);
-    /* prints the clique */
-    for(const Vertex* v : *max_clique) {
-        const_cast<Vertex *>(v)->setColor(Constants::VERTEX_PATH_COLOR_R, Constants::VERTEX_PATH_COLOR_G, Constants::VERTEX_PATH_COLOR_B);
-    }
-    return max_clique;
+std::set<const Vertex*>* Graph::algo_bron_kerbosch(bool render) {
+    TRACE_SCOPE("Graph::algo_bron_kerbosch");
+    STATS_SCOPE(run_stats, stats_depth, "bron-kerbosch");
+    return run_visited<Algorithms::BronKerbosch>(render, 0, 0, type, NONE, graph_representation, Algorithms::Context(run_stats, cancel_flag));
 }
 
 /*
-Bron-Kerbosch callback method.
+Delta-stepping algorithm. Computes the length of the shortest path from
+the source to every vertex, and the vertex before it on this path, both
+by identifier of the vertex. The distances are the ones Dijkstra finds,
+and infinity for the vertices that cannot be reached. The vertices are
+processed in parallel, in buckets of distance. Returns false if the run
+was cancelled.
 */
-bool Graph::algo_bron_kerbosch_callback(std::vector<std::set<const Vertex*>>* cliques, std::set<const Vertex*> R, std::set<const Vertex*> P, std::set<const Vertex*> X) {
-    if(P.empty() && X.empty()) {
-        cliques->push_back(R);
-    }
-    while(!P.empty()) {
-        const Vertex* v = *(P.begin());
-        R.insert(v);
-        std::set<Vertex*>       neighbors = graph_representation->get_all_neighbors_set(v);
-        std::set<const Vertex*> P_and_n;
-        std::set<const Vertex*> X_and_n;
-        for(const Vertex* n : neighbors) {
-            if(P.count(n)) P_and_n.insert(n);
-            if(X.count(n)) X_and_n.insert(n);
-        }
-        if(algo_bron_kerbosch_callback(cliques, R, P_and_n, X_and_n)) {
-            return true;
-        }
-        else {
-            R.erase(v);
-            P.erase(v);
-            X.insert(v);
-        }
-    }
-    return false;
+bool Graph::algo_delta_stepping(const Vertex* source, std::vector<double>* distances, std::vector<int>* predecessors) {
+    TRACE_SCOPE("Graph::algo_delta_stepping");
+    STATS_SCOPE(run_stats, stats_depth, "delta-stepping");
+    return run_kernel<Algorithms::DeltaStepping>(type, orientation, graph_representation, Algorithms::Context(run_stats, cancel_flag), source, distances, predecessors);
 }
 
 /*
 Dijkstra algorithm. While there is an unvisited vertex, select the one
 with minimum cost and study its neighbors. Stops when the current vertex
-is the destination.
+is the destination. The visited vertices and the path are colored if
+render is true.
 */
-std::vector<const Edge*>* Graph::algo_dijkstra(const Vertex* source, const Vertex* destination) {
-    unsigned int                           inf_unsigned = -1; inf_unsigned /= 2;
-    int                                    inf_signed   = inf_unsigned;
-    bool                                   path_found   = false;
-    std::map<const Vertex*, double>        costs;
-    std::map<const Vertex*, const Vertex*> previous;
-    std::set<const Vertex*>                search;
-    std::set<const Vertex*>                visited;
-    /* initialization */
-    for(const Vertex* v : *graph_representation->getVertices()) {
-        costs[v]    = inf_signed;
-        previous[v] = 0;
-    }
-    costs[source] = 0;
-    search.insert(source);
-    while(!search.empty()) {
-        /* finds the best potential vertex and extracts it from the list */
-        std::set<const Vertex*>::iterator it_min;
-        it_min = std::min_element(search.begin(), search.end(), [&](const Vertex* v1, const Vertex* v2) {
-            return costs[v1]<costs[v2];
-        });
-        const Vertex* v_min = *it_min;
-        search.erase(it_min);
-        visited.insert(v_min);
-        /* stop if destination is found */
-        if(v_min==destination) {
-            path_found = true;
-            break;
-        }
-        /* same treatment for all neighbors */
-        std::vector<Vertex*> neighbors = orientation==ONE_WAY ? graph_representation->get_direct_neighbors(v_min, orientation) : graph_representation->get_all_neighbors(v_min);
-        for(const Vertex* v : neighbors) {
-            if(!visited.count(v)) {
-                search.insert(v);
-                const_cast<Vertex*>(v)->setColor(Constants::VERTEX_VISITED_COLOR_R, Constants::VERTEX_VISITED_COLOR_G, Constants::VERTEX_VISITED_COLOR_B);
-                double diff = costs[v_min] + v_min->distanceTo(v);
-                if(diff<costs[v]) {
-                    costs[v]    = diff;
-                    previous[v] = v_min;
-                }
-            }
-        }
-    }
-    /* prints the path */
-    const_cast<Vertex*>(destination)->setColor(Constants::EDGE_ALGO_DESTINATION_COLOR_R, Constants::EDGE_ALGO_DESTINATION_COLOR_G, Constants::EDGE_ALGO_DESTINATION_COLOR_B);
-    if(path_found) {
-        const Vertex* v = destination;
-        std::vector<const Edge*>* path = new std::vector<const Edge*>;
-        while(v!=source) {
-            Edge* e = graph_representation->get_edge_from_to(v, previous[v]);
-            e->setColor(Constants::EDGE_ALGO_RESULT_COLOR_R, Constants::EDGE_ALGO_RESULT_COLOR_G, Constants::EDGE_ALGO_RESULT_COLOR_B);
-            path->push_back(e);
-            v = previous[v];
-            const_cast<Vertex *>(v)->setColor(Constants::VERTEX_PATH_COLOR_R, Constants::VERTEX_PATH_COLOR_G, Constants::VERTEX_PATH_COLOR_B);
-        }
-        const_cast<Vertex*>(destination)->setColor(Constants::EDGE_ALGO_DESTINATION_COLOR_R, Constants::EDGE_ALGO_DESTINATION_COLOR_G, Constants::EDGE_ALGO_DESTINATION_COLOR_B);
-        const_cast<Vertex*>(source)->setColor(Constants::EDGE_ALGO_SOURCE_COLOR_R, Constants::EDGE_ALGO_SOURCE_COLOR_G, Constants::EDGE_ALGO_SOURCE_COLOR_B);
-        return path;
-    }
-    else {
-        return 0;
-    }
+std::vector<const Edge*>* Graph::algo_dijkstra(const Vertex* source, const Vertex* destination, bool render) {
+    TRACE_SCOPE("Graph::algo_dijkstra");
+    STATS_SCOPE(run_stats, stats_depth, "dijkstra");
+    return run_visited<Algorithms::Dijkstra>(render, source, destination, type, orientation, graph_representation, Algorithms::Context(run_stats, cancel_flag, search_workspace()), source, destination);
 }
 
 /*
@@ -229,280 +232,187 @@ Edmonds Karp algorithm. While there is a path from source to sink, find
 the smallest capacity of the path, add it to the max_flow and to every
 reverse edge of the path, and remove it from every edge in the path. When
 no more path is found, max_flow has the maximum flow and is returned.
+The edges of the augmenting paths are colored if render is true.
 */
-int Graph::algo_edmonds_karp(const Vertex* source, const Vertex* sink) {
-    int    max_flow          = 0;
-    Graph* residual_graph    = new Graph(type, nb_vertices);
-    *residual_graph          = *this;
-    const Vertex* res_source = residual_graph->graph_representation->getVertices()->at(source->getId());
-    const Vertex* res_sink   = residual_graph->graph_representation->getVertices()->at(sink->getId());
-    /* While there is a path from source to sink */
-    bool valid_path = true;
-    do {
-        // finds a shortest path with positive capacity
-        std::map<const Vertex*, double>        path_capacity;
-        std::map<const Vertex*, const Vertex*> parents;
-        valid_path = algo_edmonds_karp_bfs(residual_graph, &path_capacity, &parents, res_source, res_sink);
-        if(valid_path) {
-            /* adds the path capacity to the max flow */
-            double flow = path_capacity[res_sink];
-            max_flow += flow;
-            /* updates the capacities */
-            const Vertex* v = res_sink;
-            while(v!=res_source) {
-                const Vertex* p = parents[v];
-                graph_representation->get_edge_from_to(v->getId(), p->getId())->setColor(Constants::EDGE_ALGO_RESULT_COLOR_R, Constants::EDGE_ALGO_RESULT_COLOR_G, Constants::EDGE_ALGO_RESULT_COLOR_B);
-                residual_graph->graph_representation->set_capacity_from_to(p, v, residual_graph->graph_representation->get_capacity_from_to(p, v)-flow);
-                residual_graph->graph_representation->set_capacity_from_to(v, p, residual_graph->graph_representation->get_capacity_from_to(v, p)+flow);
-                v = p;
-            }
-        }
-    } while(valid_path);
-    delete residual_graph;
-    return max_flow;
+WeightSum Graph::algo_edmonds_karp(const Vertex* source, const Vertex* sink, bool render) {
+    TRACE_SCOPE("Graph::algo_edmonds_karp");
+    STATS_SCOPE(run_stats, stats_depth, "edmonds-karp");
+    return run_visited<Algorithms::EdmondsKarp>(render, source, sink, type, orientation, graph_representation, Algorithms::Context(run_stats, cancel_flag), source, sink);
 }
 
 /*
-Breadth-First-Search algorithm for Edmonds-Karp.
+Ford Fulkerson algorithm. While there is a path from source to sink, find
+the smallest capacity of the path, add it to the max_flow and to every reverse
+edge of the path, and remove it from every edge in the path. When no more path
+is found, max_flow has the maximum flow and is returned. The vertices
+the searches went through and the edges of the augmenting paths are
+colored if render is true.
 */
-bool Graph::algo_edmonds_karp_bfs(const Graph* graph, std::map<const Vertex*, double>* path_capacity, std::map<const Vertex*, const Vertex*>* parents, const Vertex* source, const Vertex* sink) {
-    std::queue<const Vertex*> bfs;
-    unsigned int              inf_unsigned = -1; inf_unsigned /= 2;
-    int                       inf_signed   = inf_unsigned;
-    bfs.push(source);
-    parents->insert(std::make_pair(source, source));
-    path_capacity->insert(std::make_pair(source, inf_signed));
-    while(!bfs.empty()) {
-        const Vertex* v = bfs.front();
-        bfs.pop();
-        for(const Vertex* n : graph->graph_representation->get_direct_neighbors(v, orientation)) {
-            double capacity_v_n = graph->graph_representation->get_capacity_from_to(v, n);
-            if(capacity_v_n>0 && !parents->count(n)) {
-                parents->insert(std::make_pair(n, v));
-                path_capacity->insert(std::make_pair(n, std::min(path_capacity->at(v), capacity_v_n)));
-                if(n!=sink) {
-                    bfs.push(n);
-                }
-                else {
-                    return true;
-                }
-            }
-        }
-    }
-    return false;
+WeightSum Graph::algo_ford_fulkerson(const Vertex* source, const Vertex* sink, bool render) {
+    TRACE_SCOPE("Graph::algo_ford_fulkerson");
+    STATS_SCOPE(run_stats, stats_depth, "ford-fulkerson");
+    return run_visited<Algorithms::FordFulkerson>(render, source, sink, type, orientation, graph_representation, Algorithms::Context(run_stats, cancel_flag), source, sink);
 }
 
 /*
-Ford Fulkerson algorithm. While there is a path from source to sink, find
-the smallest capacity of the path, add it to the max_flow and to every reverse
-edge of the path, and remove it from every edge in the path. When no more path
-is found, max_flow has the maximum flow and is returned.
+Prim algorithm. While there are edges in the set, select the one with
+less capacity, include it in the subgraph and study its two vertices.
+It returns the minimal covering graph. The orientation is ignored. The
+edges of the covering graph are colored if render is true.
 */
-int Graph::algo_ford_fulkerson(const Vertex* source, const Vertex* sink) {
-    int    max_flow          = 0;
-    Graph* residual_graph    = new Graph(type, nb_vertices);
-    *residual_graph          = *this;
-    const Vertex* res_source = residual_graph->graph_representation->getVertices()->at(source->getId());
-    const Vertex* res_sink   = residual_graph->graph_representation->getVertices()->at(sink->getId());
-    /* While there is a path from source to sink */
-    bool valid_path = true;
-    std::vector<const Vertex*>* path    = new std::vector<const Vertex*>;
-    std::set<const Vertex*>*    visited = new std::set<const Vertex*>;
-    do {
-        visited->clear();
-        visited->insert(res_source);
-        path->clear();
-        path->push_back(res_source);
-        valid_path = algo_ford_fulkerson_dfs(const_cast<const Graph *>(residual_graph), path, visited, res_source, res_sink);
-        if(valid_path) {
-            /* finds the minimum capacity */
-            int min_flow = residual_graph->graph_representation->get_capacity_from_to(res_source, path->at(1));
-            for(std::vector<const Vertex*>::iterator it=path->begin() ; it!=path->end() ; it++) {
-                if(*it!=res_sink) {
-                    graph_representation->get_edge_from_to((*it)->getId(), (*(it+1))->getId())->setColor(Constants::EDGE_ALGO_RESULT_COLOR_R, Constants::EDGE_ALGO_RESULT_COLOR_G, Constants::EDGE_ALGO_RESULT_COLOR_B);
-                    int f = residual_graph->graph_representation->get_capacity_from_to(*it, *(it+1));
-                    if(f<min_flow) min_flow = f;
-                }
-            }
-            /* adds the capacity to the max flow */
-            max_flow += min_flow;
-            /* updates the capacities */
-            for(std::vector<const Vertex*>::iterator it=path->begin() ; it!=path->end() ; it++) {
-                if(*it!=res_sink) {
-                    residual_graph->graph_representation->set_capacity_from_to(*it, *(it+1), residual_graph->graph_representation->get_capacity_from_to(*it, *(it+1))-min_flow);
-                    residual_graph->graph_representation->set_capacity_from_to(*(it+1), *it, residual_graph->graph_representation->get_capacity_from_to(*(it+1), *it)+min_flow);
-                }
-            }
-        }
-    } while(valid_path);
-    delete path;
-    delete visited;
-    delete residual_graph;
-    return max_flow;
+std::vector<const Edge*>* Graph::algo_prim(bool render) {
+    TRACE_SCOPE("Graph::algo_prim");
+    STATS_SCOPE(run_stats, stats_depth, "prim");
+    return run_visited<Algorithms::Prim>(render, 0, 0, type, NONE, graph_representation, Algorithms::Context(run_stats, cancel_flag, search_workspace()));
 }
 
 /*
-Ford Fulkerson algorithm callback method. Tries to find a valid path from
-source to sink and returns true if a path is found. Otherwise returns false.
-The search is DFS which makes it inefficient. Edmonds-Karp advantage is to
-perform a BFS which overall reduces the running time.
+The Traveling Salesman problem. Given a source and a list of vertices to visit,
+returns the shortest trip so that every destination is visited and the salesman
+goes back to the source. This is a difficult problem. The branch and bound
+search is split in tasks by the first destinations of the path, which run on
+the shared thread pool. It returns the trip the sequential search finds, or
+an empty trip if a destination cannot be reached. Its cost, infinite in this
+case, is written in tour_cost. If sequential is true, the search is not
+split and runs as a single task, to measure the speedup of the parallel
+search in the benchmark. The trip is colored if render is true.
 */
-bool Graph::algo_ford_fulkerson_dfs(const Graph* graph, std::vector<const Vertex*>* path, std::set<const Vertex*>* visited, const Vertex* source, const Vertex* sink) {
-    for(const Vertex* v : graph->graph_representation->get_direct_neighbors(path->back(), orientation)) {
-        if(graph->graph_representation->get_capacity_from_to(path->back(), v)>0) {
-            if(v==sink) {
-                path->push_back(v);
-                return true;
-            }
-            else if(v!=source && visited->count(v)==0) {
-                const_cast<Vertex*>(v)->setColor(0, 255, 255);
-                path->push_back(v);
-                visited->insert(v);
-                bool res = algo_ford_fulkerson_dfs(graph, path, visited, source, sink);
-                if(res) {
-                    return true;
-                }
-                else {
-                    path->erase((path->end()-1));
-                    visited->erase(v);
-                }
-            }
-        }
+std::vector<const Vertex*>* Graph::algo_traveling_salesman(const Vertex* source, std::vector<const Vertex*>* destinations, double* tour_cost, bool sequential, bool render) {
+    TRACE_SCOPE("Graph::algo_traveling_salesman");
+    STATS_SCOPE(run_stats, stats_depth, "traveling-salesman");
+    std::vector<const Vertex*>*   best_path = new std::vector<const Vertex*>;
+    TravelingSalesmanSearch       search;
+    std::vector<Prefix>           prefixes;
+    std::vector<std::vector<int>> trees;
+    search.cost_matrix = algo_traveling_salesman_cost_matrix(source, destinations, render ? &trees : 0);
+    search.cancel_flag = cancel_flag;
+    search.min_cost    = std::numeric_limits<double>::infinity();
+    search.best_task   = std::numeric_limits<int>::max();
+    search.size        = static_cast<int>(destinations->size())+1;
+    /* the paths are split after enough destinations to give a few tasks to each thread */
+    int  nb_threads = ThreadPool::get()->getNbThreads();
+    int  depth      = 0;
+    long nb_tasks   = 1;
+    while(!sequential && depth<search.size-1 && nb_tasks<nb_threads*Constants::PARALLEL_TASKS_PER_THREAD) nb_tasks *= search.size-1-depth++;
+    std::vector<int>  path;
+    std::vector<char> visited(search.size, 0);
+    traveling_salesman_prefixes(&search, depth, &path, &visited, 0, &prefixes);
+    std::vector<unsigned long> nodes(prefixes.size(), 0);
+    if(!is_cancelled() && traveling_salesman_reachable(search.cost_matrix, search.size)) {
+        ThreadPool::get()->parallel_for(static_cast<int>(prefixes.size()), [&](int task) {
+            std::vector<int>  task_path = prefixes[task].first;
+            std::vector<char> task_visited(search.size, 0);
+            for(int d : task_path) task_visited[d] = 1;
+            traveling_salesman_search(&search, task, &task_path, &task_visited, prefixes[task].second, &nodes[task]);
+        });
     }
-    return false;
+    STATS_ADD(run_stats, recursion_nodes, std::accumulate(nodes.begin(), nodes.end(), 0ul));
+    if(tour_cost) *tour_cost = search.min_cost;
+    for(int i=0 ; i<search.size ; i++) delete [] search.cost_matrix[i];
+    delete [] search.cost_matrix;
+    if(is_cancelled() || search.best_path.empty()) return best_path;
+    for(int d : search.best_path) best_path->push_back(destinations->at(d-1));
+    if(render) {
+        std::vector<const Vertex*> stops(1, source);
+        stops.insert(stops.end(), destinations->begin(), destinations->end());
+        algo_traveling_salesman_route(stops, search.best_path, trees);
+    }
+    return best_path;
 }
 
 /*
-Prim algorithm. While there are edges in the set, select the one with
-less capacity, include it in the subgraph and study its two vertices.
-It returns the minimal covering graph.
+Creates the cost matrix for the traveling salesman problem: the length of
+the shortest path between each two of the source and the destinations,
+infinity if there is none. Each row comes from one shortest path tree.
+If trees is given, the vertex before each vertex in the tree of each
+stop but the last one is kept in it, by identifier, to draw the trip.
 */
-std::vector<const Edge*>* Graph::algo_prim() {
-    std::set<const Vertex*>   visited;
-    std::set<const Edge*>     search;
-    std::vector<const Edge*> *sub_graph = new std::vector<const Edge*>;
-    /* begin with a random Vertex */
-    Vertex* v_begin = graph_representation->getVertices()->at(0);
-    visited.insert(v_begin);
-    /* add all adjacency edges */
-    for(Vertex* v : graph_representation->get_all_neighbors(v_begin)) { search.insert(graph_representation->get_edge_from_to(v_begin, v)); }
-    while(!search.empty()) {
-        std::set<const Edge*>::iterator it_min;
-        it_min = std::min_element(search.begin(), search.end(), [](const Edge* e1, const Edge* e2){ return e1->getCapacityV1ToV2()<e2->getCapacityV1ToV2(); });
-        const Edge* e_min = *it_min;
-        search.erase(it_min);
-        Vertex* v1 = e_min->getV1();
-        Vertex* v2 = e_min->getV2();
-        if(!visited.count(v1) || !visited.count(v2)) {
-            sub_graph->push_back(e_min);
-            if(!visited.count(v1)) {
-                visited.insert(v1);
-                /* add all adjacency edges */
-                for(Vertex* v : graph_representation->get_all_neighbors(v1)) { search.insert(graph_representation->get_edge_from_to(v1, v)); }
-            }
-            else {
-                visited.insert(v2);
-                /* add all adjacency edges */
-                for(Vertex* v : graph_representation->get_all_neighbors(v2)) { search.insert(graph_representation->get_edge_from_to(v2, v)); }
-            }
+double** Graph::algo_traveling_salesman_cost_matrix(const Vertex* source, std::vector<const Vertex*>* destinations, std::vector<std::vector<int>>* trees) {
+    TRACE_SCOPE("Graph::algo_traveling_salesman_cost_matrix");
+    int                 len         = static_cast<int>(destinations->size())+1;
+    double**            cost_matrix = new double*[len];
+    std::vector<double> distances;
+    std::vector<int>    predecessors;
+    for(int i=0 ; i<len ; i++) cost_matrix[i] = new double[len]();
+    for(int i=0 ; i<len-1 && !is_cancelled() ; i++) {
+        const Vertex* v1 = i==0 ? source : destinations->at(i-1);
+        if(!algo_delta_stepping(v1, &distances, &predecessors)) break;
+        for(int j=i+1 ; j<len ; j++) {
+            int id = destinations->at(j-1)->getId();
+            cost_matrix[i][j] = cost_matrix[j][i] = predecessors[id]==-1 ? std::numeric_limits<double>::infinity() : distances[id];
         }
+        if(trees) trees->push_back(predecessors);
     }
-    /* displays the sub graph */
-    for(const Edge* e : *sub_graph) const_cast<Edge*>(e)->setColor(Constants::EDGE_ALGO_RESULT_COLOR_R, Constants::EDGE_ALGO_RESULT_COLOR_G, Constants::EDGE_ALGO_RESULT_COLOR_B);
-    return sub_graph;
+    return cost_matrix;
 }
 
 /*
-The Traveling Salesman problem. Given a source and a list of vertices to visit,
-returns the shortest trip so that every destination is visited and the salesman
-goes back to the source. This is a difficult problem. */
-std::vector<const Vertex*>* Graph::algo_traveling_salesman(const Vertex* source, std::vector<const Vertex*>* destinations) {
-    std::vector<const Vertex*>                 path;
-    std::vector<const Vertex*>*                best_path    = new std::vector<const Vertex*>;
-    unsigned int                               min_cost_uns = 0; min_cost_uns--; min_cost_uns /= 2;
-    double                                     min_cost     = min_cost_uns;
-    std::set<const Vertex*>                    visited;
-    std::map<const Vertex*, unsigned long int> v_map;
-    v_map[source] = 0;
-    for(unsigned long int i=0 ; i<destinations->size() ; i++) { v_map[destinations->at(i)] = i+1; }
-    double **cost_matrix = algo_traveling_salesman_cost_matrix(source, destinations);
-    algo_traveling_salesman_callback(cost_matrix, v_map, source, destinations, &path, best_path, &visited, 0, &min_cost);
-    for(unsigned long int i=0 ; i<destinations->size()+1 ; i++) delete [] cost_matrix[i];
-    delete [] cost_matrix;
-    // prints the route
-    best_path->push_back(source);
-    best_path->insert(best_path->begin(), source);
-    for(unsigned long int i=0 ; i<best_path->size()-1 ; i++) {
-        std::vector<const Edge*>* sub_route = algo_astar(best_path->at(i), best_path->at(i+1));
-        for(const Edge* e : *sub_route) {
-            const_cast<Edge*>(e)->setColor(Constants::EDGE_ALGO_RESULT_COLOR_R, Constants::EDGE_ALGO_RESULT_COLOR_G, Constants::EDGE_ALGO_RESULT_COLOR_B);
-            const_cast<Vertex*>(e->getV1())->setColor(Constants::VERTEX_VISITED_COLOR_R, Constants::VERTEX_VISITED_COLOR_G, Constants::VERTEX_VISITED_COLOR_B);
-            const_cast<Vertex*>(e->getV2())->setColor(Constants::VERTEX_VISITED_COLOR_R, Constants::VERTEX_VISITED_COLOR_G, Constants::VERTEX_VISITED_COLOR_B);
-        }
-    }
-    for(const Vertex* v : *best_path) {
-        const_cast<Vertex*>(v)->setColor(Constants::VERTEX_PATH_COLOR_R, Constants::VERTEX_PATH_COLOR_G, Constants::VERTEX_PATH_COLOR_B);
+Heuristic for the Traveling Salesman problem, for more destinations than
+the exact search can handle. A first trip goes to the closest destination
+left, or follows a space-filling curve, and is then improved with 2-opt
+and Or-opt moves, see graph/TourHeuristic.hpp. The cost of the trip is
+written in tour_cost, infinite with an empty trip if a destination cannot
+be reached, and the time the heuristic took, without the cost matrix, in
+milliseconds. The trip is colored if render is true.
+*/
+std::vector<const Vertex*>* Graph::algo_traveling_salesman_heuristic(const Vertex* source, std::vector<const Vertex*>* destinations, TSP_SOLVER solver, double* tour_cost, double* milliseconds, bool render) {
+    TRACE_SCOPE("Graph::algo_traveling_salesman_heuristic");
+    STATS_SCOPE(run_stats, stats_depth, "traveling-salesman-heuristic");
+    std::vector<const Vertex*>*   best_path = new std::vector<const Vertex*>;
+    std::vector<const Vertex*>    stops(1, source);
+    std::vector<int>              tour;
+    std::vector<std::vector<int>> trees;
+    stops.insert(stops.end(), destinations->begin(), destinations->end());
+    double**      cost_matrix = algo_traveling_salesman_cost_matrix(source, destinations, render ? &trees : 0);
+    TourHeuristic heuristic(cost_matrix, stops, cancel_flag);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool reachable = traveling_salesman_reachable(cost_matrix, static_cast<int>(stops.size()));
+    bool done      = !is_cancelled() && reachable && heuristic.run(solver, &tour);
+    if(milliseconds) *milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()-start).count();
+    if(tour_cost) {
+        *tour_cost = reachable ? 0 : std::numeric_limits<double>::infinity();
+        for(std::size_t i=0 ; i<tour.size() ; i++) *tour_cost += cost_matrix[tour[i]][tour[(i+1)%tour.size()]];
     }
-    const_cast<Vertex*>(source)->setColor(Constants::EDGE_ALGO_SOURCE_COLOR_R, Constants::EDGE_ALGO_SOURCE_COLOR_G, Constants::EDGE_ALGO_SOURCE_COLOR_B);
-    best_path->erase(best_path->begin());
-    best_path->pop_back();
+    for(std::size_t i=0 ; i<stops.size() ; i++) delete [] cost_matrix[i];
+    delete [] cost_matrix;
+    if(!done) return best_path;
+    for(std::size_t i=1 ; i<tour.size() ; i++) best_path->push_back(stops[tour[i]]);
+    if(render) algo_traveling_salesman_route(stops, std::vector<int>(tour.begin()+1, tour.end()), trees);
     return best_path;
 }
 
 /*
-Callback for the Traveling Salesman problem.
-Branch and bound algorithm.
+Colors the trip of the traveling salesman, from the source, stop 0, to
+the stops in the order of the tour and back to the source, following the
+shortest path between two stops. The paths come from the trees kept by
+algo_traveling_salesman_cost_matrix(): a leg leaving the last stop, which
+has no tree, follows the tree of the stop it goes to, backwards.
 */
-void Graph::algo_traveling_salesman_callback(double** cost_matrix, std::map<const Vertex*, unsigned long int> v_map, const Vertex* source, std::vector<const Vertex*>* destinations, std::vector<const Vertex*>* path, std::vector<const Vertex*>* best_path, std::set<const Vertex*>* visited, double cost, double* min_cost) {
-    if(path->size()==destinations->size()) {
-        cost += cost_matrix[v_map[path->back()]][v_map[source]];
-        if(cost<*min_cost) {
-            *min_cost = cost;
-            best_path->clear();
-            for(const Vertex* v : *path) best_path->push_back(v);
+void Graph::algo_traveling_salesman_route(const std::vector<const Vertex*>& stops, const std::vector<int>& tour, const std::vector<std::vector<int>>& trees) {
+    for(std::size_t i=0 ; i<=tour.size() ; i++) {
+        int from = i==0 ? 0 : tour[i-1];
+        int to   = i==tour.size() ? 0 : tour[i];
+        if(from>=static_cast<int>(trees.size())) std::swap(from, to);
+        if(from>=static_cast<int>(trees.size())) continue;
+        const std::vector<int>& predecessors = trees[from];
+        int                     root         = stops[from]->getId();
+        if(predecessors[stops[to]->getId()]==-1) continue;
+        for(int v=stops[to]->getId() ; v!=root ; v=predecessors[v]) {
+            graph_representation->set_color(graph_representation->get_edge_from_to(predecessors[v], v), Constants::EDGE_ALGO_RESULT_COLOR_R, Constants::EDGE_ALGO_RESULT_COLOR_G, Constants::EDGE_ALGO_RESULT_COLOR_B);
+            graph_representation->set_color(graph_representation->getVertices()->at(v), Constants::VERTEX_VISITED_COLOR_R, Constants::VERTEX_VISITED_COLOR_G, Constants::VERTEX_VISITED_COLOR_B);
         }
     }
-    else {
-        for(const Vertex* d : *destinations) {
-            if(!visited->count(d)) {
-                const Vertex *v;
-                if(path->size()==0) v = source;
-                else                v = path->back();
-                cost += cost_matrix[v_map[v]][v_map[d]];
-                path->push_back(d);
-                visited->insert(d);
-                if(cost<*min_cost) algo_traveling_salesman_callback(cost_matrix, v_map, source, destinations, path, best_path, visited, cost, min_cost);
-                cost -= cost_matrix[v_map[v]][v_map[d]];
-                path->pop_back();
-                visited->erase(d);
-            }
-        }
+    for(std::size_t i=1 ; i<stops.size() ; i++) {
+        graph_representation->set_color(stops[i], Constants::VERTEX_PATH_COLOR_R, Constants::VERTEX_PATH_COLOR_G, Constants::VERTEX_PATH_COLOR_B);
     }
+    graph_representation->set_color(stops[0], Constants::EDGE_ALGO_SOURCE_COLOR_R, Constants::EDGE_ALGO_SOURCE_COLOR_G, Constants::EDGE_ALGO_SOURCE_COLOR_B);
 }
 
 /*
-Creates the cost matrix for the traveling salesman
-problem using the A* algorithm.
+Returns the buffers of A*, Dijkstra and Prim, built on the first call.
+A graph runs one algorithm at a time, so the runs share them.
 */
-double** Graph::algo_traveling_salesman_cost_matrix(const Vertex* source, std::vector<const Vertex*>* destinations) {
-    int len = static_cast<int>(destinations->size())+1;
-    double **cost_matrix = new double*[len];
-    for(int i=0 ; i<len ; i++) cost_matrix[i] = new double[len];
-    for(int i=0 ; i<len ; i++) {
-        for(int j=i+1 ; j<len ; j++) {
-            const Vertex *v1;
-            if(i==0) v1 = source; else v1 = destinations->at(i-1);
-            std::vector<const Edge*>* route = algo_astar(v1, destinations->at(j-1));
-            double                    cost  = 0;
-            const Vertex*             current_v = v1;
-            for(const Edge* e : *route) {
-                if(current_v==e->getV1()) { cost += current_v->distanceTo(e->getV2()); current_v = e->getV2(); }
-                else                      { cost += current_v->distanceTo(e->getV1()); current_v = e->getV1(); }
-            }
-            cost_matrix[i][j] = cost;
-            cost_matrix[j][i] = cost;
-            delete route;
-        }
-    }
-    return cost_matrix;
+Algorithms::Workspace* Graph::search_workspace() {
+    if(!workspace) workspace = new Algorithms::Workspace;
+    return workspace;
 }
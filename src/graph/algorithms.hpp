@@ -0,0 +1,960 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef algorithms_hpp
+#define algorithms_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "CliqueSearch.hpp"
+#include "components/Edge.hpp"
+#include "components/Vertex.hpp"
+#include "components/Weight.hpp"
+#include "concurrency/ThreadPool.hpp"
+#include "constants/Constants.hpp"
+#include "graph_representation/GraphRepresentationBitMatrix.hpp"
+#include "graph_representation/NeighborRange.hpp"
+#include "RadixHeap.hpp"
+#include "stats/AlgorithmStats.hpp"
+
+/*
+Graph algorithms, as templates over the representation of the graph
+and the orientation of its arcs. Graph::algo_* pick the instance that
+matches the type and the orientation of the graph, so that the inner
+loops of the algorithms do not go through virtual functions.
+
+The algorithms report what they do to a visitor, NoVisitor for the
+batch runs and RenderVisitor for the handlers that display the result.
+A representation R provides, besides the attribute functions of
+GraphRepresentation (colors, capacities, get_v1()...):
+    typedef ...   weight_type;   capacities, see components/Weight.hpp
+    weight_type   capacity(int id1, int id2) const;
+    Edge*         edge(int id1, int id2) const;
+    NeighborRange neighbors(const Vertex* v) const;
+    void          set_capacity(int id1, int id2, weight_type c);
+An orientation policy O provides O::follows(r, e, v), true if the arc e
+can be followed from vertex v.
+*/
+namespace Algorithms {
+
+    /*
+    Arcs can only be followed from v1 to v2.
+    */
+    struct OneWay {
+        template<typename R> static bool follows(const R& r, const Edge* e, const Vertex* v) { return r.get_v1_id(e)==v->getId(); }
+    };
+    
+    /*
+    Edges can be followed both ways.
+    */
+    struct NoOrientation {
+        template<typename R> static bool follows(const R&, const Edge*, const Vertex*) { return true; }
+    };
+    
+    /*
+    Arcs can be followed both ways, with a capacity for each way.
+    */
+    struct TwoWays {
+        template<typename R> static bool follows(const R&, const Edge*, const Vertex*) { return true; }
+    };
+    
+    /*
+    Events of a run: a vertex is reached, an arc is relaxed, the distance
+    of a vertex is final, and an edge or a vertex is part of the result
+    (path, augmenting path, spanning tree, clique). NoVisitor ignores
+    them, so that the calls compile away.
+    */
+    struct NoVisitor {
+        void on_discover(const Vertex*)    const {}
+        void on_path_edge(const Edge*)     const {}
+        void on_path_vertex(const Vertex*) const {}
+        void on_relax(const Edge*)         const {}
+        void on_settle(const Vertex*)      const {}
+    };
+    
+    /*
+    Colors the reached vertices and the result of a run on the given
+    representation. The source and the destination, if any, keep the
+    colors they were given when the run was prepared.
+    */
+    struct RenderVisitor {
+        RenderVisitor(GraphRepresentation* r, const Vertex* source, const Vertex* destination) : r(r), source(source), destination(destination) {}
+        bool keeps(const Vertex* v)          const { return v==source || v==destination; }
+        void on_discover(const Vertex* v)    const { if(!keeps(v)) r->set_color(v, Constants::VERTEX_VISITED_COLOR_R, Constants::VERTEX_VISITED_COLOR_G, Constants::VERTEX_VISITED_COLOR_B); }
+        void on_path_edge(const Edge* e)     const { r->set_color(e, Constants::EDGE_ALGO_RESULT_COLOR_R, Constants::EDGE_ALGO_RESULT_COLOR_G, Constants::EDGE_ALGO_RESULT_COLOR_B); }
+        void on_path_vertex(const Vertex* v) const { if(!keeps(v)) r->set_color(v, Constants::VERTEX_PATH_COLOR_R, Constants::VERTEX_PATH_COLOR_G, Constants::VERTEX_PATH_COLOR_B); }
+        void on_relax(const Edge*)           const {}
+        void on_settle(const Vertex*)        const {}
+        GraphRepresentation* r;             /* representation the colors are written to */
+        const Vertex*        source;        /* source of the run, may be null */
+        const Vertex*        destination;   /* destination of the run, may be null */
+    };
+    
+    /*
+    Buffers of A*, Dijkstra and Prim, indexed by the ids of the vertices.
+    The graph keeps them from a run to the next, so that a search does
+    not allocate once they have grown to the size of the graph; their
+    content is reset at the start of each run.
+    */
+    struct Workspace {
+        std::vector<double>                         costs;      /* cost of the best path found to each vertex */
+        std::vector<std::pair<Weight, const Edge*>> edges;      /* binary heap of the edges leaving the tree, for Prim */
+        RadixHeap<double, const Vertex*>            heap;       /* vertices waiting to be settled, by cost */
+        std::vector<const Vertex*>                  previous;   /* vertex before each vertex on its best path */
+        std::vector<char>                           visited;    /* 1 for the settled vertices */
+    };
+    
+    /*
+    Counters, cancellation flag and buffers of the graph running the
+    algorithm. The buffers must be given to AStar, Dijkstra and Prim.
+    */
+    struct Context {
+        Context(AlgorithmStats& stats, const std::atomic<bool>* cancel_flag, Workspace* workspace=0) : stats(stats), cancel_flag(cancel_flag), workspace(workspace) {}
+        bool cancelled() const { return cancel_flag && *cancel_flag; }
+        AlgorithmStats&          stats;         /* counters of the run */
+        const std::atomic<bool>* cancel_flag;   /* set to stop the run, may be null */
+        Workspace*               workspace;     /* buffers reused between the runs, may be null for the other algorithms */
+    };
+    
+    /*
+    Number of tasks a step of a parallel algorithm working on the given
+    number of vertices is split in: one per PARALLEL_GRAIN vertices, and
+    at most PARALLEL_TASKS_PER_THREAD per thread of the shared pool.
+    */
+    inline int nb_tasks(std::size_t work) {
+        std::size_t max_tasks = static_cast<std::size_t>(ThreadPool::get()->getNbThreads()*Constants::PARALLEL_TASKS_PER_THREAD);
+        return static_cast<int>(std::max<std::size_t>(1, std::min(max_tasks, (work+Constants::PARALLEL_GRAIN-1)/Constants::PARALLEL_GRAIN)));
+    }
+    
+    /*
+    Runs Kernel<R, O>::run(r, args...) with the orientation policy that
+    matches the given orientation.
+    */
+    template<template<typename, typename> class Kernel, typename R, typename... Args>
+    typename Kernel<R, NoOrientation>::result_type run_oriented(GRAPH_ORIENTATION orientation, R& r, Args... args) {
+        switch(orientation) {
+            case ONE_WAY  : return Kernel<R, OneWay>::run(r, args...);
+            case TWO_WAYS : return Kernel<R, TwoWays>::run(r, args...);
+            case NONE     :
+            default       : return Kernel<R, NoOrientation>::run(r, args...);
+        }
+    }
+    
+    /*
+    A* algorithm, see Graph::algo_astar().
+    */
+    template<typename R, typename O>
+    struct AStar {
+        typedef std::vector<const Edge*>* result_type;
+        template<typename V>
+        static result_type run(R&, const Context&, const V&, const Vertex*, const Vertex*);
+    };
+    
+    /*
+    Breadth-first search, see Graph::algo_bfs(). search() is the engine,
+    also used by the flow algorithms with a predicate on the residual
+    capacity of the arcs. It runs level by level on the shared thread
+    pool: top-down from the frontier while it is small, bottom-up from
+    the unvisited vertices once it is large (Beamer's direction-optimizing
+    BFS), with the visited vertices and the frontier kept as bitmaps.
+    */
+    template<typename R, typename O>
+    struct Bfs {
+        typedef std::vector<int>* result_type;
+        template<typename V>
+        static result_type run(R&, const Context&, const V&, const Vertex*, const Vertex*);
+        template<typename Arc>
+        static bool        search(const R&, const Context&, const Arc&, int, int, std::vector<int>*, std::vector<int>*);
+    };
+    
+    /*
+    Bron-Kerbosch algorithm, see Graph::algo_bron_kerbosch(). The search
+    itself is done by CliqueSearch, on rows of bits.
+    */
+    template<typename R, typename O>
+    struct BronKerbosch {
+        typedef std::set<const Vertex*>* result_type;
+        template<typename V>
+        static result_type run(R&, const Context&, const V&);
+    };
+    
+    /*
+    Bron-Kerbosch algorithm on a bit matrix, which already holds the rows
+    of bits of the vertices.
+    */
+    template<typename O>
+    struct BronKerbosch<GraphRepresentationBitMatrix, O> {
+        typedef std::set<const Vertex*>* result_type;
+        template<typename V>
+        static result_type run(GraphRepresentationBitMatrix&, const Context&, const V&);
+    };
+    
+    /*
+    Delta-stepping algorithm, see Graph::algo_delta_stepping().
+    */
+    template<typename R, typename O>
+    struct DeltaStepping {
+        typedef bool result_type;
+        static result_type run(R&, const Context&, const Vertex*, std::vector<double>*, std::vector<int>*);
+        static double      delta(const R&, std::vector<double>*);
+        static void        relax(const R&, const Context&, const std::vector<int>&, const std::vector<double>&, double, bool, double*, std::vector<std::vector<int>>*);
+    };
+    
+    /*
+    Dijkstra algorithm, see Graph::algo_dijkstra().
+    */
+    template<typename R, typename O>
+    struct Dijkstra {
+        typedef std::vector<const Edge*>* result_type;
+        template<typename V>
+        static result_type run(R&, const Context&, const V&, const Vertex*, const Vertex*);
+    };
+    
+    /*
+    Edmonds-Karp algorithm, see Graph::algo_edmonds_karp(). The flow is
+    summed in the type WeightTraits gives for the capacities of R, which
+    is exact for integer capacities.
+    */
+    template<typename R, typename O>
+    struct EdmondsKarp {
+        typedef typename R::weight_type       W;
+        typedef typename WeightTraits<W>::Sum result_type;
+        template<typename V>
+        static result_type run(R&, const Context&, const V&, const Vertex*, const Vertex*);
+    };
+    
+    /*
+    Ford-Fulkerson algorithm, see Graph::algo_ford_fulkerson(). The flow
+    is summed as by EdmondsKarp.
+    */
+    template<typename R, typename O>
+    struct FordFulkerson {
+        typedef typename R::weight_type       W;
+        typedef typename WeightTraits<W>::Sum result_type;
+        template<typename V>
+        static result_type run(R&, const Context&, const V&, const Vertex*, const Vertex*);
+        template<typename V>
+        static bool        dfs(R&, const Context&, const V&, std::vector<const Vertex*>*, std::set<const Vertex*>*, const Vertex*, const Vertex*);
+    };
+    
+    /*
+    Prim algorithm, see Graph::algo_prim().
+    */
+    template<typename R, typename O>
+    struct Prim {
+        typedef std::vector<const Edge*>* result_type;
+        template<typename V>
+        static result_type run(R&, const Context&, const V&);
+    };
+
+}
+
+/*
+A* algorithm. The search is Dijkstra's, except that the vertices wait
+in the radix heap by cost plus euclidian distance to the destination.
+The distance is consistent, so the keys popped never decrease; a key
+pushed is raised to the last one popped, which it can only be under
+by rounding.
+*/
+template<typename R, typename O>
+template<typename V>
+std::vector<const Edge*>* Algorithms::AStar<R, O>::run(R& r, const Context& ctx, const V& visitor, const Vertex* source, const Vertex* destination) {
+    std::size_t  n          = r.getVertices()->size();
+    bool         path_found = false;
+    Workspace&   w          = *ctx.workspace;
+    /* initialization */
+    w.costs.assign(n, std::numeric_limits<double>::infinity());
+    w.previous.assign(n, 0);
+    w.visited.assign(n, 0);
+    w.heap.clear();
+    w.costs[source->getId()] = 0;
+    w.heap.push(source->distanceTo(destination), source);
+    STATS_COUNT(ctx.stats, heap_pushes);
+    while(!w.heap.empty() && !ctx.cancelled()) {
+        /* extracts the vertex with minimum cost plus distance to the destination - updated search compared to Dijkstra */
+        std::pair<double, const Vertex*> top   = w.heap.pop();
+        const Vertex*                    v_min = top.second;
+        STATS_COUNT(ctx.stats, heap_pops);
+        if(w.visited[v_min->getId()]) continue;
+        w.visited[v_min->getId()] = 1;
+        visitor.on_settle(v_min);
+        STATS_COUNT(ctx.stats, vertices_settled);
+        /* stop if destination is found */
+        if(v_min==destination) {
+            path_found = true;
+            break;
+        }
+        /* same treatment for all neighbors */
+        for(const Neighbor& nb : r.neighbors(v_min)) {
+            const Vertex* v = nb.vertex;
+            if(O::follows(r, nb.edge, v_min) && !w.visited[v->getId()]) {
+                STATS_COUNT(ctx.stats, edges_relaxed);
+                visitor.on_relax(nb.edge);
+                visitor.on_discover(v);
+                double diff = w.costs[v_min->getId()] + v_min->distanceTo(v);
+                if(diff<w.costs[v->getId()]) {
+                    w.costs[v->getId()]    = diff;
+                    w.previous[v->getId()] = v_min;
+                    w.heap.push(std::max(diff+v->distanceTo(destination), top.first), v);
+                    STATS_COUNT(ctx.stats, heap_pushes);
+                }
+            }
+        }
+    }
+    /* prints the path */
+    if(path_found) {
+        const Vertex* v = destination;
+        std::vector<const Edge*>* path = new std::vector<const Edge*>;
+        while(v!=source) {
+            Edge* e = r.edge(v->getId(), w.previous[v->getId()]->getId());
+            visitor.on_path_edge(e);
+            path->push_back(e);
+            v = w.previous[v->getId()];
+            visitor.on_path_vertex(v);
+        }
+        return path;
+    }
+    else {
+        return 0;
+    }
+}
+
+/*
+Breadth-first search from source, stopping once the level of target is
+over if there is one. Returns the number of hops from the source to each
+vertex, by identifier, -1 for the vertices that were not reached. The
+reached vertices and the path to the target are given to the visitor.
+*/
+template<typename R, typename O>
+template<typename V>
+std::vector<int>* Algorithms::Bfs<R, O>::run(R& r, const Context& ctx, const V& visitor, const Vertex* source, const Vertex* target) {
+    std::vector<int>* hops = new std::vector<int>;
+    std::vector<int>  parents;
+    const R&          cr   = r;
+    bool              path = search(cr, ctx, [&cr](const Vertex* from, const Vertex*, const Edge* e) { return O::follows(cr, e, from); }, source->getId(), target ? target->getId() : -1, hops, &parents);
+    if(ctx.cancelled()) return hops;
+    /* reports the reached vertices and the path, once the parallel search is over */
+    for(const Vertex* v : *r.getVertices()) {
+        if((*hops)[v->getId()]>0) visitor.on_discover(v);
+    }
+    if(path) {
+        for(int v=target->getId() ; v!=source->getId() ; v=parents[v]) {
+            visitor.on_path_edge(r.edge(v, parents[v]));
+            visitor.on_path_vertex(r.getVertices()->at(parents[v]));
+        }
+    }
+    return hops;
+}
+
+/*
+Breadth-first search from source, following the arcs for which
+arc(from, to, edge) is true. Fills hops with the number of hops from the
+source to each vertex, -1 if not reached, and parents with the vertex
+each one was reached from. The parent is the neighbor of smallest
+identifier in the previous level, so the result does not depend on the
+number of threads. The search stops when the level of target is over,
+unless target is -1. Returns true if the target was reached.
+Top-down, the vertices of the frontier claim their unvisited neighbors
+with an atomic or on the bitmap of the next level. Bottom-up, each task
+owns whole words of the bitmaps and its unvisited vertices look for a
+neighbor in the frontier. The search goes bottom-up when the edges out
+of the frontier are more than 1/BFS_ALPHA of the edges out of the
+unvisited vertices, and back top-down when the frontier holds less than
+1/BFS_BETA of the vertices.
+*/
+template<typename R, typename O>
+template<typename Arc>
+bool Algorithms::Bfs<R, O>::search(const R& r, const Context& ctx, const Arc& arc, int source, int target, std::vector<int>* hops, std::vector<int>* parents) {
+    const std::vector<Vertex*>& vertices  = *r.getVertices();
+    std::size_t                 n         = vertices.size();
+    std::size_t                 words     = (n+63)/64;
+    bool                        bottom_up = false;
+    std::vector<int>            frontier(1, source);
+    std::vector<std::uint64_t>  frontier_bits(words, 0);
+    std::vector<std::uint64_t>  next_bits(words, 0);
+    std::vector<std::uint64_t>  visited(words, 0);
+    hops->assign(n, -1);
+    parents->assign(n, -1);
+    int* hop    = hops->data();
+    int* parent = parents->data();
+    hop[source]    = 0;
+    parent[source] = source;
+    visited[source/64] |= std::uint64_t(1)<<(source%64);
+    /* the first call to neighbors() builds the index, before the tasks share it */
+    std::size_t frontier_size   = 1;
+    std::size_t frontier_edges  = r.neighbors(vertices[source]).size();
+    std::size_t unvisited_edges = 2*r.getEdges()->size()-frontier_edges;
+    for(int level=0 ; frontier_size>0 ; level++) {
+        if(ctx.cancelled())             return false;
+        if(target>=0 && hop[target]>=0) return true;
+        STATS_ADD(ctx.stats, vertices_settled, frontier_size);
+        if(!bottom_up && frontier_edges>unvisited_edges/Constants::BFS_ALPHA) {
+            std::fill(frontier_bits.begin(), frontier_bits.end(), 0);
+            for(int v : frontier) frontier_bits[v/64] |= std::uint64_t(1)<<(v%64);
+            bottom_up = true;
+        }
+        else if(bottom_up && frontier_size<n/Constants::BFS_BETA) {
+            frontier.clear();
+            for(std::size_t w=0 ; w<words ; w++) {
+                for(std::uint64_t word=frontier_bits[w] ; word ; word&=word-1) frontier.push_back(static_cast<int>(w*64+__builtin_ctzll(word)));
+            }
+            std::fill(next_bits.begin(), next_bits.end(), 0);
+            bottom_up = false;
+        }
+        int                      chunks = nb_tasks(bottom_up ? n : frontier_size);
+        std::vector<std::size_t> edges(chunks, 0);         /* edges looked at by each task */
+        std::vector<std::size_t> found(chunks, 0);         /* vertices reached by each task */
+        std::vector<std::size_t> found_edges(chunks, 0);   /* edges out of the vertices reached by each task */
+        if(bottom_up) {
+            ThreadPool::get()->parallel_for(chunks, [&](int c) {
+                for(std::size_t w=words*c/chunks ; w<words*(c+1)/chunks ; w++) {
+                    std::uint64_t next = 0;
+                    for(std::uint64_t word=~visited[w] ; word ; word&=word-1) {
+                        int v = static_cast<int>(w*64+__builtin_ctzll(word));
+                        if(static_cast<std::size_t>(v)>=n) break;
+                        NeighborRange neighbors = r.neighbors(vertices[v]);
+                        for(const Neighbor& nb : neighbors) {
+                            int u = nb.vertex->getId();
+                            edges[c]++;
+                            if((frontier_bits[u/64]>>(u%64)&1) && arc(nb.vertex, vertices[v], nb.edge)) {
+                                hop[v]    = level+1;
+                                parent[v] = u;
+                                next     |= std::uint64_t(1)<<(v%64);
+                                found[c]++;
+                                found_edges[c] += neighbors.size();
+                                break;
+                            }
+                        }
+                    }
+                    next_bits[w]  = next;
+                    visited[w]   |= next;
+                }
+            });
+            frontier_bits.swap(next_bits);
+        }
+        else {
+            std::vector<std::vector<int>> next(chunks);
+            ThreadPool::get()->parallel_for(chunks, [&](int c) {
+                for(std::size_t i=frontier_size*c/chunks ; i<frontier_size*(c+1)/chunks ; i++) {
+                    int u = frontier[i];
+                    for(const Neighbor& nb : r.neighbors(vertices[u])) {
+                        int           v   = nb.vertex->getId();
+                        std::uint64_t bit = std::uint64_t(1)<<(v%64);
+                        edges[c]++;
+                        if((visited[v/64]&bit) || !arc(vertices[u], nb.vertex, nb.edge)) continue;
+                        if(!(__atomic_fetch_or(&next_bits[v/64], bit, __ATOMIC_RELAXED)&bit)) {
+                            hop[v] = level+1;
+                            next[c].push_back(v);
+                            found_edges[c] += r.neighbors(nb.vertex).size();
+                        }
+                        int p = __atomic_load_n(&parent[v], __ATOMIC_RELAXED);
+                        while((p==-1 || u<p) && !__atomic_compare_exchange_n(&parent[v], &p, u, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+                    }
+                }
+            });
+            frontier.clear();
+            for(const std::vector<int>& chunk : next) frontier.insert(frontier.end(), chunk.begin(), chunk.end());
+            for(int v : frontier) {
+                visited[v/64]   |= std::uint64_t(1)<<(v%64);
+                next_bits[v/64]  = 0;
+            }
+            found[0] = frontier.size();
+        }
+        frontier_size   = 0;
+        frontier_edges  = 0;
+        for(int c=0 ; c<chunks ; c++) {
+            STATS_ADD(ctx.stats, edges_relaxed, edges[c]);
+            frontier_size  += found[c];
+            frontier_edges += found_edges[c];
+        }
+        unvisited_edges -= frontier_edges;
+    }
+    return target>=0 && hop[target]>=0;
+}
+
+/*
+Bron-Kerbosch algorithm. Returns only the first found biggest clique.
+The search runs on rows of bits built from the neighbors, with the
+vertices ranked by address, the order in which the sets of vertices of
+the sequential search held them, so that the same clique is found.
+*/
+template<typename R, typename O>
+template<typename V>
+std::set<const Vertex*>* Algorithms::BronKerbosch<R, O>::run(R& r, const Context& ctx, const V& visitor) {
+    std::size_t                       n          = r.getVertices()->size();
+    std::size_t                       words      = (n+63)/64;
+    std::set<const Vertex*>*          max_clique = new std::set<const Vertex*>;
+    std::vector<std::uint64_t>        bits(n*words, 0);
+    std::vector<int>                  clique;
+    std::vector<const Vertex*>        order(r.getVertices()->begin(), r.getVertices()->end());
+    std::vector<int>                  rank(n);
+    std::vector<const std::uint64_t*> rows(n);
+    std::sort(order.begin(), order.end(), std::less<const Vertex*>());
+    for(std::size_t i=0 ; i<n ; i++) rank[order[i]->getId()] = static_cast<int>(i);
+    for(std::size_t i=0 ; i<n ; i++) {
+        for(const Neighbor& nb : r.neighbors(order[i])) {
+            int j = rank[nb.vertex->getId()];
+            bits[i*words+j/64] |= std::uint64_t(1)<<(j%64);
+        }
+        rows[i] = bits.data()+i*words;
+    }
+    CliqueSearch search(rows, words, ctx.cancel_flag);
+    search.run(&clique);
+    STATS_ADD(ctx.stats, recursion_nodes, search.getNbNodes());
+    /* prints the clique */
+    for(int i : clique) {
+        max_clique->insert(order[i]);
+        visitor.on_path_vertex(order[i]);
+    }
+    return max_clique;
+}
+
+/*
+Bron-Kerbosch algorithm on a bit matrix. Returns only the first found
+biggest clique. The search runs on the rows of the matrix.
+*/
+template<typename O>
+template<typename V>
+std::set<const Vertex*>* Algorithms::BronKerbosch<GraphRepresentationBitMatrix, O>::run(GraphRepresentationBitMatrix& r, const Context& ctx, const V& visitor) {
+    std::size_t                       n          = r.getVertices()->size();
+    std::size_t                       words      = r.row_words();
+    std::set<const Vertex*>*          max_clique = new std::set<const Vertex*>;
+    std::vector<int>                  clique;
+    std::vector<std::uint64_t>        empty(words, 0);
+    std::vector<const std::uint64_t*> rows(n, empty.data());
+    if(!r.getEdges()->empty()) {
+        for(std::size_t v=0 ; v<n ; v++) rows[v] = r.row(static_cast<int>(v));
+    }
+    CliqueSearch search(rows, words, ctx.cancel_flag);
+    search.run(&clique);
+    STATS_ADD(ctx.stats, recursion_nodes, search.getNbNodes());
+    /* prints the clique */
+    for(int id : clique) {
+        const Vertex* v = r.getVertices()->at(id);
+        max_clique->insert(v);
+        visitor.on_path_vertex(v);
+    }
+    return max_clique;
+}
+
+/*
+Delta-stepping single-source shortest paths. Fills distances with the
+length of the shortest path from the source to each vertex, by
+identifier, infinity if there is none, and predecessors with the vertex
+before it on that path, -1 if there is none. The vertices wait in
+buckets of tentative distance, of width delta, which are emptied in
+order. The light arcs of the vertices of the current bucket, no longer
+than delta, are relaxed in parallel until the bucket stays empty, and
+then the heavy arcs of all the vertices it held. Returns false if the
+run was cancelled.
+*/
+template<typename R, typename O>
+bool Algorithms::DeltaStepping<R, O>::run(R& r, const Context& ctx, const Vertex* source, std::vector<double>* distances, std::vector<int>* predecessors) {
+    const R&                      cr    = r;
+    std::size_t                   n     = r.getVertices()->size();
+    int                           s     = source->getId();
+    std::vector<std::vector<int>> buckets(1, std::vector<int>(1, s));
+    std::vector<int>              frontier;
+    std::vector<double>           lengths;
+    std::vector<int>              settled;
+    std::vector<int>              stamp(n, -1);                                          /* last round in which the vertex was taken from a bucket */
+    std::vector<std::size_t>      taken(n, std::numeric_limits<std::size_t>::max());    /* last bucket in which the vertex was taken */
+    int                           round = 0;
+    distances->assign(n, std::numeric_limits<double>::infinity());
+    predecessors->assign(n, -1);
+    double* dist  = distances->data();
+    dist[s]       = 0;
+    /* the first call to neighbors() builds the index, before the tasks share it */
+    cr.neighbors(source);
+    double  width = delta(cr, &lengths);
+    STATS_COUNT(ctx.stats, heap_pushes);
+    for(std::size_t i=0 ; i<buckets.size() ; i++) {
+        settled.clear();
+        while(!buckets[i].empty()) {
+            if(ctx.cancelled()) return false;
+            std::vector<int> bucket;
+            bucket.swap(buckets[i]);
+            frontier.clear();
+            round++;
+            /* skips the copies and the vertices that moved to a closer bucket */
+            for(int v : bucket) {
+                if(stamp[v]==round || static_cast<std::size_t>(dist[v]/width)!=i) continue;
+                stamp[v] = round;
+                frontier.push_back(v);
+                if(taken[v]!=i) {
+                    taken[v] = i;
+                    settled.push_back(v);
+                }
+            }
+            STATS_ADD(ctx.stats, heap_pops, frontier.size());
+            relax(cr, ctx, frontier, lengths, width, true, dist, &buckets);
+        }
+        STATS_ADD(ctx.stats, vertices_settled, settled.size());
+        relax(cr, ctx, settled, lengths, width, false, dist, &buckets);
+        std::vector<int>().swap(buckets[i]);
+    }
+    /* the predecessor of a vertex is its closest neighbor on a shortest path, of smallest identifier */
+    const std::vector<Vertex*>& vertices = *r.getVertices();
+    int                         chunks   = nb_tasks(n);
+    int*                        pred     = predecessors->data();
+    pred[s] = s;
+    ThreadPool::get()->parallel_for(chunks, [&](int c) {
+        for(std::size_t v=n*c/chunks ; v<n*(c+1)/chunks ; v++) {
+            if(static_cast<int>(v)==s || dist[v]==std::numeric_limits<double>::infinity()) continue;
+            for(const Neighbor& nb : cr.neighbors(vertices[v])) {
+                int u = nb.vertex->getId();
+                if(dist[u]<dist[v] && O::follows(cr, nb.edge, nb.vertex) && dist[u]+lengths[nb.edge->getId()]==dist[v]) {
+                    pred[v] = u;
+                    break;
+                }
+            }
+        }
+    });
+    return true;
+}
+
+/*
+Computes the length of every edge, by identifier, and returns the width
+of the buckets: SSSP_DELTA_FACTOR times the mean length, or 1 if there
+is no edge.
+*/
+template<typename R, typename O>
+double Algorithms::DeltaStepping<R, O>::delta(const R& r, std::vector<double>* lengths) {
+    const std::vector<Edge*>& edges  = *r.getEdges();
+    std::size_t               m      = edges.size();
+    int                       chunks = nb_tasks(m);
+    std::vector<double>       sums(chunks, 0);
+    lengths->resize(m);
+    ThreadPool::get()->parallel_for(chunks, [&](int c) {
+        for(std::size_t e=m*c/chunks ; e<m*(c+1)/chunks ; e++) {
+            (*lengths)[e]  = r.get_v1(edges[e])->distanceTo(r.get_v2(edges[e]));
+            sums[c]       += (*lengths)[e];
+        }
+    });
+    double sum = 0;
+    for(double s : sums) sum += s;
+    return sum>0 ? Constants::SSSP_DELTA_FACTOR*sum/m : 1;
+}
+
+/*
+Relaxes in parallel the light (no longer than width) or heavy arcs out
+of the given vertices. A shorter distance is written with a compare and
+swap, and the vertex is added to the bucket of its new distance.
+*/
+template<typename R, typename O>
+void Algorithms::DeltaStepping<R, O>::relax(const R& r, const Context& ctx, const std::vector<int>& from, const std::vector<double>& lengths, double width, bool light, double* dist, std::vector<std::vector<int>>* buckets) {
+    typedef std::vector<std::pair<std::size_t, int>> Moves;
+    const std::vector<Vertex*>& vertices = *r.getVertices();
+    int                         chunks   = nb_tasks(from.size());
+    std::vector<std::size_t>    edges(chunks, 0);
+    std::vector<Moves>          moves(chunks);
+    ThreadPool::get()->parallel_for(chunks, [&](int c) {
+        for(std::size_t i=from.size()*c/chunks ; i<from.size()*(c+1)/chunks ; i++) {
+            const Vertex* u = vertices[from[i]];
+            double        du;
+            __atomic_load(&dist[from[i]], &du, __ATOMIC_RELAXED);
+            for(const Neighbor& nb : r.neighbors(u)) {
+                if(!O::follows(r, nb.edge, u)) continue;
+                double w = lengths[nb.edge->getId()];
+                if((w<=width)!=light) continue;
+                edges[c]++;
+                int    v = nb.vertex->getId();
+                double d = du+w;
+                double current;
+                __atomic_load(&dist[v], &current, __ATOMIC_RELAXED);
+                while(d<current) {
+                    if(__atomic_compare_exchange(&dist[v], &current, &d, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                        moves[c].push_back(std::make_pair(static_cast<std::size_t>(d/width), v));
+                        break;
+                    }
+                }
+            }
+        }
+    });
+    for(int c=0 ; c<chunks ; c++) {
+        STATS_ADD(ctx.stats, edges_relaxed, edges[c]);
+        STATS_ADD(ctx.stats, heap_pushes, moves[c].size());
+        for(const std::pair<std::size_t, int>& m : moves[c]) {
+            if(m.first>=buckets->size()) buckets->resize(m.first+1);
+            (*buckets)[m.first].push_back(m.second);
+        }
+    }
+}
+
+/*
+Dijkstra algorithm. While there is an unvisited vertex, select the one
+with minimum cost and study its neighbors. Stops when the current vertex
+is the destination. The costs never decrease, so the vertices wait in a
+radix heap; a vertex is pushed again when its cost decreases, and the
+entries of the vertices already visited are skipped.
+*/
+template<typename R, typename O>
+template<typename V>
+std::vector<const Edge*>* Algorithms::Dijkstra<R, O>::run(R& r, const Context& ctx, const V& visitor, const Vertex* source, const Vertex* destination) {
+    std::size_t  n          = r.getVertices()->size();
+    bool         path_found = false;
+    Workspace&   w          = *ctx.workspace;
+    /* initialization */
+    w.costs.assign(n, std::numeric_limits<double>::infinity());
+    w.previous.assign(n, 0);
+    w.visited.assign(n, 0);
+    w.heap.clear();
+    w.costs[source->getId()] = 0;
+    w.heap.push(0, source);
+    STATS_COUNT(ctx.stats, heap_pushes);
+    while(!w.heap.empty() && !ctx.cancelled()) {
+        /* extracts the vertex with minimum cost */
+        const Vertex* v_min = w.heap.pop().second;
+        STATS_COUNT(ctx.stats, heap_pops);
+        if(w.visited[v_min->getId()]) continue;
+        w.visited[v_min->getId()] = 1;
+        visitor.on_settle(v_min);
+        STATS_COUNT(ctx.stats, vertices_settled);
+        /* stop if destination is found */
+        if(v_min==destination) {
+            path_found = true;
+            break;
+        }
+        /* same treatment for all neighbors */
+        for(const Neighbor& nb : r.neighbors(v_min)) {
+            const Vertex* v = nb.vertex;
+            if(O::follows(r, nb.edge, v_min) && !w.visited[v->getId()]) {
+                STATS_COUNT(ctx.stats, edges_relaxed);
+                visitor.on_relax(nb.edge);
+                visitor.on_discover(v);
+                double diff = w.costs[v_min->getId()] + v_min->distanceTo(v);
+                if(diff<w.costs[v->getId()]) {
+                    w.costs[v->getId()]    = diff;
+                    w.previous[v->getId()] = v_min;
+                    w.heap.push(diff, v);
+                    STATS_COUNT(ctx.stats, heap_pushes);
+                }
+            }
+        }
+    }
+    /* prints the path */
+    if(path_found) {
+        const Vertex* v = destination;
+        std::vector<const Edge*>* path = new std::vector<const Edge*>;
+        while(v!=source) {
+            Edge* e = r.edge(v->getId(), w.previous[v->getId()]->getId());
+            visitor.on_path_edge(e);
+            path->push_back(e);
+            v = w.previous[v->getId()];
+            visitor.on_path_vertex(v);
+        }
+        return path;
+    }
+    else {
+        return 0;
+    }
+}
+
+/*
+Edmonds Karp algorithm. While there is a path from source to sink, find
+the smallest capacity of the path, add it to the max_flow and to every
+reverse edge of the path, and remove it from every edge in the path. When
+no more path is found, max_flow has the maximum flow and is returned.
+The capacities are updated on a copy of the representation, and the
+shortest paths are found by Bfs::search() on the arcs with a positive
+capacity left. Both ways of every edge are arcs of the residual network,
+whatever the orientation: against the orientation an arc has no
+capacity until flow is sent the other way, which it can then cancel.
+*/
+template<typename R, typename O>
+template<typename V>
+typename Algorithms::EdmondsKarp<R, O>::result_type Algorithms::EdmondsKarp<R, O>::run(R& r, const Context& ctx, const V& visitor, const Vertex* source, const Vertex* sink) {
+    result_type      max_flow = 0;
+    R                residual(r);
+    const R&         cr       = residual;
+    int              s        = source->getId();
+    int              t        = sink->getId();
+    std::vector<int> hops;
+    std::vector<int> parents;
+    auto positive = [&cr](const Vertex* from, const Vertex* to, const Edge*) { return cr.capacity(from->getId(), to->getId())>0; };
+    /* While there is a path from source to sink */
+    while(!ctx.cancelled() && Bfs<R, O>::search(cr, ctx, positive, s, t, &hops, &parents)) {
+        /* adds the path capacity to the max flow */
+        STATS_COUNT(ctx.stats, augmenting_paths);
+        W flow = residual.capacity(parents[t], t);
+        for(int v=parents[t] ; v!=s ; v=parents[v]) flow = std::min<W>(flow, residual.capacity(parents[v], v));
+        max_flow += flow;
+        /* updates the capacities */
+        for(int v=t ; v!=s ; v=parents[v]) {
+            int p = parents[v];
+            visitor.on_path_edge(residual.edge(v, p));
+            residual.set_capacity(p, v, residual.capacity(p, v)-flow);
+            residual.set_capacity(v, p, residual.capacity(v, p)+flow);
+        }
+    }
+    return max_flow;
+}
+
+/*
+Ford Fulkerson algorithm. While there is a path from source to sink, find
+the smallest capacity of the path, add it to the max_flow and to every reverse
+edge of the path, and remove it from every edge in the path. When no more path
+is found, max_flow has the maximum flow and is returned. The capacities are
+updated on a copy of the representation.
+*/
+template<typename R, typename O>
+template<typename V>
+typename Algorithms::FordFulkerson<R, O>::result_type Algorithms::FordFulkerson<R, O>::run(R& r, const Context& ctx, const V& visitor, const Vertex* source, const Vertex* sink) {
+    result_type                max_flow   = 0;
+    R                          residual(r);
+    const Vertex*              res_source = residual.getVertices()->at(source->getId());
+    const Vertex*              res_sink   = residual.getVertices()->at(sink->getId());
+    std::vector<const Vertex*> path;
+    std::set<const Vertex*>    visited;
+    /* While there is a path from source to sink */
+    bool valid_path = true;
+    do {
+        visited.clear();
+        visited.insert(res_source);
+        path.clear();
+        path.push_back(res_source);
+        valid_path = dfs(residual, ctx, visitor, &path, &visited, res_source, res_sink);
+        if(valid_path) {
+            /* finds the minimum capacity */
+            W min_flow = residual.capacity(res_source->getId(), path.at(1)->getId());
+            for(std::vector<const Vertex*>::iterator it=path.begin() ; it!=path.end() ; it++) {
+                if(*it!=res_sink) {
+                    visitor.on_path_edge(residual.edge((*it)->getId(), (*(it+1))->getId()));
+                    W f = residual.capacity((*it)->getId(), (*(it+1))->getId());
+                    if(f<min_flow) min_flow = f;
+                }
+            }
+            /* adds the capacity to the max flow */
+            STATS_COUNT(ctx.stats, augmenting_paths);
+            max_flow += min_flow;
+            /* updates the capacities */
+            for(std::vector<const Vertex*>::iterator it=path.begin() ; it!=path.end() ; it++) {
+                if(*it!=res_sink) {
+                    int id1 = (*it)->getId();
+                    int id2 = (*(it+1))->getId();
+                    residual.set_capacity(id1, id2, residual.capacity(id1, id2)-min_flow);
+                    residual.set_capacity(id2, id1, residual.capacity(id2, id1)+min_flow);
+                }
+            }
+        }
+    } while(valid_path && !ctx.cancelled());
+    return max_flow;
+}
+
+/*
+Ford Fulkerson depth-first search. Tries to find a valid path from source
+to sink and returns true if a path is found. Otherwise returns false.
+The search is DFS which makes it inefficient. Edmonds-Karp advantage is to
+perform a BFS which overall reduces the running time. A vertex from which
+the sink could not be reached stays visited, otherwise the search would
+go through every simple path. As in Edmonds-Karp, every edge is followed
+both ways when its residual capacity allows it.
+*/
+template<typename R, typename O>
+template<typename V>
+bool Algorithms::FordFulkerson<R, O>::dfs(R& r, const Context& ctx, const V& visitor, std::vector<const Vertex*>* path, std::set<const Vertex*>* visited, const Vertex* source, const Vertex* sink) {
+    if(ctx.cancelled()) return false;
+    STATS_COUNT(ctx.stats, recursion_nodes);
+    const Vertex* back = path->back();
+    for(const Neighbor& n : r.neighbors(back)) {
+        const Vertex* v = n.vertex;
+        STATS_COUNT(ctx.stats, edges_relaxed);
+        visitor.on_relax(n.edge);
+        if(r.capacity(back->getId(), v->getId())>0) {
+            if(v==sink) {
+                path->push_back(v);
+                return true;
+            }
+            else if(v!=source && visited->count(v)==0) {
+                visitor.on_discover(v);
+                path->push_back(v);
+                visited->insert(v);
+                if(dfs(r, ctx, visitor, path, visited, source, sink)) {
+                    return true;
+                }
+                else {
+                    path->erase((path->end()-1));
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/*
+Prim algorithm. While there are edges in the heap, select the one with
+less capacity, include it in the subgraph if it reaches a new vertex
+and add the edges of that vertex. Only the edges to vertices out of the
+tree are pushed, and those whose two ends joined the tree meanwhile are
+skipped; ties are broken by the ids of the edges. It returns the
+minimal covering graph.
+*/
+template<typename R, typename O>
+template<typename V>
+std::vector<const Edge*>* Algorithms::Prim<R, O>::run(R& r, const Context& ctx, const V& visitor) {
+    typedef std::pair<Weight, const Edge*> Candidate;
+    Workspace&                w         = *ctx.workspace;
+    std::vector<const Edge*> *sub_graph = new std::vector<const Edge*>;
+    /* greater, so that the heap functions keep the cheapest edge on top */
+    auto heavier = [](const Candidate& c1, const Candidate& c2) {
+        return c2.first<c1.first || (!(c1.first<c2.first) && c2.second->getId()<c1.second->getId());
+    };
+    /* adds a vertex to the tree and its edges to the other vertices */
+    auto add_adjacent_edges = [&](const Vertex* v) {
+        w.visited[v->getId()] = 1;
+        for(const Neighbor& nb : r.neighbors(v)) {
+            if(w.visited[nb.vertex->getId()]) continue;
+            w.edges.push_back(Candidate(r.get_capacity_v1_to_v2(nb.edge), nb.edge));
+            std::push_heap(w.edges.begin(), w.edges.end(), heavier);
+            STATS_COUNT(ctx.stats, heap_pushes);
+        }
+    };
+    w.visited.assign(r.getVertices()->size(), 0);
+    w.edges.clear();
+    /* begin with a random Vertex */
+    add_adjacent_edges(r.getVertices()->at(0));
+    while(!w.edges.empty() && !ctx.cancelled()) {
+        std::pop_heap(w.edges.begin(), w.edges.end(), heavier);
+        const Edge* e_min = w.edges.back().second;
+        w.edges.pop_back();
+        STATS_COUNT(ctx.stats, heap_pops);
+        Vertex* v1 = r.get_v1(e_min);
+        Vertex* v2 = r.get_v2(e_min);
+        if(!w.visited[v1->getId()] || !w.visited[v2->getId()]) {
+            STATS_COUNT(ctx.stats, vertices_settled);
+            sub_graph->push_back(e_min);
+            visitor.on_path_edge(e_min);
+            add_adjacent_edges(w.visited[v1->getId()] ? v2 : v1);
+        }
+    }
+    return sub_graph;
+}
+
+#endif
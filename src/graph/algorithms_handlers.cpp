@@ -21,45 +21,91 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <numeric>
 
+#include "concurrency/ThreadPool.hpp"
 #include "Graph.hpp"
+#include "stats/Trace.hpp"
 
 /*
 A* algorithm handler. Finds the shortest path between two randomly selected
 vertices, display it. It works on single oriented and non oriented graphs.
 */
 std::vector<const Edge*>* Graph::handler_astar(Vertex* source, Vertex* destination) {
-    clear_color();
-    if(!source || !destination) { select_two_random_vertices(const_cast<const Vertex**>(&source), const_cast<const Vertex**>(&destination)); }
-    source->setColor(Constants::EDGE_ALGO_SOURCE_COLOR_R, Constants::EDGE_ALGO_SOURCE_COLOR_G, Constants::EDGE_ALGO_SOURCE_COLOR_B);
-    destination->setColor(Constants::EDGE_ALGO_DESTINATION_COLOR_R, Constants::EDGE_ALGO_DESTINATION_COLOR_G, Constants::EDGE_ALGO_DESTINATION_COLOR_B);
+    TRACE_SCOPE("Graph::handler_astar");
+    prepare_path(&source, &destination);
     return algo_astar(source, destination, true);
 }
 
+/*
+Breadth-first search handler. Prints the number of hops between two
+randomly selected vertices, or the picked ones, and the number of
+vertices that were reached. Returns the hops to every vertex.
+*/
+std::vector<int>* Graph::handler_bfs(Vertex* source, Vertex* destination) {
+    TRACE_SCOPE("Graph::handler_bfs");
+    prepare_path(&source, &destination);
+    std::vector<int>* hops = algo_bfs(source, destination, true);
+    if(!is_cancelled()) {
+        int hop = hops->at(destination->getId());
+        if(hop>=0) std::cout << "hops: " << hop << std::endl;
+        else       std::cout << "destination not reachable" << std::endl;
+        std::cout << "reached vertices: " << std::count_if(hops->begin(), hops->end(), [](int h) { return h>=0; }) << std::endl;
+    }
+    return hops;
+}
+
 /*
 Bron-Kerbosch algorithm handler. The algorithm finds the maximum clique
 of the graph and returns the set of vertices of this clique.
 */
 std::set<const Vertex*>* Graph::handler_bron_kerbosch() {
+    TRACE_SCOPE("Graph::handler_bron_kerbosch");
     clear_color();
-    std::set<const Vertex*>* res = algo_bron_kerbosch();
-    std::cout << "clique number: " << res->size() << std::endl;
+    std::set<const Vertex*>* res = algo_bron_kerbosch(true);
+    if(!is_cancelled()) std::cout << "clique number: " << res->size() << std::endl;
     return res;
 }
 
+/*
+Delta-stepping algorithm handler. Computes the distances from a randomly
+selected vertex, or the picked one, to all the others, prints the one to
+the destination and displays the path. Returns the distances.
+*/
+std::vector<double>* Graph::handler_delta_stepping(Vertex* source, Vertex* destination) {
+    TRACE_SCOPE("Graph::handler_delta_stepping");
+    prepare_path(&source, &destination);
+    std::vector<double>* distances = new std::vector<double>;
+    std::vector<int>     predecessors;
+    if(!algo_delta_stepping(source, distances, &predecessors)) return distances;
+    if(predecessors[destination->getId()]==-1) {
+        std::cout << "destination not reachable" << std::endl;
+    }
+    else {
+        std::cout << "shortest path length: " << distances->at(destination->getId()) << std::endl;
+        for(int v=predecessors[destination->getId()] ; v!=source->getId() ; v=predecessors[v]) {
+            graph_representation->set_color(graph_representation->getVertices()->at(v), Constants::VERTEX_PATH_COLOR_R, Constants::VERTEX_PATH_COLOR_G, Constants::VERTEX_PATH_COLOR_B);
+        }
+        for(int v=destination->getId() ; v!=source->getId() ; v=predecessors[v]) {
+            graph_representation->set_color(graph_representation->get_edge_from_to(predecessors[v], v), Constants::EDGE_ALGO_RESULT_COLOR_R, Constants::EDGE_ALGO_RESULT_COLOR_G, Constants::EDGE_ALGO_RESULT_COLOR_B);
+        }
+    }
+    std::cout << "reached vertices: " << std::count_if(predecessors.begin(), predecessors.end(), [](int p) { return p>=0; }) << std::endl;
+    return distances;
+}
+
 /*
 Dijkstra algorithm handler. Finds the shortest path between two randomly
 selected vertices, display it. It works on single oriented and non oriented
 graphs.
 */
 std::vector<const Edge*>* Graph::handler_dijkstra(Vertex* source, Vertex* destination) {
-    clear_color();
-    if(!source || !destination) { select_two_random_vertices(const_cast<const Vertex**>(&source), const_cast<const Vertex**>(&destination)); }
-    source->setColor(Constants::EDGE_ALGO_SOURCE_COLOR_R, Constants::EDGE_ALGO_SOURCE_COLOR_G, Constants::EDGE_ALGO_SOURCE_COLOR_B);
-    destination->setColor(Constants::EDGE_ALGO_DESTINATION_COLOR_R, Constants::EDGE_ALGO_DESTINATION_COLOR_G, Constants::EDGE_ALGO_DESTINATION_COLOR_B);
-    return algo_dijkstra(source, destination);
+    TRACE_SCOPE("Graph::handler_dijkstra");
+    prepare_path(&source, &destination);
+    return algo_dijkstra(source, destination, true);
 }
 
 /*
@@ -69,15 +115,11 @@ algorithm needs a single-oriented graph with integer flows. If the current
 graph already has this properties, the algorithm is made on the graph,
 otherwise directions and capacities are randomly set.
 */
-int Graph::handler_edmonds_karp(Vertex* source, Vertex* sink) {
-    clear_color();
-    if(orientation==NONE || orientation==TWO_WAYS) { generate_random_arc_directions();         orientation                    = ONE_WAY; }
-    if(!arc_integer_capacities_defined)            { generate_random_arc_integer_capacities(); arc_integer_capacities_defined = true; }
-    if(!source || !sink) { select_two_random_vertices(const_cast<const Vertex**>(&source), const_cast<const Vertex**>(&sink)); }
-    source->setColor(Constants::EDGE_ALGO_SOURCE_COLOR_R, Constants::EDGE_ALGO_SOURCE_COLOR_G, Constants::EDGE_ALGO_SOURCE_COLOR_B);
-    sink->setColor(Constants::EDGE_ALGO_DESTINATION_COLOR_R, Constants::EDGE_ALGO_DESTINATION_COLOR_G, Constants::EDGE_ALGO_DESTINATION_COLOR_B);
-    int res = algo_edmonds_karp(source, sink);
-    std::cout << "maximum flow: " << res << std::endl;
+WeightSum Graph::handler_edmonds_karp(Vertex* source, Vertex* sink) {
+    TRACE_SCOPE("Graph::handler_edmonds_karp");
+    prepare_flow(&source, &sink);
+    WeightSum res = algo_edmonds_karp(source, sink, true);
+    if(!is_cancelled()) std::cout << "maximum flow: " << res << std::endl;
     return res;
 }
 
@@ -88,15 +130,11 @@ a single-oriented graph with integer flows. If the current graph already has
 this properties, the algorithm is made on the graph, otherwise directions and
 capacities are randomly set.
 */
-int Graph::handler_ford_fulkerson(Vertex* source, Vertex* sink) {
-    clear_color();
-    if(orientation==NONE || orientation==TWO_WAYS) { generate_random_arc_directions();         orientation                    = ONE_WAY; }
-    if(!arc_integer_capacities_defined)            { generate_random_arc_integer_capacities(); arc_integer_capacities_defined = true; }
-    if(!source || !sink) { select_two_random_vertices(const_cast<const Vertex**>(&source), const_cast<const Vertex**>(&sink)); }
-    source->setColor(Constants::EDGE_ALGO_SOURCE_COLOR_R, Constants::EDGE_ALGO_SOURCE_COLOR_G, Constants::EDGE_ALGO_SOURCE_COLOR_B);
-    sink->setColor(Constants::EDGE_ALGO_DESTINATION_COLOR_R, Constants::EDGE_ALGO_DESTINATION_COLOR_G, Constants::EDGE_ALGO_DESTINATION_COLOR_B);
-    int res = algo_ford_fulkerson(source, sink);
-    std::cout << "maximum flow: " << res << std::endl;
+WeightSum Graph::handler_ford_fulkerson(Vertex* source, Vertex* sink) {
+    TRACE_SCOPE("Graph::handler_ford_fulkerson");
+    prepare_flow(&source, &sink);
+    WeightSum res = algo_ford_fulkerson(source, sink, true);
+    if(!is_cancelled()) std::cout << "maximum flow: " << res << std::endl;
     return res;
 }
 
@@ -106,29 +144,123 @@ with capacities. The method returns a vector of all the edges in the
 subgraph.
 */
 std::vector<const Edge*>* Graph::handler_prim() {
-    clear_color();
-    if(orientation==ONE_WAY || orientation==TWO_WAYS) { orientation = NONE; }
-    if(!arc_integer_capacities_defined)               { generate_random_arc_integer_capacities(); arc_integer_capacities_defined = true; }
-    std::vector<const Edge*>* sub_graph = algo_prim();
-    double w1 = get_total_weight();
-    double w2 = std::accumulate(sub_graph->begin(), sub_graph->end(), 0, [] (double sum, const Edge* v) { return sum + v->getCapacityV1ToV2(); });
-    std::cout << "initial graph weight: " << w1 << std::endl << "prim graph weight: " << w2 << " (" << 100*w2/w1 << "%)" << std::endl;
+    TRACE_SCOPE("Graph::handler_prim");
+    prepare_prim();
+    std::vector<const Edge*>* sub_graph = algo_prim(true);
+    WeightSum w1 = get_total_weight();
+    WeightSum w2 = std::accumulate(sub_graph->begin(), sub_graph->end(), WeightSum(0), [this](WeightSum sum, const Edge* v) { return sum + graph_representation->get_capacity_v1_to_v2(v); });
+    if(!is_cancelled()) std::cout << "initial graph weight: " << w1 << std::endl << "prim graph weight: " << w2 << " (" << 100.0*w2/w1 << "%)" << std::endl;
     return sub_graph;
 }
 
 /*
 Computes the Traveling Salesman problem given a source and a set of
-destinations. If not provided, those vertices are randomly selected.
+destinations. If not provided, the source is the one picked with the
+mouse, and the vertices are otherwise randomly selected. The solver is
+the exact search, or the heuristic for larger sets of destinations.
 */
-std::vector<const Vertex*>* Graph::handler_traveling_salesman(Vertex* source, std::vector<const Vertex*>* destinations) {
+std::vector<const Vertex*>* Graph::handler_traveling_salesman(Vertex* source, std::vector<const Vertex*>* destinations, TSP_SOLVER solver) {
+    TRACE_SCOPE("Graph::handler_traveling_salesman");
     clear_color();
     if(orientation==ONE_WAY || orientation==TWO_WAYS) { orientation = NONE; }
     bool delete_destinations = false;
-    if(!source)       { select_one_random_vertices(const_cast<const Vertex**>(&source)); }
+    if(!source)       { if(picked_source>=0) source = graph_representation->getVertices()->at(picked_source);
+                        else                 select_one_random_vertices(&rng, const_cast<const Vertex**>(&source)); }
     if(!destinations) { destinations = new std::vector<const Vertex*>;
                         delete_destinations = true;
-                        select_n_random_vertices(&destinations, Constants::GRAPH_NB_VERTICES_TRAVELING_SALESMAN, source); }
-    std::vector<const Vertex*>* res = algo_traveling_salesman(source, destinations);
+                        int nb_destinations = solver==TSP_EXACT ? Constants::GRAPH_NB_VERTICES_TRAVELING_SALESMAN : Constants::GRAPH_NB_VERTICES_TRAVELING_HEURISTIC;
+                        select_n_random_vertices(&rng, &destinations, std::min(nb_destinations, nb_vertices-1), source); }
+    double                      cost = 0;
+    std::vector<const Vertex*>* res  = 0;
+    if(solver==TSP_EXACT) {
+        res = algo_traveling_salesman(source, destinations, &cost, false, true);
+        if(!is_cancelled() && std::isinf(cost)) std::cout << "destinations not reachable" << std::endl;
+        else if(!is_cancelled()) std::cout << "route cost: " << cost << std::endl;
+    }
+    else {
+        double milliseconds = 0;
+        res = algo_traveling_salesman_heuristic(source, destinations, solver, &cost, &milliseconds, true);
+        if(!is_cancelled() && std::isinf(cost)) std::cout << "destinations not reachable" << std::endl;
+        else if(!is_cancelled()) std::cout << "route cost: " << cost << std::endl << "heuristic: " << milliseconds << " ms for " << destinations->size() << " destinations" << std::endl;
+    }
     if(delete_destinations) delete destinations;
     return res;
 }
+
+/*
+Number of hops of the shortest path from source to destination,
+following the orientation of the graph, -1 if there is none.
+*/
+int Graph::hop_distance(const Vertex* source, const Vertex* destination) {
+    std::vector<int>* hops = algo_bfs(source, destination);
+    int               hop  = hops->at(destination->getId());
+    delete hops;
+    return hop;
+}
+
+/*
+True if destination can be reached from source, following the
+orientation of the graph.
+*/
+bool Graph::is_reachable(const Vertex* source, const Vertex* destination) {
+    return hop_distance(source, destination)>=0;
+}
+
+/*
+Value of the maximum flow from source to sink, found by Edmonds-Karp.
+As for the handler, directions and capacities are randomly set first if
+the graph does not have them.
+*/
+WeightSum Graph::max_flow(const Vertex* source, const Vertex* sink) {
+    Vertex* s = const_cast<Vertex*>(source);
+    Vertex* t = const_cast<Vertex*>(sink);
+    prepare_flow(&s, &t);
+    return algo_edmonds_karp(s, t);
+}
+
+/*
+Lengths of the shortest paths from source to every vertex, and the
+vertex before each one on its path, see algo_delta_stepping(). Returns
+false if the run was cancelled.
+*/
+bool Graph::shortest_path_tree(const Vertex* source, std::vector<double>* distances, std::vector<int>* predecessors) {
+    return algo_delta_stepping(source, distances, predecessors);
+}
+
+/*
+Prepares the graph for a flow algorithm. The flow algorithms need a
+single-oriented graph with integer capacities: if the graph does not
+have these properties, directions and capacities are randomly set. If
+not provided, the source and the sink are the vertices picked with the
+mouse, or are randomly selected.
+*/
+void Graph::prepare_flow(Vertex** source, Vertex** sink) {
+    clear_color();
+    if(orientation==NONE || orientation==TWO_WAYS) { generate_random_arc_directions(&rng);         orientation                    = ONE_WAY; }
+    if(!arc_integer_capacities_defined)            { generate_random_arc_integer_capacities(&rng); arc_integer_capacities_defined = true; }
+    if((!*source || !*sink) && !picked_vertices(source, sink)) { select_two_random_vertices(&rng, const_cast<const Vertex**>(source), const_cast<const Vertex**>(sink)); }
+    graph_representation->set_color(*source, Constants::EDGE_ALGO_SOURCE_COLOR_R, Constants::EDGE_ALGO_SOURCE_COLOR_G, Constants::EDGE_ALGO_SOURCE_COLOR_B);
+    graph_representation->set_color(*sink, Constants::EDGE_ALGO_DESTINATION_COLOR_R, Constants::EDGE_ALGO_DESTINATION_COLOR_G, Constants::EDGE_ALGO_DESTINATION_COLOR_B);
+}
+
+/*
+Prepares the graph for a shortest path algorithm. If not provided, the
+source and the destination are the vertices picked with the mouse, or
+are randomly selected.
+*/
+void Graph::prepare_path(Vertex** source, Vertex** destination) {
+    clear_color();
+    if((!*source || !*destination) && !picked_vertices(source, destination)) { select_two_random_vertices(&rng, const_cast<const Vertex**>(source), const_cast<const Vertex**>(destination)); }
+    graph_representation->set_color(*source, Constants::EDGE_ALGO_SOURCE_COLOR_R, Constants::EDGE_ALGO_SOURCE_COLOR_G, Constants::EDGE_ALGO_SOURCE_COLOR_B);
+    graph_representation->set_color(*destination, Constants::EDGE_ALGO_DESTINATION_COLOR_R, Constants::EDGE_ALGO_DESTINATION_COLOR_G, Constants::EDGE_ALGO_DESTINATION_COLOR_B);
+}
+
+/*
+Prepares the graph for the Prim algorithm, which needs a non oriented
+graph with capacities.
+*/
+void Graph::prepare_prim() {
+    clear_color();
+    if(orientation==ONE_WAY || orientation==TWO_WAYS) { orientation = NONE; }
+    if(!arc_integer_capacities_defined)               { generate_random_arc_integer_capacities(&rng); arc_integer_capacities_defined = true; }
+}
@@ -0,0 +1,241 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "concurrency/ThreadPool.hpp"
+#include "Graph.hpp"
+#include "stats/CacheCounter.hpp"
+
+/*
+Vertices the algorithms run on, by identifier, so that the same ones
+are used once the vertices are reordered.
+*/
+struct BenchQuery {
+    int              destination;   /* destination of the paths, sink of the flows */
+    int              source;        /* source of the paths and flows, first stop of the routes */
+    std::vector<int> stops;         /* other stops of the routes */
+};
+
+/*
+Algorithm of the benchmark. The flow algorithms run on a copy of the
+graph with directions and capacities. The algorithms run without
+rendering, and return a value printed once the runs are over.
+*/
+struct BenchAlgorithm {
+    const char*                                      name;       /* name printed with the times */
+    bool                                             flow;       /* true if it runs on the graph with directions */
+    const char*                                      result;     /* what the value returned by run is */
+    std::function<double(Graph*, const BenchQuery&)> run;        /* runs the algorithm on a copy of the graph */
+    const char*                                      parallel;   /* if set, the parallel algorithm this one is the sequential version of */
+};
+
+/*
+Milliseconds elapsed since start.
+*/
+static double milliseconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()-start).count();
+}
+
+/*
+Vertex of the graph with the given identifier.
+*/
+static Vertex* vertex_of(Graph* g, int id) {
+    return g->getGraphRepresentation()->getVertices()->at(id);
+}
+
+/*
+The first n stops of the query, in the graph.
+*/
+static std::vector<const Vertex*> stops_of(Graph* g, const BenchQuery& q, int n) {
+    std::vector<const Vertex*> stops;
+    for(int i=0 ; i<n && i<static_cast<int>(q.stops.size()) ; i++) stops.push_back(vertex_of(g, q.stops[i]));
+    return stops;
+}
+
+/*
+Runs each algorithm BENCH_RUNS times on a copy of the graph and prints
+the best and mean times, with the mean number of cache misses if the
+processor counters are available and the result of the last run,
+followed by the counters of the last run when they are compiled in. The
+sequential version of a parallel algorithm also gets the speedup of the
+parallel one, its best time over the best time of the parallel one.
+Only the algorithm is timed, the copy and the output are not.
+*/
+static void run_algorithms(const std::vector<BenchAlgorithm>& algorithms, const Graph& graph, const Graph& flows, const BenchQuery& query) {
+    CacheCounter                  misses;
+    std::map<std::string, double> best_times;
+    for(const BenchAlgorithm& a : algorithms) {
+        double             best         = 0;
+        double             total        = 0;
+        unsigned long long total_misses = 0;
+        double             result       = 0;
+        AlgorithmStats     stats;
+        for(int run=0 ; run<Constants::BENCH_RUNS ; run++) {
+            Graph copy(a.flow ? flows : graph);
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            misses.start();
+            result        = a.run(&copy, query);
+            total_misses += misses.stop();
+            double time   = milliseconds_since(start);
+            total        += time;
+            if(run==0 || time<best) best = time;
+            stats = copy.last_run_stats();
+        }
+        std::cout << a.name << ": best " << best << " ms, mean " << total/Constants::BENCH_RUNS << " ms";
+        if(misses.available()) std::cout << ", " << total_misses/Constants::BENCH_RUNS << " cache misses";
+        std::cout << ", " << a.result << " " << result;
+        best_times[a.name] = best;
+        if(a.parallel && best_times.count(a.parallel) && best_times[a.parallel]>0) {
+            std::cout << ", speedup of " << a.parallel << " " << best/best_times[a.parallel] << " with " << ThreadPool::get()->getNbThreads() << " threads";
+        }
+        std::cout << std::endl;
+#ifdef GRAPHS_STATS
+        std::cout << stats << std::endl;
+#endif
+    }
+}
+
+/*
+Benchmark of the algorithms on graphs built by the given generator, for
+each of the given numbers of vertices. Each algorithm runs BENCH_RUNS
+times on a copy of the graph, on the same random vertices. The
+capacities and the directions used by the flows are set before, so that
+they are not timed. The whole suite then runs again with the vertices
+renumbered in each of the given orders, on the same vertices, capacities
+and directions, to measure the effect of the order on the times and the
+cache misses.
+*/
+void Graph::benchmark(GRAPH_TYPE type, GRAPH_GENERATOR generator, const std::vector<int>& sizes, const std::vector<VERTEX_ORDERING>& orderings) {
+    const int nb_exact     = Constants::GRAPH_NB_VERTICES_TRAVELING_SALESMAN;
+    const int nb_heuristic = Constants::GRAPH_NB_VERTICES_TRAVELING_HEURISTIC;
+    const std::vector<BenchAlgorithm> algorithms = {
+        {"astar",                         false, "path edges", [](Graph* g, const BenchQuery& q) {
+            std::vector<const Edge*>* path = g->algo_astar(vertex_of(g, q.source), vertex_of(g, q.destination));
+            double                    res  = path ? path->size() : 0;
+            delete path;
+            return res;
+        }},
+        {"bfs",                           false, "hops", [](Graph* g, const BenchQuery& q) {
+            std::vector<int>* hops = g->algo_bfs(vertex_of(g, q.source), vertex_of(g, q.destination));
+            double            res  = hops->at(q.destination);
+            delete hops;
+            return res;
+        }},
+        {"bron-kerbosch",                 false, "clique number", [](Graph* g, const BenchQuery&) {
+            std::set<const Vertex*>* clique = g->algo_bron_kerbosch();
+            double                   res    = clique->size();
+            delete clique;
+            return res;
+        }},
+        {"delta-stepping",                false, "shortest path length", [](Graph* g, const BenchQuery& q) {
+            std::vector<double> distances;
+            std::vector<int>    predecessors;
+            g->algo_delta_stepping(vertex_of(g, q.source), &distances, &predecessors);
+            return distances[q.destination];
+        }},
+        {"dijkstra",                      false, "path edges", [](Graph* g, const BenchQuery& q) {
+            std::vector<const Edge*>* path = g->algo_dijkstra(vertex_of(g, q.source), vertex_of(g, q.destination));
+            double                    res  = path ? path->size() : 0;
+            delete path;
+            return res;
+        }},
+        {"edmonds-karp",                  true,  "maximum flow", [](Graph* g, const BenchQuery& q) {
+            return static_cast<double>(g->algo_edmonds_karp(vertex_of(g, q.source), vertex_of(g, q.destination)));
+        }},
+        {"ford-fulkerson",                true,  "maximum flow", [](Graph* g, const BenchQuery& q) {
+            return static_cast<double>(g->algo_ford_fulkerson(vertex_of(g, q.source), vertex_of(g, q.destination)));
+        }},
+        {"prim",                          false, "tree edges", [](Graph* g, const BenchQuery&) {
+            std::vector<const Edge*>* tree = g->algo_prim();
+            double                    res  = tree->size();
+            delete tree;
+            return res;
+        }},
+        {"traveling-salesman",            false, "route cost", [nb_exact](Graph* g, const BenchQuery& q) {
+            std::vector<const Vertex*> stops = stops_of(g, q, nb_exact);
+            double                     cost  = 0;
+            delete g->algo_traveling_salesman(vertex_of(g, q.source), &stops, &cost);
+            return cost;
+        }},
+        {"traveling-salesman-heuristic",  false, "route cost", [nb_heuristic](Graph* g, const BenchQuery& q) {
+            std::vector<const Vertex*> stops = stops_of(g, q, nb_heuristic);
+            double                     cost  = 0;
+            delete g->algo_traveling_salesman_heuristic(vertex_of(g, q.source), &stops, TSP_NEAREST_NEIGHBOR, &cost);
+            return cost;
+        }},
+        {"traveling-salesman-sequential", false, "route cost", [nb_exact](Graph* g, const BenchQuery& q) {
+            std::vector<const Vertex*> stops = stops_of(g, q, nb_exact);
+            double                     cost  = 0;
+            delete g->algo_traveling_salesman(vertex_of(g, q.source), &stops, &cost, true);
+            return cost;
+        }, "traveling-salesman"}
+    };
+    for(int n : sizes) {
+        Graph graph(type, n);
+        graph.setGenerator(generator);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        graph.generate();
+        std::cout << "== " << generator_name(generator) << ", " << n << " vertices, " << graph.graph_representation->getEdges()->size() << " edges, generated in " << milliseconds_since(start) << " ms" << std::endl;
+        
+        /* vertices, capacities and directions shared by all the orders */
+        const Vertex*               source;
+        const Vertex*               destination;
+        std::vector<const Vertex*>  stops;
+        std::vector<const Vertex*>* stops_pointer = &stops;
+        graph.select_two_random_vertices(&graph.rng, &source, &destination);
+        graph.select_n_random_vertices(&graph.rng, &stops_pointer, std::min(nb_heuristic, n-1), source);
+        graph.generate_random_arc_integer_capacities(&graph.rng);
+        graph.arc_integer_capacities_defined = true;
+        Graph flows(graph);
+        flows.generate_random_arc_directions(&flows.rng);
+        flows.orientation = ONE_WAY;
+        BenchQuery query;
+        query.destination = destination->getId();
+        query.source      = source->getId();
+        for(const Vertex* v : stops) query.stops.push_back(v->getId());
+        run_algorithms(algorithms, graph, flows, query);
+        
+        /* same suite, on the same vertices renumbered */
+        for(VERTEX_ORDERING o : orderings) {
+            Graph reordered(graph);
+            Graph reordered_flows(flows);
+            start = std::chrono::steady_clock::now();
+            std::vector<int> permutation = reordered.reorder(o);
+            std::cout << "-- " << ordering_name(o) << " order, vertices renumbered in " << milliseconds_since(start) << " ms" << std::endl;
+            reordered_flows.reorder(o);
+            BenchQuery translated;
+            translated.destination = permutation[query.destination];
+            translated.source      = permutation[query.source];
+            for(int id : query.stops) translated.stops.push_back(permutation[id]);
+            run_algorithms(algorithms, reordered, reordered_flows, translated);
+        }
+    }
+}
@@ -0,0 +1,268 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "concurrency/ThreadPool.hpp"
+#include "Graph.hpp"
+#include "stats/Trace.hpp"
+
+typedef std::vector<std::pair<int, int>> EdgeList;
+
+/*
+Runs f on the chunks 0 to GENERATOR_CHUNKS-1 in parallel. Chunk c draws
+from stream c of a generator split from rng, and writes its edges in
+the list of index c, so that the result only depends on the seed.
+*/
+static void run_chunks(Philox* rng, std::vector<EdgeList>* chunks, const std::function<void(int, Philox*, EdgeList*)>& f) {
+    Philox base = rng->split();
+    chunks->assign(Constants::GENERATOR_CHUNKS, EdgeList());
+    ThreadPool::get()->parallel_for(Constants::GENERATOR_CHUNKS, [&](int c) {
+        Philox stream = base.stream(c);
+        f(c, &stream, &(*chunks)[c]);
+    });
+}
+
+/*
+Concatenates the edges of the chunks, in order.
+*/
+static void concatenate(std::vector<EdgeList>* chunks, EdgeList* edges) {
+    std::size_t total = 0;
+    for(const EdgeList& c : *chunks) total += c.size();
+    edges->reserve(total);
+    for(EdgeList& c : *chunks) {
+        edges->insert(edges->end(), c.begin(), c.end());
+        EdgeList().swap(c);
+    }
+}
+
+/*
+Draws n points uniformly in the area, in parallel.
+*/
+static void random_points(Philox* rng, int n, std::vector<std::pair<double, double>>* points) {
+    Philox base = rng->split();
+    points->resize(n);
+    ThreadPool::get()->parallel_for(Constants::GENERATOR_CHUNKS, [&](int c) {
+        Philox stream = base.stream(c);
+        int    begin  = static_cast<int>(static_cast<long long>(n)*c/Constants::GENERATOR_CHUNKS);
+        int    end    = static_cast<int>(static_cast<long long>(n)*(c+1)/Constants::GENERATOR_CHUNKS);
+        for(int i=begin ; i<end ; i++) {
+            (*points)[i].first  = (stream.uniform()-0.5)*Constants::AREA_WIDTH/1000;
+            (*points)[i].second = (stream.uniform()-0.5)*Constants::AREA_HEIGHT/1000;
+        }
+    });
+}
+
+/*
+Name of a generator, for the command line and the console.
+*/
+const char* Graph::generator_name(GRAPH_GENERATOR generator) {
+    switch(generator) {
+        case GABRIEL     : return "gabriel";
+        case GRID        : return "grid";
+        case GEOMETRIC   : return "geometric";
+        case ERDOS_RENYI : return "erdos-renyi";
+        case RMAT        : return "rmat";
+    }
+    return "unknown";
+}
+
+/*
+Finds the generator with the given name. Returns false if there is none.
+*/
+bool Graph::parse_generator(const char* name, GRAPH_GENERATOR* generator) {
+    for(GRAPH_GENERATOR g : {GABRIEL, GRID, GEOMETRIC, ERDOS_RENYI, RMAT}) {
+        if(!strcmp(name, generator_name(g))) {
+            *generator = g;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+Erdos-Renyi graph G(n, m), with m = GENERATOR_DEGREE*n/2 edges chosen
+uniformly among the n(n-1)/2 pairs. The pairs are numbered row by row
+and split in chunks. Each chunk keeps every pair with a probability p
+slightly above m over the number of pairs, jumping from a kept pair to
+the next one with a geometric skip (Batagelj and Brandes), so the time
+is linear in the number of edges. m pairs are then picked uniformly
+among the kept ones, which gives a uniform G(n, m).
+*/
+void Graph::generate_erdos_renyi(int nb_vertices, Philox* rng, std::vector<std::pair<double, double>>* points, EdgeList* edges) {
+    TRACE_SCOPE("Graph::generate_erdos_renyi");
+    random_points(rng, nb_vertices, points);
+    if(nb_vertices<2) return;
+    uint64_t nb_pairs = static_cast<uint64_t>(nb_vertices)*(nb_vertices-1)/2;
+    uint64_t m        = std::min(nb_pairs, static_cast<uint64_t>(Constants::GENERATOR_DEGREE*nb_vertices/2));
+    double   p        = (m+4*std::sqrt(static_cast<double>(m))+8)/nb_pairs;
+    while(edges->size()<m) {
+        std::vector<EdgeList> chunks;
+        double                log_q = std::log(1-std::min(p, 1.0));
+        run_chunks(rng, &chunks, [&](int c, Philox* stream, EdgeList* chunk) {
+            uint64_t begin = nb_pairs/Constants::GENERATOR_CHUNKS*c + std::min<uint64_t>(c, nb_pairs%Constants::GENERATOR_CHUNKS);
+            uint64_t end   = begin + nb_pairs/Constants::GENERATOR_CHUNKS + (static_cast<uint64_t>(c)<nb_pairs%Constants::GENERATOR_CHUNKS);
+            for(uint64_t i=begin ; ; i++) {
+                if(p<1) {
+                    double skip = std::floor(std::log(1-stream->uniform())/log_q);
+                    if(skip>=static_cast<double>(end-i)) break;
+                    i += static_cast<uint64_t>(skip);
+                }
+                if(i>=end) break;
+                uint64_t u = static_cast<uint64_t>((1+std::sqrt(1+8.0*i))/2);
+                while(u*(u-1)/2>i)  u--;
+                while(u*(u+1)/2<=i) u++;
+                chunk->push_back(std::make_pair(static_cast<int>(u), static_cast<int>(i-u*(u-1)/2)));
+            }
+        });
+        edges->clear();
+        concatenate(&chunks, edges);
+        p *= 1.5;
+    }
+    for(uint64_t i=0 ; i<m ; i++) std::swap((*edges)[i], (*edges)[i+rng->uniform_int(static_cast<uint32_t>(edges->size()-i))]);
+    edges->resize(m);
+    std::sort(edges->begin(), edges->end());
+}
+
+/*
+Random geometric graph: vertices drawn uniformly in the area, linked
+when they are closer than the radius giving an average degree of
+GENERATOR_DEGREE. The vertices are sorted in a list of cells of the
+size of the radius, so that each vertex is only compared to the
+vertices of the 3x3 cells around it.
+*/
+void Graph::generate_geometric(int nb_vertices, Philox* rng, std::vector<std::pair<double, double>>* points, EdgeList* edges) {
+    TRACE_SCOPE("Graph::generate_geometric");
+    random_points(rng, nb_vertices, points);
+    if(nb_vertices<2) return;
+    double           width  = static_cast<double>(Constants::AREA_WIDTH)/1000;
+    double           height = static_cast<double>(Constants::AREA_HEIGHT)/1000;
+    double           radius = std::sqrt(Constants::GENERATOR_DEGREE*width*height/(M_PI*nb_vertices));
+    int              nb_x   = std::max(1, static_cast<int>(width/radius));
+    int              nb_y   = std::max(1, static_cast<int>(height/radius));
+    std::vector<int> offsets(static_cast<std::size_t>(nb_x)*nb_y+1, 0);
+    std::vector<int> cells(nb_vertices);
+    std::vector<int> sorted(nb_vertices);
+    for(int i=0 ; i<nb_vertices ; i++) {
+        int cx   = std::min(nb_x-1, static_cast<int>(((*points)[i].first+width/2)/width*nb_x));
+        int cy   = std::min(nb_y-1, static_cast<int>(((*points)[i].second+height/2)/height*nb_y));
+        cells[i] = cy*nb_x+cx;
+        offsets[cells[i]+1]++;
+    }
+    for(std::size_t c=1 ; c<offsets.size() ; c++) offsets[c] += offsets[c-1];
+    std::vector<int> position(offsets.begin(), offsets.end()-1);
+    for(int i=0 ; i<nb_vertices ; i++) sorted[position[cells[i]]++] = i;
+    std::vector<EdgeList> chunks;
+    run_chunks(rng, &chunks, [&](int c, Philox*, EdgeList* chunk) {
+        int begin = static_cast<int>(static_cast<long long>(nb_vertices)*c/Constants::GENERATOR_CHUNKS);
+        int end   = static_cast<int>(static_cast<long long>(nb_vertices)*(c+1)/Constants::GENERATOR_CHUNKS);
+        for(int u=begin ; u<end ; u++) {
+            int cx = cells[u]%nb_x;
+            int cy = cells[u]/nb_x;
+            for(int y=std::max(0, cy-1) ; y<=std::min(nb_y-1, cy+1) ; y++) {
+                for(int x=std::max(0, cx-1) ; x<=std::min(nb_x-1, cx+1) ; x++) {
+                    for(int k=offsets[y*nb_x+x] ; k<offsets[y*nb_x+x+1] ; k++) {
+                        int    v  = sorted[k];
+                        double dx = (*points)[u].first-(*points)[v].first;
+                        double dy = (*points)[u].second-(*points)[v].second;
+                        if(v>u && dx*dx+dy*dy<radius*radius) chunk->push_back(std::make_pair(u, v));
+                    }
+                }
+            }
+        }
+    });
+    concatenate(&chunks, edges);
+}
+
+/*
+Square grid filled row by row, each vertex being linked to its right and
+bottom neighbors. The edges get random integer capacities, drawn as in
+generate_random_arc_integer_capacities().
+*/
+void Graph::generate_grid(int nb_vertices, Philox* rng, std::vector<std::pair<double, double>>* points, EdgeList* edges, std::vector<Weight>* capacities) {
+    TRACE_SCOPE("Graph::generate_grid");
+    int    side    = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(nb_vertices)))));
+    double spacing = static_cast<double>(std::min(Constants::AREA_WIDTH, Constants::AREA_HEIGHT))/1000/side;
+    for(int i=0 ; i<nb_vertices ; i++) {
+        points->push_back(std::make_pair((i%side+0.5)*spacing-spacing*side/2, (i/side+0.5)*spacing-spacing*side/2));
+    }
+    std::vector<EdgeList> chunks;
+    run_chunks(rng, &chunks, [&](int c, Philox*, EdgeList* chunk) {
+        int begin = static_cast<int>(static_cast<long long>(nb_vertices)*c/Constants::GENERATOR_CHUNKS);
+        int end   = static_cast<int>(static_cast<long long>(nb_vertices)*(c+1)/Constants::GENERATOR_CHUNKS);
+        for(int u=begin ; u<end ; u++) {
+            if(u%side<side-1 && u+1<nb_vertices) chunk->push_back(std::make_pair(u, u+1));
+            if(u+side<nb_vertices)               chunk->push_back(std::make_pair(u, u+side));
+        }
+    });
+    concatenate(&chunks, edges);
+    capacities->resize(edges->size());
+    for(Weight& c : *capacities) c = rng->uniform_int(Constants::EDGE_MAXIMUM_CAPACITY) + 1;
+}
+
+/*
+R-MAT graph (Chakrabarti et al.), with the parameters of Graph500: each
+edge falls in a quadrant of the adjacency matrix chosen with the
+probabilities GENERATOR_RMAT_A to D, recursively down to a single cell,
+which gives a power-law degree distribution. Edges out of the graph
+(when n is not a power of two) and loops are drawn again, duplicates
+are dropped. The identifiers are then shuffled so that the high degree
+vertices are not all at the beginning.
+*/
+void Graph::generate_rmat(int nb_vertices, Philox* rng, std::vector<std::pair<double, double>>* points, EdgeList* edges) {
+    TRACE_SCOPE("Graph::generate_rmat");
+    random_points(rng, nb_vertices, points);
+    if(nb_vertices<2) return;
+    int              scale = 0;
+    long long        m     = static_cast<long long>(Constants::GENERATOR_DEGREE*nb_vertices/2);
+    std::vector<int> permutation(nb_vertices);
+    while((1LL<<scale)<nb_vertices) scale++;
+    for(int i=0 ; i<nb_vertices ; i++) permutation[i] = i;
+    for(int i=nb_vertices-1 ; i>0 ; i--) std::swap(permutation[i], permutation[rng->uniform_int(i+1)]);
+    std::vector<EdgeList> chunks;
+    run_chunks(rng, &chunks, [&](int c, Philox* stream, EdgeList* chunk) {
+        long long nb_edges = m*(c+1)/Constants::GENERATOR_CHUNKS - m*c/Constants::GENERATOR_CHUNKS;
+        while(static_cast<long long>(chunk->size())<nb_edges) {
+            int u = 0;
+            int v = 0;
+            for(int level=0 ; level<scale ; level++) {
+                double r = stream->uniform();
+                u = 2*u + (r>=Constants::GENERATOR_RMAT_A+Constants::GENERATOR_RMAT_B);
+                v = 2*v + ((r>=Constants::GENERATOR_RMAT_A && r<Constants::GENERATOR_RMAT_A+Constants::GENERATOR_RMAT_B) || r>=Constants::GENERATOR_RMAT_A+Constants::GENERATOR_RMAT_B+Constants::GENERATOR_RMAT_C);
+            }
+            if(u>=nb_vertices || v>=nb_vertices || u==v) continue;
+            u = permutation[u];
+            v = permutation[v];
+            chunk->push_back(std::make_pair(std::min(u, v), std::max(u, v)));
+        }
+    });
+    concatenate(&chunks, edges);
+    std::sort(edges->begin(), edges->end());
+    edges->erase(std::unique(edges->begin(), edges->end()), edges->end());
+}
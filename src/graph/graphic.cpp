@@ -21,6 +21,7 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <iostream>
@@ -32,39 +33,70 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "Graph.hpp"
 
 /*
-Main draw function.
+Main draw function. Only the primitives inside the view are drawn, they
+are found with the quadtree. When too many vertices are visible, the
+graph is drawn as density tiles instead.
 */
 void Graph::draw() const {
     glClear(GL_COLOR_BUFFER_BIT);
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
-    draw_edges();
-    draw_vertices();
+    viewport.apply();
+    if(!quadtree || quadtree->getNbVertices()!=static_cast<int>(graph_representation->getVertices()->size()) || quadtree->getNbEdges()!=static_cast<int>(graph_representation->getEdges()->size())) {
+        delete quadtree;
+        quadtree = new QuadTree(graph_representation->getVertices(), graph_representation->getEdges());
+    }
+    double                     pixel = viewport.pixel_size(glutGet(GLUT_WINDOW_WIDTH));
+    std::vector<const Vertex*> visible_vertices;
+    std::vector<const Edge*>   visible_edges;
+    quadtree->query(viewport.getMinX(), viewport.getMinY(), viewport.getMaxX(), viewport.getMaxY(), &visible_vertices, &visible_edges);
+    if(static_cast<int>(visible_vertices.size())>Constants::RENDER_LOD_MAX_VERTICES) {
+        draw_tiles(pixel);
+    }
+    else {
+        draw_edges(visible_edges, pixel);
+        draw_vertices(visible_vertices);
+    }
     glutSwapBuffers();
     glutPostRedisplay();
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::this_thread::sleep_for(std::chrono::milliseconds(animation ? Constants::ANIMATION_FRAME_DELAY : Constants::RENDER_FRAME_DELAY));
 }
 
 /*
-Draws the edges, and the arc directions and capacities if set.
+Draws the given edges, and the arc directions and capacities if set. When
+there are too many edges, they are drawn as simple lines in one batch.
 */
-void Graph::draw_edges() const {
-    for(Edge* e : *graph_representation->getEdges()) {
-        double v1x = e->getV1()->getX();
-        double v1y = e->getV1()->getY();
-        double v2x = e->getV2()->getX();
-        double v2y = e->getV2()->getY();
-        double c1 = e->getCapacityV1ToV2();
-        double c2 = e->getCapacityV2ToV1();
+void Graph::draw_edges(const std::vector<const Edge*>& edges, double pixel) const {
+    if(static_cast<int>(edges.size())>Constants::RENDER_DETAIL_MAX_EDGES) {
+        glBegin(GL_LINES);
+        for(const Edge* e : edges) {
+            Color color = graph_representation->get_color(e);
+            glColor3ub(color.r, color.g, color.b);
+            const Vertex* v1 = graph_representation->get_v1(e);
+            const Vertex* v2 = graph_representation->get_v2(e);
+            glVertex2d(v1->getX(), v1->getY());
+            glVertex2d(v2->getX(), v2->getY());
+        }
+        glEnd();
+        return;
+    }
+    for(const Edge* e : edges) {
+        double v1x = graph_representation->get_v1(e)->getX();
+        double v1y = graph_representation->get_v1(e)->getY();
+        double v2x = graph_representation->get_v2(e)->getX();
+        double v2y = graph_representation->get_v2(e)->getY();
+        double c1 = graph_representation->get_capacity_v1_to_v2(e);
+        double c2 = graph_representation->get_capacity_v2_to_v1(e);
         double c = c1>c2 ? c1 : c2;
         glLineWidth(static_cast<float>(c)*Constants::EDGE_MAXIMUM_CAPACITY/30);
-        glColor3ub(e->getColorR(), e->getColorG(), e->getColorB());
+        Color color = graph_representation->get_color(e);
+        glColor3ub(color.r, color.g, color.b);
         glBegin(GL_LINES);
         glVertex2d(v1x, v1y);
         glVertex2d(v2x, v2y);
         glEnd();
         glLineWidth(1);
-        draw_edge_capacity(e);
+        if(graph_representation->get_v1(e)->distanceTo(graph_representation->get_v2(e))>Constants::RENDER_LABEL_MIN_PIXELS*pixel) draw_edge_capacity(e);
         draw_edge_direction(e);
         
     }
@@ -73,18 +105,17 @@ void Graph::draw_edges() const {
 /*
 Displays the edge's capacity.
 */
-void Graph::draw_edge_capacity(Edge* e) const {
-    double v1x = e->getV1()->getX();
-    double v1y = e->getV1()->getY();
-    double v2x = e->getV2()->getX();
-    double v2y = e->getV2()->getY();
-    double c1 = e->getCapacityV1ToV2();
-    double c2 = e->getCapacityV2ToV1();
+void Graph::draw_edge_capacity(const Edge* e) const {
+    double v1x = graph_representation->get_v1(e)->getX();
+    double v1y = graph_representation->get_v1(e)->getY();
+    double v2x = graph_representation->get_v2(e)->getX();
+    double v2y = graph_representation->get_v2(e)->getY();
+    double c1 = graph_representation->get_capacity_v1_to_v2(e);
+    double c2 = graph_representation->get_capacity_v2_to_v1(e);
     if(arc_integer_capacities_defined) {
         glPushMatrix();
-        glLoadIdentity();
-        float xoff = 0.015;
-        float yoff = 0.017;
+        float xoff = 0.015*viewport.getScale();
+        float yoff = 0.017*viewport.getScale();
         if(orientation==ONE_WAY || orientation==NONE) {
             if(v1x!=v2x) {
                 float slope = (v1y-v2y)/(v1x-v2x);
@@ -123,15 +154,14 @@ void Graph::draw_edge_capacity(Edge* e) const {
 /*
 Displays the edge's direction.
 */
-void Graph::draw_edge_direction(Edge* e) const {
-    double v1x = e->getV1()->getX();
-    double v1y = e->getV1()->getY();
-    double v2x = e->getV2()->getX();
-    double v2y = e->getV2()->getY();
+void Graph::draw_edge_direction(const Edge* e) const {
+    double v1x = graph_representation->get_v1(e)->getX();
+    double v1y = graph_representation->get_v1(e)->getY();
+    double v2x = graph_representation->get_v2(e)->getX();
+    double v2y = graph_representation->get_v2(e)->getY();
     if(orientation==ONE_WAY || orientation==TWO_WAYS) {
         if(orientation==ONE_WAY) {
             glPushMatrix();
-            glLoadIdentity();
             glTranslatef(v2x, v2y, 0);
             if(v1x!=v2x) {
                 float phase = v1x>v2x ? M_PI : 0;
@@ -143,8 +173,8 @@ void Graph::draw_edge_direction(Edge* e) const {
                 float phase = v2y>v1y ? 0 : M_PI;
                 glRotatef(180*(M_PI*0.5+phase)/M_PI, 0, 0, 1);
             }
-            float len  = 0.018;
-            float xoff = 0.02;
+            float len  = 0.018*viewport.getScale();
+            float xoff = 0.02*viewport.getScale();
             glBegin(GL_TRIANGLES);
             glVertex2d(-len-xoff, len);
             glVertex2d(-xoff, 0);
@@ -154,7 +184,6 @@ void Graph::draw_edge_direction(Edge* e) const {
         }
         else if(orientation==TWO_WAYS) { /* ***************************** TO BE UPDATED ************************** */
             glPushMatrix();
-            glLoadIdentity();
             glTranslatef(v1x, v1y, 0);
             if(v1x!=v2x) {
                 float phase = v1x>v2x ? M_PI : 0;
@@ -166,15 +195,16 @@ void Graph::draw_edge_direction(Edge* e) const {
                 float phase = v2y>v1y ? 0 : M_PI;
                 glRotatef(180*(M_PI*0.5+phase)/M_PI, 0, 0, 1);
             }
-            float len  = 0.018;
-            float xoff = 0.02;
+            float len  = 0.018*viewport.getScale();
+            float xoff = 0.02*viewport.getScale();
             glColor3ub(255, 255, 255);
             glBegin(GL_TRIANGLES);
             glVertex2d(len+xoff, len);
             glVertex2d(0+xoff, 0);
             glVertex2d(len+xoff, -len);
             glEnd();
-            glColor3ub(e->getColorR(), e->getColorG(), e->getColorB());
+            Color color = graph_representation->get_color(e);
+            glColor3ub(color.r, color.g, color.b);
             glBegin(GL_LINE_LOOP);
             glVertex2d(len+xoff, len);
             glVertex2d(0+xoff, 0);
@@ -186,19 +216,46 @@ void Graph::draw_edge_direction(Edge* e) const {
 }
 
 /*
-Draws the vertices as circles.
+Draws the given vertices as circles.
 */
-void Graph::draw_vertices() const {
-    for(Vertex* v : *graph_representation->getVertices()) {
+void Graph::draw_vertices(const std::vector<const Vertex*>& vertices) const {
+    for(const Vertex* v : vertices) {
         glColor3ub(0, 0, 0);
         glPointSize(10);
         glBegin(GL_POINTS);
         glVertex2d(v->getX(), v->getY());
         glEnd();
-        glColor3ub(v->getColorR(), v->getColorG(), v->getColorB());
+        Color color = graph_representation->get_color(v);
+        glColor3ub(color.r, color.g, color.b);
         glPointSize(8);
         glBegin(GL_POINTS);
         glVertex2d(v->getX(), v->getY());
         glEnd();
     }
 }
+
+/*
+Draws the visible part of the graph as tiles whose darkness depends
+on the density of vertices. This is the level of detail used when the
+view is too zoomed out for single vertices and edges to be readable.
+*/
+void Graph::draw_tiles(double pixel) const {
+    std::vector<QuadTree::Tile> tiles;
+    quadtree->tiles(viewport.getMinX(), viewport.getMinY(), viewport.getMaxX(), viewport.getMaxY(), Constants::RENDER_LOD_TILE_PIXELS*pixel, &tiles);
+    double max_density = 0;
+    for(const QuadTree::Tile& t : tiles) {
+        max_density = std::max(max_density, t.nb_vertices/((t.max_x-t.min_x)*(t.max_y-t.min_y)));
+    }
+    glBegin(GL_QUADS);
+    for(const QuadTree::Tile& t : tiles) {
+        double density = t.nb_vertices/((t.max_x-t.min_x)*(t.max_y-t.min_y))/max_density;
+        glColor3ub(static_cast<unsigned char>(255-density*(255-Constants::EDGE_COLOR_R)),
+                   static_cast<unsigned char>(255-density*(255-Constants::EDGE_COLOR_G)),
+                   static_cast<unsigned char>(255-density*(255-Constants::EDGE_COLOR_B)));
+        glVertex2d(t.min_x, t.min_y);
+        glVertex2d(t.max_x, t.min_y);
+        glVertex2d(t.max_x, t.max_y);
+        glVertex2d(t.min_x, t.max_y);
+    }
+    glEnd();
+}
@@ -21,102 +21,147 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include "Graph.hpp"
+#include "stats/Trace.hpp"
 
 /*
-Generates random integer capacities for each arc in the graph. If orientation
+Generates random integer capacities for each arc in the graph, drawn from
+the given generator. If orientation
 is ONE_WAY or NONE, capacity_v1_v2 is used and capacity_v2_v1 is set to zero.
 Otherwise both are given a random capacity.
 */
-void Graph::generate_random_arc_integer_capacities() {
+void Graph::generate_random_arc_integer_capacities(Philox* rng) {
+    TRACE_SCOPE("Graph::generate_random_arc_integer_capacities");
     for(Edge* e : *graph_representation->getEdges()) {
-                                  e->setCapacityV1ToV2(rand()%Constants::EDGE_MAXIMUM_CAPACITY + 1);
-        if(orientation==TWO_WAYS) e->setCapacityV2ToV1(rand()%Constants::EDGE_MAXIMUM_CAPACITY + 1);
-        else                      e->setCapacityV2ToV1(0);
+                                  graph_representation->set_capacity_v1_to_v2(e, rng->uniform_int(Constants::EDGE_MAXIMUM_CAPACITY) + 1);
+        if(orientation==TWO_WAYS) graph_representation->set_capacity_v2_to_v1(e, rng->uniform_int(Constants::EDGE_MAXIMUM_CAPACITY) + 1);
+        else                      graph_representation->set_capacity_v2_to_v1(e, 0);
     }
 }
 
 /*
-Randomly switches vertices v1 and v2 of each edge of the graph.
+Randomly switches vertices v1 and v2 of each edge of the graph, with the
+given generator.
 */
-void Graph::generate_random_arc_directions() {
+void Graph::generate_random_arc_directions(Philox* rng) {
+    TRACE_SCOPE("Graph::generate_random_arc_directions");
     for(Edge* e : *graph_representation->getEdges()) {
-        if(rand()%2) e->switch_vertices();
+        if(rng->uniform_int(2)) graph_representation->switch_vertices(e);
     }
 }
 
 /*
-Generates the random vertices. It is guaranted that each vertex has unique (x, y).
+Generates the random vertices with the given generator, on the integer
+grid of the area. It is guaranted that each vertex has unique (x, y).
 */
-void Graph::generate_random_vertices() {
-    std::set<std::pair<double, double>> s;
+void Graph::generate_random_vertices(int nb_vertices, Philox* rng, std::vector<std::pair<double, double>>* points) {
+    TRACE_SCOPE("Graph::generate_random_vertices");
+    std::vector<bool> taken(static_cast<std::size_t>(Constants::AREA_WIDTH)*Constants::AREA_HEIGHT, false);
     for(int i=0 ; i<nb_vertices ; i++) {
-        double x, y;
+        int x, y;
         do {
-            x = static_cast<double>(rand() % Constants::AREA_WIDTH - Constants::AREA_WIDTH/2)/1000;
-            y = static_cast<double>(rand() % Constants::AREA_HEIGHT - Constants::AREA_HEIGHT/2)/1000;
-        } while(s.count(std::make_pair(x, y)));
-        s.insert(std::make_pair(x, y));
-        graph_representation->add_vertex(x, y);
+            x = static_cast<int>(rng->uniform_int(Constants::AREA_WIDTH));
+            y = static_cast<int>(rng->uniform_int(Constants::AREA_HEIGHT));
+        } while(taken[static_cast<std::size_t>(y)*Constants::AREA_WIDTH+x]);
+        taken[static_cast<std::size_t>(y)*Constants::AREA_WIDTH+x] = true;
+        points->push_back(std::make_pair(static_cast<double>(x-Constants::AREA_WIDTH/2)/1000, static_cast<double>(y-Constants::AREA_HEIGHT/2)/1000));
     }
 }
 
 /*
-Generates the random vertices. It is guaranted that each vertex has unique (x, y).
+Poisson-disk sampling of the rectangle [0, width) x [0, height), after
+Bridson: fills it with points at distance radius or more from each other,
+in time linear in the number of points. A background grid of cells of
+diagonal radius holds at most one point per cell, so only the 5x5 cells
+around a candidate can hold a point too close to it. The grid stores the
+coordinates themselves to keep these checks in a few cache lines.
+Candidates are taken around a random active point, at evenly spaced
+angles on the circle of the radius, which packs the points more tightly
+than random candidates in the annulus, with fewer attempts. The active
+point is dropped, by swapping it with the last one, when none fits.
 */
-void Graph::generate_random_vertices_spacing() {
-    std::vector<std::pair<int, int>> empty_cells;
-    int                              nb_x_cells = ceil(Constants::AREA_WIDTH/Constants::AREA_SPACING);
-    int                              nb_y_cells = ceil(Constants::AREA_HEIGHT/Constants::AREA_SPACING);
-    Vertex**                         full_cells = new Vertex*[nb_x_cells*nb_y_cells];
-    for(int j=0 ; j<nb_y_cells ; j++) {
-        for(int i=0 ; i<nb_x_cells ; i++) {
-            full_cells[i+j*nb_x_cells] = 0;
-            empty_cells.push_back(std::make_pair(i, j));
-        }
+static void poisson_disk_sampling(Philox* rng, double width, double height, double radius, std::vector<std::pair<double, double>>* samples) {
+    typedef std::pair<double, double> Point;
+    double              cell     = radius/std::sqrt(2.0);
+    int                 nb_x     = std::max(1, static_cast<int>(std::ceil(width/cell)));
+    int                 nb_y     = std::max(1, static_cast<int>(std::ceil(height/cell)));
+    int                 attempts = Constants::AREA_POISSON_ATTEMPTS;
+    std::vector<Point>  grid(static_cast<std::size_t>(nb_x)*nb_y, Point(-1, -1));
+    std::vector<Point>  active;
+    std::vector<Point>  offsets;
+    for(int k=0 ; k<attempts ; k++) {
+        double angle = 2*M_PI*k/attempts;
+        offsets.push_back(Point(radius*(1+1e-9)*std::cos(angle), radius*(1+1e-9)*std::sin(angle)));
     }
-    for(int i=0 ; i<nb_vertices ; i++) {
-        float x, y;
-        bool  retry;
-        int   index, index_x, index_y;
-        do {
-            retry   = false;
-            index   = rand() % empty_cells.size();
-            index_x = empty_cells[index].first;
-            index_y = empty_cells[index].second;
-            if(full_cells[index_x + index_y*nb_x_cells]!=0) {
-                retry = true;
-            }
-            else {
-                std::vector<Vertex*> neighbors;
-                if(index_x<nb_x_cells-1) {
-                    if(full_cells[index_x+1 + index_y*nb_x_cells]!=0) neighbors.push_back(full_cells[index_x+1 + index_y*nb_x_cells]);
-                    if(index_y<nb_y_cells-1) { if(full_cells[index_x+1 + (index_y+1)*nb_x_cells]!=0) neighbors.push_back(full_cells[index_x+1 + (index_y+1)*nb_x_cells]); }
-                    if(index_y>0)            { if(full_cells[index_x+1 + (index_y-1)*nb_x_cells]!=0) neighbors.push_back(full_cells[index_x+1 + (index_y-1)*nb_x_cells]); }
-                }
-                if(index_x>0) {
-                    if(full_cells[index_x-1 + index_y*nb_x_cells]!=0) neighbors.push_back(full_cells[index_x-1 + index_y*nb_x_cells]);
-                    if(index_y<nb_y_cells-1) { if(full_cells[index_x-1 + (index_y+1)*nb_x_cells]!=0) neighbors.push_back(full_cells[index_x-1 + (index_y+1)*nb_x_cells]); }
-                    if(index_y>0)            { if(full_cells[index_x-1 + (index_y-1)*nb_x_cells]!=0) neighbors.push_back(full_cells[index_x-1 + (index_y-1)*nb_x_cells]); }
-                }
-                if(index_y>0)            { if(full_cells[index_x + (index_y-1)*nb_x_cells]!=0) neighbors.push_back(full_cells[index_x + (index_y-1)*nb_x_cells]); }
-                if(index_y<nb_y_cells-1) { if(full_cells[index_x + (index_y+1)*nb_x_cells]!=0) neighbors.push_back(full_cells[index_x + (index_y+1)*nb_x_cells]); }
-                x = index_x*Constants::AREA_SPACING + static_cast<float>(rand() % (Constants::AREA_SPACING*100)) / 100.0;
-                y = index_y*Constants::AREA_SPACING + static_cast<float>(rand() % (Constants::AREA_SPACING*100)) / 100.0;
-                for(Vertex* v : neighbors) {
-                    if(v->distanceTo(x, y)<Constants::AREA_SPACING) {
-                        retry = true;
+    samples->clear();
+    auto insert = [&](double x, double y) {
+        grid[static_cast<std::size_t>(y/cell)*nb_x+static_cast<int>(x/cell)] = Point(x, y);
+        active.push_back(Point(x, y));
+        samples->push_back(Point(x, y));
+    };
+    insert(rng->uniform()*width, rng->uniform()*height);
+    while(!active.empty()) {
+        std::size_t a     = rng->uniform_int(static_cast<uint32_t>(active.size()));
+        Point       p     = active[a];
+        double      turn  = 2*M_PI*rng->uniform();
+        double      cos_t = std::cos(turn);
+        double      sin_t = std::sin(turn);
+        bool        found = false;
+        for(int k=0 ; k<attempts && !found ; k++) {
+            double x = p.first +offsets[k].first*cos_t-offsets[k].second*sin_t;
+            double y = p.second+offsets[k].first*sin_t+offsets[k].second*cos_t;
+            if(x<0 || y<0 || x>=width || y>=height) continue;
+            int cx = static_cast<int>(x/cell);
+            int cy = static_cast<int>(y/cell);
+            found  = true;
+            for(int j=std::max(0, cy-2) ; j<=std::min(nb_y-1, cy+2) && found ; j++) {
+                const Point* row = &grid[static_cast<std::size_t>(j)*nb_x];
+                for(int i=std::max(0, cx-2) ; i<=std::min(nb_x-1, cx+2) ; i++) {
+                    double dx = row[i].first-x;
+                    double dy = row[i].second-y;
+                    if(row[i].first>=0 && dx*dx+dy*dy<radius*radius) {
+                        found = false;
                         break;
                     }
                 }
             }
-            if(!retry) empty_cells.erase(empty_cells.begin()+index);
-        } while(retry);
-        Vertex* v = graph_representation->add_vertex(x, y);
-        full_cells[index_x + index_y*nb_x_cells] = v;
+            if(found) insert(x, y);
+        }
+        if(!found) {
+            active[a] = active.back();
+            active.pop_back();
+        }
+    }
+}
+
+/*
+Generates evenly spaced random vertices with the given generator. The
+area is filled by Poisson-disk sampling with a radius estimated from the
+number of vertices, adjusted until the sampling holds slightly more
+points than needed. The extra points are then dropped at random.
+*/
+void Graph::generate_random_vertices_spacing(int nb_vertices, Philox* rng, std::vector<std::pair<double, double>>* points) {
+    TRACE_SCOPE("Graph::generate_random_vertices_spacing");
+    if(nb_vertices<=0) return;
+    double                                 width  = static_cast<double>(Constants::AREA_WIDTH)/1000;
+    double                                 height = static_cast<double>(Constants::AREA_HEIGHT)/1000;
+    double                                 radius = std::sqrt(Constants::AREA_POISSON_DENSITY*width*height/nb_vertices);
+    std::size_t                            n      = static_cast<std::size_t>(nb_vertices);
+    std::vector<std::pair<double, double>> samples;
+    for(int attempt=0 ; ; attempt++) {
+        poisson_disk_sampling(rng, width, height, radius, &samples);
+        if(samples.size()>=n && (samples.size()<=n+n/20 || attempt>=4)) break;
+        radius *= std::sqrt(static_cast<double>(samples.size())/n);
+        if(samples.size()<n) radius *= 0.98;
+    }
+    for(std::size_t i=0 ; i<n ; i++) {
+        std::swap(samples[i], samples[i+rng->uniform_int(static_cast<uint32_t>(samples.size()-i))]);
+        points->push_back(std::make_pair(samples[i].first-width/2, samples[i].second-height/2));
     }
-    delete [] full_cells;
 }
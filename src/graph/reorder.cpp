@@ -0,0 +1,188 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "Graph.hpp"
+#include "HilbertCurve.hpp"
+#include "stats/Trace.hpp"
+
+/*
+Name of a vertex ordering, for the command line and the console.
+*/
+const char* Graph::ordering_name(VERTEX_ORDERING ordering) {
+    switch(ordering) {
+        case ORDER_HILBERT : return "hilbert";
+        case ORDER_BFS     : return "bfs";
+        case ORDER_RCM     : return "rcm";
+    }
+    return "unknown";
+}
+
+/*
+Finds the vertex ordering with the given name. Returns false if there
+is none.
+*/
+bool Graph::parse_ordering(const char* name, VERTEX_ORDERING* ordering) {
+    for(VERTEX_ORDERING o : {ORDER_HILBERT, ORDER_BFS, ORDER_RCM}) {
+        if(!strcmp(name, ordering_name(o))) {
+            *ordering = o;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+Writes the identifiers of the vertices in the order of a Hilbert curve
+over their coordinates.
+*/
+static void order_hilbert(const std::vector<Vertex*>& vertices, std::vector<int>* order) {
+    HilbertCurve                               curve(vertices.begin(), vertices.end());
+    std::vector<std::pair<std::uint64_t, int>> keys;
+    keys.reserve(vertices.size());
+    for(const Vertex* v : vertices) keys.push_back(std::make_pair(curve.index(v), v->getId()));
+    std::sort(keys.begin(), keys.end());
+    for(const std::pair<std::uint64_t, int>& k : keys) order->push_back(k.second);
+}
+
+/*
+Writes the identifiers of the vertices in breadth-first order, each
+connected component being visited from its vertex of smallest
+identifier. With by_degree, the components are visited from their
+vertex of smallest degree and the neighbors by increasing degree, which
+is the Cuthill-McKee order.
+*/
+static void order_breadth_first(const GraphRepresentation& r, bool by_degree, std::vector<int>* order) {
+    const std::vector<Vertex*>& vertices = *r.getVertices();
+    const int                   n        = static_cast<int>(vertices.size());
+    std::vector<int>            degrees(n);
+    std::vector<int>            starts(n);
+    for(int v=0 ; v<n ; v++) {
+        degrees[v] = static_cast<int>(r.neighbors(vertices[v]).size());
+        starts[v]  = v;
+    }
+    auto by_increasing_degree = [&degrees](int a, int b) { return degrees[a]<degrees[b] || (degrees[a]==degrees[b] && a<b); };
+    if(by_degree) std::sort(starts.begin(), starts.end(), by_increasing_degree);
+    std::vector<char> visited(n, 0);
+    std::vector<int>  next;
+    for(int s : starts) {
+        if(visited[s]) continue;
+        std::size_t head = order->size();
+        visited[s]       = 1;
+        order->push_back(s);
+        while(head<order->size()) {
+            int v = (*order)[head++];
+            next.clear();
+            for(const Neighbor& u : r.neighbors(vertices[v])) {
+                int id = u.vertex->getId();
+                if(!visited[id]) { visited[id] = 1; next.push_back(id); }
+            }
+            if(by_degree) std::sort(next.begin(), next.end(), by_increasing_degree);
+            order->insert(order->end(), next.begin(), next.end());
+        }
+    }
+}
+
+/*
+Renumbers the vertices in the given order, so that vertices used one
+after the other by the algorithms are stored next to each other, and
+rebuilds the representation with the edges sorted by the new identifiers
+of their end points. Hilbert follows the coordinates, BFS and RCM
+(reverse Cuthill-McKee) follow the edges. The capacities, directions,
+colors and picked vertices are kept. Returns the new identifier of each
+vertex by its former one, so that the callers can translate the ones
+they kept, or an empty vector if an algorithm is running.
+*/
+std::vector<int> Graph::reorder(VERTEX_ORDERING ordering) {
+    TRACE_SCOPE("Graph::reorder");
+    std::vector<int> permutation;
+    if(is_busy()) {
+        std::cerr << "cannot reorder the vertices while an algorithm runs" << std::endl;
+        return permutation;
+    }
+    const std::vector<Vertex*>& vertices = *graph_representation->getVertices();
+    const std::vector<Edge*>&   edges    = *graph_representation->getEdges();
+    std::vector<int>            order;
+    order.reserve(vertices.size());
+    if(!vertices.empty()) {
+        switch(ordering) {
+            case ORDER_HILBERT : order_hilbert(vertices, &order);
+                                 break;
+            case ORDER_BFS     : order_breadth_first(*graph_representation, false, &order);
+                                 break;
+            case ORDER_RCM     : order_breadth_first(*graph_representation, true, &order);
+                                 std::reverse(order.begin(), order.end());
+                                 break;
+        }
+    }
+    permutation.assign(vertices.size(), 0);
+    for(std::size_t i=0 ; i<order.size() ; i++) permutation[order[i]] = static_cast<int>(i);
+    
+    /* edges by smallest and then largest new end point, keeping their direction */
+    std::vector<std::pair<std::pair<int, int>, int>> keys;
+    keys.reserve(edges.size());
+    for(const Edge* e : edges) {
+        int v1 = permutation[graph_representation->get_v1_id(e)];
+        int v2 = permutation[graph_representation->get_v2_id(e)];
+        keys.push_back(std::make_pair(std::make_pair(std::min(v1, v2), std::max(v1, v2)), e->getId()));
+    }
+    std::sort(keys.begin(), keys.end());
+    std::vector<std::pair<int, int>> pairs;
+    pairs.reserve(keys.size());
+    for(const std::pair<std::pair<int, int>, int>& k : keys) {
+        const Edge* e = edges[k.second];
+        pairs.push_back(std::make_pair(permutation[graph_representation->get_v1_id(e)], permutation[graph_representation->get_v2_id(e)]));
+    }
+    
+    /* new representation, of the same type */
+    Graph                reordered(type, nb_vertices);
+    GraphRepresentation* r = reordered.graph_representation;
+    for(int id : order) r->add_vertex(vertices[id]->getX(), vertices[id]->getY());
+    r->add_edges(pairs);
+    for(std::size_t i=0 ; i<order.size() ; i++) {
+        Color c = graph_representation->get_color(vertices[order[i]]);
+        r->set_color(r->getVertices()->at(i), c.r, c.g, c.b);
+    }
+    for(std::size_t i=0 ; i<keys.size() ; i++) {
+        const Edge* e = edges[keys[i].second];
+        const Edge* f = r->getEdges()->at(i);
+        Color       c = graph_representation->get_color(e);
+        r->set_capacity_v1_to_v2(f, graph_representation->get_capacity_v1_to_v2(e));
+        r->set_capacity_v2_to_v1(f, graph_representation->get_capacity_v2_to_v1(e));
+        r->set_color(f, c.r, c.g, c.b);
+    }
+    std::swap(graph_representation, reordered.graph_representation);
+    if(picked_destination>=0) picked_destination = permutation[picked_destination];
+    if(picked_source>=0)      picked_source      = permutation[picked_source];
+    delete kdtree;
+    delete quadtree;
+    kdtree   = 0;
+    quadtree = 0;
+    return permutation;
+}
@@ -0,0 +1,131 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CowArray_hpp
+#define CowArray_hpp
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "stats/MemoryFootprint.hpp"
+
+/*
+Array of attributes shared between copies until they are written. The
+values are stored in pages, and the copies share the table of pages.
+Copying an array is O(1): the first write to a copy duplicates the table
+of pages, and every write duplicates the page it lands in if the page is
+still shared. Copies can be written from different threads, as long as
+a given array is only used by one thread at a time.
+*/
+template<typename T>
+class CowArray {
+
+    public:
+    
+        CowArray() : count(0), table(std::make_shared<Table>()) {}
+    
+        const T&    operator[](std::size_t i) const { return (*(*table)[i/PAGE_SIZE])[i%PAGE_SIZE]; }
+        std::size_t size()                    const { return count; }
+    
+ static void footprint(std::size_t, MemoryFootprint*, unsigned long long*);
+        void fill(const T&);
+        void push_back(const T&);
+        void set(std::size_t, const T&);
+    
+    private:
+    
+        typedef std::vector<T>                     Page;
+        typedef std::vector<std::shared_ptr<Page>> Table;
+    
+ static const std::size_t PAGE_SIZE = 1024;   /* number of values in a page */
+    
+        Page& writable_page(std::size_t);
+    
+        std::size_t            count;   /* number of values */
+        std::shared_ptr<Table> table;   /* pages, shared with the copies until written */
+
+};
+
+template<typename T>
+const std::size_t CowArray<T>::PAGE_SIZE;
+
+/*
+Memory used by an array of n values. The size of the values is added
+to the given payload counter, the pages and their table to the index.
+*/
+template<typename T>
+void CowArray<T>::footprint(std::size_t n, MemoryFootprint* f, unsigned long long* payload) {
+    std::size_t nb_pages = (n+PAGE_SIZE-1)/PAGE_SIZE;
+    f->add_allocations(1, sizeof(Table), &f->index_bytes);
+    if(nb_pages) {
+        f->add_allocations(1, nb_pages*sizeof(std::shared_ptr<Page>), &f->index_bytes);
+        f->add_allocations(nb_pages, sizeof(Page)+2*sizeof(long), &f->index_bytes);
+        f->add_allocations(nb_pages, PAGE_SIZE*sizeof(T), payload);
+    }
+}
+
+/*
+Sets all the values. All the pages share the same content until they
+are written.
+*/
+template<typename T>
+void CowArray<T>::fill(const T& value) {
+    std::shared_ptr<Page> page = std::make_shared<Page>(PAGE_SIZE, value);
+    table = std::make_shared<Table>(table->size(), page);
+}
+
+/*
+Adds a value at the end of the array.
+*/
+template<typename T>
+void CowArray<T>::push_back(const T& value) {
+    if(count%PAGE_SIZE==0) {
+        if(!table.unique()) table = std::make_shared<Table>(*table);
+        table->push_back(std::make_shared<Page>(PAGE_SIZE));
+    }
+    writable_page(count)[count%PAGE_SIZE] = value;
+    count++;
+}
+
+/*
+Sets the value at index i.
+*/
+template<typename T>
+void CowArray<T>::set(std::size_t i, const T& value) {
+    writable_page(i)[i%PAGE_SIZE] = value;
+}
+
+/*
+Returns the page holding index i, after duplicating the table and the
+page if they are shared with another array.
+*/
+template<typename T>
+typename CowArray<T>::Page& CowArray<T>::writable_page(std::size_t i) {
+    if(!table.unique()) table = std::make_shared<Table>(*table);
+    std::shared_ptr<Page>& page = (*table)[i/PAGE_SIZE];
+    if(!page.unique()) page = std::make_shared<Page>(*page);
+    return *page;
+}
+
+#endif
@@ -23,6 +23,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "GraphRepresentation.hpp"
 #include "components/Vertex.hpp"
+#include "stats/Trace.hpp"
 
 #include <iostream>
 
@@ -31,9 +32,7 @@ Initializes the variables.
 */
 GraphRepresentation::GraphRepresentation(int nb_vertices) :
     nb_vertices(nb_vertices),
-    vertex_counter(0) {
-    vertices = new std::vector<Vertex*>;
-    edges    = new std::vector<Edge*>;
+    topology(std::make_shared<Topology>()) {
 }
 
 /*
@@ -45,70 +44,183 @@ GraphRepresentation::GraphRepresentation(const GraphRepresentation& g) :
 }
 
 /*
-Deletes the vertices and edges.
+The topology is deleted with the last representation sharing it.
 */
 GraphRepresentation::~GraphRepresentation() {
-    for(Vertex* v : *vertices) delete v;
-    for(Edge* e : *edges)      delete e;
-    delete vertices;
-    delete edges;
 }
 
 /*
-Copy function.
+Deletes the vertices and edges.
+*/
+GraphRepresentation::Topology::~Topology() {
+    for(Vertex* v : vertices) delete v;
+    for(Edge* e : edges)      delete e;
+}
+
+/*
+Copy function. The topology and the attributes are shared with g until
+one of them is written, so the copy is O(1).
 */
 void GraphRepresentation::copy(const GraphRepresentation& g) {
+    TRACE_SCOPE("GraphRepresentation::copy");
     if(this!=&g) {
-        for(Vertex* v : *vertices) delete v; vertices->clear();
-        for(Edge* e : *edges)      delete e; edges->clear();
-        for(Vertex* v : *g.vertices) {
-            Vertex* v_copy = new Vertex(v->getX(), v->getY(), v->getId());
-            *v_copy = *v;
-            vertices->push_back(v_copy);
-        }
-        for(Edge* e : *g.edges) {
-            Vertex* v1 = vertices->at(e->getV1()->getId());
-            Vertex* v2 = vertices->at(e->getV2()->getId());
-            Edge* e_copy = new Edge(v1, v2);
-            *e_copy = *e;
-            edges->push_back(e_copy);
-        }
+        capacities_v1_v2 = g.capacities_v1_v2;
+        capacities_v2_v1 = g.capacities_v2_v1;
+        edge_colors      = g.edge_colors;
+        index            = g.index;
+        switched         = g.switched;
+        topology         = g.topology;
+        vertex_colors    = g.vertex_colors;
     }
 }
 
 /*
-Creates a new Vertex.
+Makes a private copy of the topology if it is shared with another
+representation, before it is modified. Returns true if the topology
+was copied, in which case the vertices and edges are new objects.
+*/
+bool GraphRepresentation::detach_topology() {
+    if(topology.unique()) return false;
+    std::shared_ptr<Topology> t = std::make_shared<Topology>();
+    for(Vertex* v : topology->vertices) {
+        t->vertices.push_back(new Vertex(v->getX(), v->getY(), v->getId()));
+    }
+    for(Edge* e : topology->edges) {
+        t->edges.push_back(new Edge(*e));
+    }
+    topology = t;
+    return true;
+}
+
+/*
+Sets the capacities of all the arcs.
+*/
+void GraphRepresentation::fill_capacities(Weight c) {
+    capacities_v1_v2.fill(c);
+    capacities_v2_v1.fill(c);
+}
+
+/*
+Sets the color of all the edges.
+*/
+void GraphRepresentation::fill_edge_colors(unsigned char r, unsigned char g, unsigned char b) {
+    edge_colors.fill(Color{r, g, b});
+}
+
+/*
+Sets the color of all the vertices.
+*/
+void GraphRepresentation::fill_vertex_colors(unsigned char r, unsigned char g, unsigned char b) {
+    vertex_colors.fill(Color{r, g, b});
+}
+
+/*
+Memory used by the vertices, the edges, their lists, their attributes
+and the index of neighbors. Memory shared with copies of the
+representation is included.
+*/
+MemoryFootprint GraphRepresentation::memory_footprint() const {
+    MemoryFootprint f = lists_footprint(topology->vertices.size(), topology->vertices.capacity(), topology->edges.size(), topology->edges.capacity());
+    if(index) f += index_footprint(index->offsets.size()-1, index->neighbors.size()/2);
+    return f;
+}
+
+/*
+Memory a representation would use for a graph of the given size, once
+the algorithms have built the index of neighbors.
+*/
+MemoryFootprint GraphRepresentation::estimate_footprint(int nb_vertices, int nb_edges) {
+    MemoryFootprint f = lists_footprint(nb_vertices, nb_vertices, nb_edges, nb_edges);
+    f += index_footprint(nb_vertices, nb_edges);
+    return f;
+}
+
+/*
+Memory used by the index of neighbors: each edge appears twice.
+*/
+MemoryFootprint GraphRepresentation::index_footprint(std::size_t nb_vertices, std::size_t nb_edges) {
+    MemoryFootprint f;
+    f.add_allocations(1, sizeof(AdjacencyIndex)+2*sizeof(long), &f.index_bytes);
+    f.add_allocations(1, (nb_vertices+1)*sizeof(std::size_t), &f.index_bytes);
+    if(nb_edges) f.add_allocations(1, 2*nb_edges*sizeof(Neighbor), &f.index_bytes);
+    return f;
+}
+
+/*
+Memory used by the given numbers of vertices and edges, stored in lists
+of pointers with the given capacities, and by their attributes.
+*/
+MemoryFootprint GraphRepresentation::lists_footprint(std::size_t nb_vertices, std::size_t vertices_capacity, std::size_t nb_edges, std::size_t edges_capacity) {
+    MemoryFootprint f;
+    f.add_allocations(1, sizeof(Topology)+2*sizeof(long), &f.index_bytes);
+    if(vertices_capacity) f.add_allocations(1, vertices_capacity*sizeof(Vertex*), &f.index_bytes);
+    if(edges_capacity)    f.add_allocations(1, edges_capacity*sizeof(Edge*), &f.index_bytes);
+    f.add_allocations(nb_vertices, sizeof(Vertex), &f.vertex_bytes);
+    f.add_allocations(nb_edges, sizeof(Edge), &f.edge_bytes);
+    CowArray<Color>::footprint(nb_vertices, &f, &f.vertex_bytes);
+    CowArray<Color>::footprint(nb_edges, &f, &f.edge_bytes);
+    CowArray<Weight>::footprint(nb_edges, &f, &f.edge_bytes);
+    CowArray<Weight>::footprint(nb_edges, &f, &f.edge_bytes);
+    CowArray<unsigned char>::footprint(nb_edges, &f, &f.edge_bytes);
+    return f;
+}
+
+/*
+Creates the edges linking the given pairs of vertex identifiers, with
+the default capacities and color, in one pass. Used by the generators
+instead of add_edge(), so that the subclasses build their structures
+once for all the edges.
+*/
+void GraphRepresentation::add_edges(const std::vector<std::pair<int, int>>& pairs) {
+    TRACE_SCOPE("GraphRepresentation::add_edges");
+    detach_topology();
+    index.reset();
+    topology->edges.reserve(topology->edges.size()+pairs.size());
+    for(const std::pair<int, int>& p : pairs) {
+        topology->edges.push_back(new Edge(topology->vertices.at(p.first), topology->vertices.at(p.second), static_cast<int>(topology->edges.size())));
+        capacities_v1_v2.push_back(Constants::EDGE_DEFAULT_CAPACITY);
+        capacities_v2_v1.push_back(Constants::EDGE_DEFAULT_CAPACITY);
+        edge_colors.push_back(Color{Constants::EDGE_COLOR_R, Constants::EDGE_COLOR_G, Constants::EDGE_COLOR_B});
+        switched.push_back(0);
+    }
+}
+
+/*
+Creates a new Vertex. The index of neighbors is rebuilt on its next use.
 */
 Vertex* GraphRepresentation::add_vertex(double x, double y) {
-    Vertex* v = new Vertex(x, y, vertex_counter++);
-    vertices->push_back(v);
+    detach_topology();
+    index.reset();
+    Vertex* v = new Vertex(x, y, static_cast<int>(topology->vertices.size()));
+    topology->vertices.push_back(v);
+    vertex_colors.push_back(Color{Constants::VERTEX_COLOR_R, Constants::VERTEX_COLOR_G, Constants::VERTEX_COLOR_B});
     return v;
 }
 
 /*
-Creates an Edge.
+Creates an Edge. The end points are looked up by identifier, in case
+the topology had to be copied. The index of neighbors is rebuilt on its
+next use.
 */
 Edge* GraphRepresentation::add_edge(const Vertex* v1, const Vertex* v2) {
-    Edge* e = new Edge(v1, v2);
-    edges->push_back(e);
-    return e;
-}
-Edge* GraphRepresentation::add_edge(const Vertex* v1, const Vertex* v2, double c1, double c2) {
-    Edge* e = new Edge(v1, v2, c1, c2);
-    edges->push_back(e);
-    return e;
+    return add_edge(v1, v2, Constants::EDGE_DEFAULT_CAPACITY, Constants::EDGE_DEFAULT_CAPACITY, Constants::EDGE_COLOR_R, Constants::EDGE_COLOR_G, Constants::EDGE_COLOR_B);
 }
-Edge* GraphRepresentation::add_edge(const Vertex* v1, const Vertex* v2, double c1, double c2, unsigned char cr, unsigned char cg, unsigned char cb) {
-    Edge* e = new Edge(v1, v2, c1, c2, cr, cg, cb);
-    edges->push_back(e);
-    return e;
+Edge* GraphRepresentation::add_edge(const Vertex* v1, const Vertex* v2, Weight c1, Weight c2) {
+    return add_edge(v1, v2, c1, c2, Constants::EDGE_COLOR_R, Constants::EDGE_COLOR_G, Constants::EDGE_COLOR_B);
 }
 Edge* GraphRepresentation::add_edge(const Vertex* v1, const Vertex* v2, unsigned char cr, unsigned char cg, unsigned char cb) {
-    Edge* e = new Edge(v1, v2, cr, cg, cb);
-    edges->push_back(e);
-    return e;
+    return add_edge(v1, v2, Constants::EDGE_DEFAULT_CAPACITY, Constants::EDGE_DEFAULT_CAPACITY, cr, cg, cb);
 }
-Edge* GraphRepresentation::add_edge(const Edge* edge) {
-    edges->push_back(const_cast<Edge*>(edge));
-    return const_cast<Edge*>(edge);
+Edge* GraphRepresentation::add_edge(const Vertex* v1, const Vertex* v2, Weight c1, Weight c2, unsigned char cr, unsigned char cg, unsigned char cb) {
+    int id1 = v1->getId();
+    int id2 = v2->getId();
+    detach_topology();
+    index.reset();
+    Edge* e = new Edge(topology->vertices.at(id1), topology->vertices.at(id2), static_cast<int>(topology->edges.size()));
+    topology->edges.push_back(e);
+    capacities_v1_v2.push_back(c1);
+    capacities_v2_v1.push_back(c2);
+    edge_colors.push_back(Color{cr, cg, cb});
+    switched.push_back(0);
+    return e;
 }
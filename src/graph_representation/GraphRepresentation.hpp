@@ -24,52 +24,112 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef GraphRepresentation_h
 #define GraphRepresentation_h
 
-#include <set>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "constants/Constants.hpp"
+#include "components/Color.hpp"
 #include "components/Edge.hpp"
 #include "components/Vertex.hpp"
+#include "components/Weight.hpp"
+#include "CowArray.hpp"
+#include "NeighborRange.hpp"
+#include "stats/MemoryFootprint.hpp"
 
+/*
+Storage of a graph. The topology (vertices, edges and the index built
+on them) is immutable once shared: copies of a representation share it,
+and only the attributes written by a copy are duplicated, see CowArray.
+Adding a vertex or an edge to a shared representation first makes a
+private copy of its topology.
+*/
 class GraphRepresentation {
 
     public:
     
+        typedef ::Weight weight_type;   /* type of the capacities, see components/Weight.hpp */
+    
         GraphRepresentation(int nb_vertices);
         GraphRepresentation(const GraphRepresentation&);
 virtual ~GraphRepresentation();
 virtual GraphRepresentation& operator=(const GraphRepresentation&) = 0;
 
-        std::vector<Edge*>   *getEdges()    const { return edges; }
-        std::vector<Vertex*> *getVertices() const { return vertices; }
+        std::vector<Edge*>   *getEdges()    const { return &topology->edges; }
+        std::vector<Vertex*> *getVertices() const { return &topology->vertices; }
+    
+        Weight  get_capacity_v1_to_v2(const Edge* e) const { return capacities_v1_v2[e->getId()]; }
+        Weight  get_capacity_v2_to_v1(const Edge* e) const { return capacities_v2_v1[e->getId()]; }
+        Color   get_color(const Edge* e)             const { return edge_colors[e->getId()]; }
+        Color   get_color(const Vertex* v)           const { return vertex_colors[v->getId()]; }
+        Vertex* get_v1(const Edge* e)                const { return topology->vertices[get_v1_id(e)]; }
+        int     get_v1_id(const Edge* e)             const { return switched[e->getId()] ? e->getV2Id() : e->getV1Id(); }
+        Vertex* get_v2(const Edge* e)                const { return topology->vertices[get_v2_id(e)]; }
+        int     get_v2_id(const Edge* e)             const { return switched[e->getId()] ? e->getV1Id() : e->getV2Id(); }
+    
+        void fill_capacities(Weight);
+        void fill_edge_colors(unsigned char, unsigned char, unsigned char);
+        void fill_vertex_colors(unsigned char, unsigned char, unsigned char);
+        void set_capacity_v1_to_v2(const Edge* e, Weight c)                                { capacities_v1_v2.set(e->getId(), c); }
+        void set_capacity_v2_to_v1(const Edge* e, Weight c)                                { capacities_v2_v1.set(e->getId(), c); }
+        void set_color(const Edge* e, unsigned char r, unsigned char g, unsigned char b)   { edge_colors.set(e->getId(), Color{r, g, b}); }
+        void set_color(const Vertex* v, unsigned char r, unsigned char g, unsigned char b) { vertex_colors.set(v->getId(), Color{r, g, b}); }
+        void switch_vertices(const Edge* e)                                                { switched.set(e->getId(), !switched[e->getId()]); }
     
-virtual std::vector<Vertex*> get_all_neighbors(const Vertex*)                           const = 0;
-virtual std::set<Vertex*>    get_all_neighbors_set(const Vertex*)                       const = 0;
-virtual Edge*                get_edge_from_to(const Vertex*, const Vertex*)             const = 0;
-virtual Edge*                get_edge_from_to(int, int)                                 const = 0;
-virtual std::vector<Vertex*> get_direct_neighbors(const Vertex*, GRAPH_ORIENTATION)     const = 0;
-virtual int                  get_capacity_from_to(const Vertex*, const Vertex*)         const = 0;
-virtual int                  get_capacity_from_to(int, int)                             const = 0;
-virtual void                 set_capacity_from_to(const Vertex*, const Vertex*, double)       = 0;
+virtual Edge*         get_edge_from_to(const Vertex*, const Vertex*)             const = 0;
+virtual Edge*         get_edge_from_to(int, int)                                 const = 0;
+virtual Weight        get_capacity_from_to(const Vertex*, const Vertex*)         const = 0;
+virtual Weight        get_capacity_from_to(int, int)                             const = 0;
+virtual NeighborRange neighbors(const Vertex*)                                   const = 0;
+virtual void          set_capacity_from_to(const Vertex*, const Vertex*, Weight)       = 0;
+
+virtual MemoryFootprint memory_footprint() const;
+ static MemoryFootprint estimate_footprint(int, int);
 
 virtual Edge*   add_edge(const Vertex*, const Vertex*);
-virtual Edge*   add_edge(const Vertex*, const Vertex*, double, double);
+virtual Edge*   add_edge(const Vertex*, const Vertex*, Weight, Weight);
 virtual Edge*   add_edge(const Vertex*, const Vertex*, unsigned char, unsigned char, unsigned char);
-virtual Edge*   add_edge(const Vertex*, const Vertex*, double, double, unsigned char, unsigned char, unsigned char);
-virtual Edge*   add_edge(const Edge*);
+virtual Edge*   add_edge(const Vertex*, const Vertex*, Weight, Weight, unsigned char, unsigned char, unsigned char);
+virtual void    add_edges(const std::vector<std::pair<int, int>>&);
 virtual Vertex* add_vertex(double=0, double=0);
 
     protected:
     
-        void copy(const GraphRepresentation&);
-        
-  const int                   nb_vertices;   /* target number of vertices */
-        std::vector<Edge*>*   edges;         /* list of edges */
-        std::vector<Vertex*>* vertices;      /* list of vertices */
+        /*
+        Neighbors of all the vertices, by increasing identifier of the
+        vertex and then of the neighbor. The neighbors of vertex i are
+        between offsets[i] and offsets[i+1]. Built by the subclasses on
+        first use, and dropped when a vertex or an edge is added.
+        */
+        struct AdjacencyIndex {
+            std::vector<Neighbor>    neighbors;   /* neighbors of all the vertices */
+            std::vector<std::size_t> offsets;     /* position of the first neighbor of each vertex */
+        };
     
-    private:
+        /*
+        Vertices and edges, owned by all the representations sharing them.
+        */
+        struct Topology {
+            ~Topology();
+            std::vector<Edge*>   edges;      /* list of edges, by identifier */
+            std::vector<Vertex*> vertices;   /* list of vertices, by identifier */
+        };
     
-        int vertex_counter;   /* keeps the total number of vertices */
+        void          copy(const GraphRepresentation&);
+        bool          detach_topology();
+        NeighborRange indexed_neighbors(int id) const { return NeighborRange(index->neighbors.data()+index->offsets[id], index->neighbors.data()+index->offsets[id+1]); }
+        
+ static MemoryFootprint index_footprint(std::size_t, std::size_t);
+ static MemoryFootprint lists_footprint(std::size_t, std::size_t, std::size_t, std::size_t);
+        
+  const int                                   nb_vertices;        /* target number of vertices */
+        CowArray<Weight>                      capacities_v1_v2;   /* capacity of the arc from v1 to v2, for each edge */
+        CowArray<Weight>                      capacities_v2_v1;   /* capacity of the arc from v2 to v1, for each edge */
+        CowArray<Color>                       edge_colors;        /* color of each edge */
+mutable std::shared_ptr<const AdjacencyIndex> index;              /* neighbors of each vertex, shared with the copies */
+        CowArray<unsigned char>               switched;           /* 1 if v1 and v2 of the edge are switched */
+        std::shared_ptr<Topology>             topology;           /* vertices and edges, shared with the copies */
+        CowArray<Color>                       vertex_colors;      /* color of each vertex */
 
 };
 
@@ -27,17 +27,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <iostream>
 
 /*
-Creates the Edge matrix.
+Initializes the variables. The matrix is allocated with the first edge.
 */
 GraphRepresentationAdjacencyMatrix::GraphRepresentationAdjacencyMatrix(int nb_vertices) :
     GraphRepresentation(nb_vertices) {
-    matrix = new Edge**[nb_vertices];
-    for(int i=0 ; i<nb_vertices ; i++) {
-        matrix[i] = new Edge*[nb_vertices];
-        for(int j=0 ; j<nb_vertices ; j++) {
-            matrix[i][j] = 0;
-        }
-    }
 }
 
 /*
@@ -45,24 +38,43 @@ Copy constructor.
 */
 GraphRepresentationAdjacencyMatrix::GraphRepresentationAdjacencyMatrix(const GraphRepresentationAdjacencyMatrix& g) :
     GraphRepresentation(g) {
-    matrix = new Edge**[nb_vertices];
-    for(int i=0 ; i<nb_vertices ; i++) {
-        matrix[i] = new Edge *[nb_vertices];
-        for(int j=0 ; j<nb_vertices ; j++) {
-            matrix[i][j] = 0;
-        }
-    }
     *this = g;
 }
 
 /*
-Deletes the Edge matrix.
+The matrix is deleted with the last representation sharing it.
 */
 GraphRepresentationAdjacencyMatrix::~GraphRepresentationAdjacencyMatrix() {
-    for(int i=0 ; i<nb_vertices ; i++) {
-        delete[] matrix[i];
+}
+
+/*
+Memory a matrix representation would use for a graph of the given size.
+*/
+MemoryFootprint GraphRepresentationAdjacencyMatrix::estimate_footprint(int nb_vertices, int nb_edges) {
+    MemoryFootprint f = GraphRepresentation::estimate_footprint(nb_vertices, nb_edges);
+    f += matrix_footprint(nb_vertices);
+    return f;
+}
+
+/*
+Memory used by the lists, the index of neighbors and the matrix.
+*/
+MemoryFootprint GraphRepresentationAdjacencyMatrix::memory_footprint() const {
+    MemoryFootprint f = GraphRepresentation::memory_footprint();
+    if(matrix) f += matrix_footprint(nb_vertices);
+    return f;
+}
+
+/*
+Memory used by the matrix: one array of nb_vertices*nb_vertices edges.
+*/
+MemoryFootprint GraphRepresentationAdjacencyMatrix::matrix_footprint(int nb_vertices) {
+    MemoryFootprint f;
+    if(nb_vertices>0) {
+        f.add_allocations(1, sizeof(std::vector<Edge*>)+2*sizeof(long), &f.index_bytes);
+        f.add_allocations(1, static_cast<std::size_t>(nb_vertices)*nb_vertices*sizeof(Edge*), &f.index_bytes);
     }
-    delete[] matrix;
+    return f;
 }
 
 /*
@@ -75,140 +87,107 @@ GraphRepresentation &GraphRepresentationAdjacencyMatrix::operator=(const GraphRe
 
 /*
 Assignment operator. Has to be called after the copy() function.
-Updates Edge the matrix.
+The matrix is shared, like the topology it indexes.
 */
 GraphRepresentationAdjacencyMatrix& GraphRepresentationAdjacencyMatrix::operator=(const GraphRepresentationAdjacencyMatrix& g) {
     if(this==&g) {
         return *this;
     }
     else {
-        for(Edge* e : *edges) {
-            if(e) {
-                matrix[e->getV1()->getId()][e->getV2()->getId()] = e;
-                matrix[e->getV2()->getId()][e->getV1()->getId()] = e;
-            }
-        }
+        matrix = g.matrix;
         return *this;
     }
 }
 
-/* Creates an Edge. */
-Edge* GraphRepresentationAdjacencyMatrix::add_edge(const Vertex* v1, const Vertex* v2) {
-    Edge* e = GraphRepresentation::add_edge(v1, v2);
-    matrix[e->getV1()->getId()][e->getV2()->getId()] = e;
-    matrix[e->getV2()->getId()][e->getV1()->getId()] = e;
-    return e;
-}
-Edge* GraphRepresentationAdjacencyMatrix::add_edge(const Vertex* v1, const Vertex* v2, double c1, double c2) {
-    Edge* e = GraphRepresentation::add_edge(v1, v2, c1, c2);
-    matrix[e->getV1()->getId()][e->getV2()->getId()] = e;
-    matrix[e->getV2()->getId()][e->getV1()->getId()] = e;
-    return e;
-}
-Edge* GraphRepresentationAdjacencyMatrix::add_edge(const Vertex* v1, const Vertex* v2, unsigned char cr, unsigned char cg, unsigned char cb) {
-    Edge* e = GraphRepresentation::add_edge(v1, v2, cr, cg, cb);
-    matrix[e->getV1()->getId()][e->getV2()->getId()] = e;
-    matrix[e->getV2()->getId()][e->getV1()->getId()] = e;
-    return e;
-}
-Edge* GraphRepresentationAdjacencyMatrix::add_edge(const Vertex* v1, const Vertex* v2, double c1, double c2, unsigned char cr, unsigned char cg, unsigned char cb) {
+/*
+Creates an Edge. If the topology had to be copied, or if the matrix is
+shared with another representation, a new matrix is built.
+*/
+Edge* GraphRepresentationAdjacencyMatrix::add_edge(const Vertex* v1, const Vertex* v2, Weight c1, Weight c2, unsigned char cr, unsigned char cg, unsigned char cb) {
     Edge* e = GraphRepresentation::add_edge(v1, v2, c1, c2, cr, cg, cb);
-    matrix[e->getV1()->getId()][e->getV2()->getId()] = e;
-    matrix[e->getV2()->getId()][e->getV1()->getId()] = e;
+    if(!matrix || !matrix.unique()) {
+        build_matrix();
+    }
+    else {
+        (*matrix)[static_cast<std::size_t>(e->getV1Id())*nb_vertices+e->getV2Id()] = e;
+        (*matrix)[static_cast<std::size_t>(e->getV2Id())*nb_vertices+e->getV1Id()] = e;
+    }
     return e;
 }
-Edge* GraphRepresentationAdjacencyMatrix::add_edge(const Edge* e) {
-    GraphRepresentation::add_edge(e);
-    matrix[e->getV1()->getId()][e->getV2()->getId()] = const_cast<Edge*>(e);
-    matrix[e->getV2()->getId()][e->getV1()->getId()] = const_cast<Edge*>(e);
-    return const_cast<Edge*>(e);
-}
 
 /*
-Finds the path that links v1 to v2 and returns the edge.
+Creates a Vertex. If the topology had to be copied, the matrix is built
+again on the new edges.
 */
-Edge* GraphRepresentationAdjacencyMatrix::get_edge_from_to(const Vertex* v1, const Vertex* v2) const {
-    return matrix[v1->getId()][v2->getId()];
-}
-Edge* GraphRepresentationAdjacencyMatrix::get_edge_from_to(int id1, int id2) const {
-    return matrix[id1][id2];
+Vertex* GraphRepresentationAdjacencyMatrix::add_vertex(double x, double y) {
+    bool    shared = !topology.unique();
+    Vertex* v      = GraphRepresentation::add_vertex(x, y);
+    if(shared && matrix) build_matrix();
+    return v;
 }
 
 /*
-Finds the path that links v1 to v2 and returns its capacity (and not v2 to v1).
+Creates the edges in one pass, and builds the matrix once for all of them.
 */
-int GraphRepresentationAdjacencyMatrix::get_capacity_from_to(const Vertex* v1, const Vertex* v2) const {
-    Edge* e = matrix[v1->getId()][v2->getId()];
-    if(e) {
-        if(v1==e->getV1() && v2==e->getV2())      return e->getCapacityV1ToV2();
-        else if(v1==e->getV2() && v2==e->getV1()) return e->getCapacityV2ToV1();
-        else return 0;
-    }
-    else {
-        return 0;
-    }
-}
-int GraphRepresentationAdjacencyMatrix::get_capacity_from_to(int id1, int id2) const {
-    Edge* e = matrix[id1][id2];
-    if(e) {
-        if(id1==e->getV1()->getId() && id2==e->getV2()->getId())      return e->getCapacityV1ToV2();
-        else if(id1==e->getV2()->getId() && id2==e->getV1()->getId()) return e->getCapacityV2ToV1();
-        else return 0;
-    }
-    else {
-        return 0;
-    }
+void GraphRepresentationAdjacencyMatrix::add_edges(const std::vector<std::pair<int, int>>& pairs) {
+    GraphRepresentation::add_edges(pairs);
+    if(!topology->edges.empty()) build_matrix();
 }
 
 /*
-Returns the vertices connected to v or to which v is connected (both ways).
-Returns a vector.
+Builds the index of neighbors from the matrix.
 */
-std::vector<Vertex*> GraphRepresentationAdjacencyMatrix::get_all_neighbors(const Vertex* v) const {
-    std::vector<Vertex*> neighbors;
-    for(int i=0 ; i<nb_vertices ; i++) {
-        if(matrix[v->getId()][i]) {
-            neighbors.push_back(vertices->at(i));
+void GraphRepresentationAdjacencyMatrix::build_index() const {
+    std::shared_ptr<AdjacencyIndex> i = std::make_shared<AdjacencyIndex>();
+    i->offsets.reserve(static_cast<std::size_t>(nb_vertices)+1);
+    i->neighbors.reserve(2*topology->edges.size());
+    i->offsets.push_back(0);
+    for(int v=0 ; v<nb_vertices ; v++) {
+        if(matrix) {
+            Edge* const* row = matrix->data()+static_cast<std::size_t>(v)*nb_vertices;
+            for(int n=0 ; n<nb_vertices ; n++) {
+                if(row[n]) i->neighbors.push_back(Neighbor{topology->vertices[n], row[n]});
+            }
         }
+        i->offsets.push_back(i->neighbors.size());
     }
-    return neighbors;
+    index = i;
 }
 
-/* Returns the vertices connected to v or to which v is connected (both ways).
-Returns a set.
+/*
+Builds the matrix from the list of edges.
 */
-std::set<Vertex*> GraphRepresentationAdjacencyMatrix::get_all_neighbors_set(const Vertex* v) const {
-    std::set<Vertex*> neighbors;
-    for(int i=0 ; i<nb_vertices ; i++) {
-        if(matrix[v->getId()][i]) {
-            neighbors.insert(vertices->at(i));
-        }
+void GraphRepresentationAdjacencyMatrix::build_matrix() {
+    matrix = std::make_shared<std::vector<Edge*>>(static_cast<std::size_t>(nb_vertices)*nb_vertices, nullptr);
+    for(Edge* e : topology->edges) {
+        (*matrix)[static_cast<std::size_t>(e->getV1Id())*nb_vertices+e->getV2Id()] = e;
+        (*matrix)[static_cast<std::size_t>(e->getV2Id())*nb_vertices+e->getV1Id()] = e;
     }
-    return neighbors;
 }
 
 /*
-Returns the vertices to which v is connected (one way).
+Finds the path that links v1 to v2 and returns the edge.
 */
-std::vector<Vertex*> GraphRepresentationAdjacencyMatrix::get_direct_neighbors(const Vertex* v, GRAPH_ORIENTATION orientation) const {
-    std::vector<Vertex*> neighbors;
-    for(int i=0 ; i<nb_vertices ; i++) {
-        Edge* e = matrix[v->getId()][i];
-        if(e) {
-            Vertex* v2 = vertices->at(i);
-            if((orientation==GRAPH_ORIENTATION::ONE_WAY && v==e->getV1() && v2==e->getV2()) || orientation==GRAPH_ORIENTATION::NONE || orientation==GRAPH_ORIENTATION::TWO_WAYS) neighbors.push_back(v2);
-        }
-    }
-    return neighbors;
+Edge* GraphRepresentationAdjacencyMatrix::get_edge_from_to(const Vertex* v1, const Vertex* v2) const {
+    return edge(v1->getId(), v2->getId());
+}
+Edge* GraphRepresentationAdjacencyMatrix::get_edge_from_to(int id1, int id2) const {
+    return edge(id1, id2);
+}
+
+/*
+Finds the path that links v1 to v2 and returns its capacity (and not v2 to v1).
+*/
+Weight GraphRepresentationAdjacencyMatrix::get_capacity_from_to(const Vertex* v1, const Vertex* v2) const {
+    return capacity(v1->getId(), v2->getId());
+}
+Weight GraphRepresentationAdjacencyMatrix::get_capacity_from_to(int id1, int id2) const {
+    return capacity(id1, id2);
 }
 
 /*
 Sets the capacity from a Vertex to another one.
 */
-void GraphRepresentationAdjacencyMatrix::set_capacity_from_to(const Vertex* v1, const Vertex* v2, double c) {
-    Edge* e = matrix[v1->getId()][v2->getId()];
-    if(e) {
-        if(v1==e->getV1() && v2==e->getV2())      e->setCapacityV1ToV2(c);
-        else if(v1==e->getV2() && v2==e->getV1()) e->setCapacityV2ToV1(c);
-    }
+void GraphRepresentationAdjacencyMatrix::set_capacity_from_to(const Vertex* v1, const Vertex* v2, Weight c) {
+    set_capacity(v1->getId(), v2->getId(), c);
 }
@@ -27,7 +27,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "GraphRepresentation.hpp"
 #include "components/Vertex.hpp"
 
-class GraphRepresentationAdjacencyMatrix : public GraphRepresentation {
+/*
+Graph stored as a matrix of edges, indexed by the identifiers of their
+end points. The matrix is shared between copies, like the topology.
+The neighbors of each vertex are also stored in one array, built on
+first use, so that they can be listed without scanning a row of the
+matrix. The inline functions below are the ones used by the algorithm
+templates (see graph/algorithms.hpp), the virtual ones are built on them.
+*/
+class GraphRepresentationAdjacencyMatrix final : public GraphRepresentation {
 
     public:
     
@@ -38,24 +46,69 @@ class GraphRepresentationAdjacencyMatrix : public GraphRepresentation {
         ~GraphRepresentationAdjacencyMatrix();
         GraphRepresentationAdjacencyMatrix& operator=(const GraphRepresentationAdjacencyMatrix&);
     
-        Edge*                add_edge(const Vertex*, const Vertex*);
-        Edge*                add_edge(const Vertex*, const Vertex*, double, double);
-        Edge*                add_edge(const Vertex*, const Vertex*, unsigned char, unsigned char, unsigned char);
-        Edge*                add_edge(const Vertex*, const Vertex*, double, double, unsigned char, unsigned char, unsigned char);
-        Edge*                add_edge(const Edge*);
-        Edge*                get_edge_from_to(int, int)                                  const;
-        Edge*                get_edge_from_to(const Vertex*, const Vertex*)              const;
-        int                  get_capacity_from_to(const Vertex*, const Vertex*)          const;
-        int                  get_capacity_from_to(int, int)                              const;
-        std::vector<Vertex*> get_all_neighbors(const Vertex*)                            const;
-        std::set<Vertex*>    get_all_neighbors_set(const Vertex*)                        const;
-        std::vector<Vertex*> get_direct_neighbors(const Vertex*, GRAPH_ORIENTATION)      const;
-        void                 set_capacity_from_to(const Vertex*, const Vertex*, double);
+ static MemoryFootprint estimate_footprint(int, int);
+        MemoryFootprint memory_footprint() const;
+    
+        using GraphRepresentation::add_edge;
+    
+        Weight        capacity(int, int)       const;
+        Edge*         edge(int i, int j)       const { return matrix ? (*matrix)[static_cast<std::size_t>(i)*nb_vertices+j] : 0; }
+        NeighborRange neighbors(const Vertex*) const;
+        void          set_capacity(int, int, Weight);
+    
+        Edge*   add_edge(const Vertex*, const Vertex*, Weight, Weight, unsigned char, unsigned char, unsigned char);
+        void    add_edges(const std::vector<std::pair<int, int>>&);
+        Vertex* add_vertex(double=0, double=0);
+        Edge*   get_edge_from_to(int, int)                                  const;
+        Edge*   get_edge_from_to(const Vertex*, const Vertex*)              const;
+        Weight  get_capacity_from_to(const Vertex*, const Vertex*)          const;
+        Weight  get_capacity_from_to(int, int)                              const;
+        void    set_capacity_from_to(const Vertex*, const Vertex*, Weight);
     
     private:
     
-        Edge*** matrix;   /* adjacency matrix */
+ static MemoryFootprint matrix_footprint(int);
+    
+        void build_index() const;
+        void build_matrix();
+    
+        std::shared_ptr<std::vector<Edge*>> matrix;   /* adjacency matrix, row by row, shared with the copies */
 
 };
 
+/*
+Capacity of the arc from vertex id1 to vertex id2.
+*/
+inline Weight GraphRepresentationAdjacencyMatrix::capacity(int id1, int id2) const {
+    Edge* e = edge(id1, id2);
+    if(e) {
+        if(id1==get_v1_id(e) && id2==get_v2_id(e))      return get_capacity_v1_to_v2(e);
+        else if(id1==get_v2_id(e) && id2==get_v1_id(e)) return get_capacity_v2_to_v1(e);
+        else return 0;
+    }
+    else {
+        return 0;
+    }
+}
+
+/*
+Returns the vertices connected to v or to which v is connected (both
+ways), by increasing identifier. Builds the index on the first call.
+*/
+inline NeighborRange GraphRepresentationAdjacencyMatrix::neighbors(const Vertex* v) const {
+    if(!index) build_index();
+    return indexed_neighbors(v->getId());
+}
+
+/*
+Sets the capacity of the arc from vertex id1 to vertex id2.
+*/
+inline void GraphRepresentationAdjacencyMatrix::set_capacity(int id1, int id2, Weight c) {
+    Edge* e = edge(id1, id2);
+    if(e) {
+        if(id1==get_v1_id(e) && id2==get_v2_id(e))      set_capacity_v1_to_v2(e, c);
+        else if(id1==get_v2_id(e) && id2==get_v1_id(e)) set_capacity_v2_to_v1(e, c);
+    }
+}
+
 #endif
@@ -0,0 +1,209 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GraphRepresentationBitMatrix.hpp"
+
+/*
+Initializes the variables. The matrix is allocated with the first edge.
+Rows are rounded up to a whole number of cache lines.
+*/
+GraphRepresentationBitMatrix::GraphRepresentationBitMatrix(int nb_vertices) :
+    GraphRepresentation(nb_vertices),
+    words((static_cast<std::size_t>(nb_vertices)+WORDS_PER_LINE*64-1)/(WORDS_PER_LINE*64)*WORDS_PER_LINE) {
+}
+
+/*
+Copy constructor.
+*/
+GraphRepresentationBitMatrix::GraphRepresentationBitMatrix(const GraphRepresentationBitMatrix& g) :
+    GraphRepresentation(g),
+    words(g.words) {
+    *this = g;
+}
+
+/*
+The matrix is deleted with the last representation sharing it.
+*/
+GraphRepresentationBitMatrix::~GraphRepresentationBitMatrix() {
+}
+
+const std::size_t GraphRepresentationBitMatrix::WORDS_PER_LINE;
+
+/*
+Memory a bit matrix representation would use for a graph of the given size.
+*/
+MemoryFootprint GraphRepresentationBitMatrix::estimate_footprint(int nb_vertices, int nb_edges) {
+    MemoryFootprint f = GraphRepresentation::estimate_footprint(nb_vertices, nb_edges);
+    f += bits_footprint(nb_vertices);
+    return f;
+}
+
+/*
+Memory used by the lists, the index of neighbors and the matrix.
+*/
+MemoryFootprint GraphRepresentationBitMatrix::memory_footprint() const {
+    MemoryFootprint f = GraphRepresentation::memory_footprint();
+    if(bits) f += bits_footprint(nb_vertices);
+    return f;
+}
+
+/*
+Memory used by the matrix: nb_vertices rows of whole cache lines, plus
+one cache line to align them.
+*/
+MemoryFootprint GraphRepresentationBitMatrix::bits_footprint(int nb_vertices) {
+    MemoryFootprint f;
+    std::size_t     words = (static_cast<std::size_t>(nb_vertices)+WORDS_PER_LINE*64-1)/(WORDS_PER_LINE*64)*WORDS_PER_LINE;
+    f.add_allocations(1, sizeof(std::vector<std::uint64_t>)+2*sizeof(long), &f.index_bytes);
+    f.add_allocations(1, (static_cast<std::size_t>(nb_vertices)*words+WORDS_PER_LINE-1)*sizeof(std::uint64_t), &f.index_bytes);
+    return f;
+}
+
+/*
+Overloaded assignment operator. Updates the list of edges and vertices.
+*/
+GraphRepresentation &GraphRepresentationBitMatrix::operator=(const GraphRepresentation& g) {
+    copy(g);
+    return operator=(dynamic_cast<const GraphRepresentationBitMatrix&>(g));
+}
+
+/*
+Assignment operator. Has to be called after the copy() function.
+The matrix is shared, like the topology.
+*/
+GraphRepresentationBitMatrix& GraphRepresentationBitMatrix::operator=(const GraphRepresentationBitMatrix& g) {
+    if(this==&g) {
+        return *this;
+    }
+    else {
+        bits = g.bits;
+        return *this;
+    }
+}
+
+/*
+Creates an Edge. If the matrix is shared with another representation,
+a new matrix is built.
+*/
+Edge* GraphRepresentationBitMatrix::add_edge(const Vertex* v1, const Vertex* v2, Weight c1, Weight c2, unsigned char cr, unsigned char cg, unsigned char cb) {
+    Edge* e = GraphRepresentation::add_edge(v1, v2, c1, c2, cr, cg, cb);
+    if(!bits || !bits.unique()) {
+        build_bits();
+    }
+    else {
+        std::uint64_t* r1 = const_cast<std::uint64_t*>(row(v1->getId()));
+        std::uint64_t* r2 = const_cast<std::uint64_t*>(row(v2->getId()));
+        r1[v2->getId()/64] |= std::uint64_t(1)<<(v2->getId()%64);
+        r2[v1->getId()/64] |= std::uint64_t(1)<<(v1->getId()%64);
+    }
+    return e;
+}
+
+/*
+Builds the matrix from the list of edges.
+*/
+void GraphRepresentationBitMatrix::build_bits() {
+    bits = std::make_shared<std::vector<std::uint64_t>>(static_cast<std::size_t>(nb_vertices)*words+WORDS_PER_LINE-1, 0);
+    for(Edge* e : topology->edges) {
+        int            id1 = e->getV1Id();
+        int            id2 = e->getV2Id();
+        std::uint64_t* r1  = const_cast<std::uint64_t*>(row(id1));
+        std::uint64_t* r2  = const_cast<std::uint64_t*>(row(id2));
+        r1[id2/64] |= std::uint64_t(1)<<(id2%64);
+        r2[id1/64] |= std::uint64_t(1)<<(id1%64);
+    }
+}
+
+/*
+Creates the edges in one pass, and builds the matrix of bits once for all of them.
+*/
+void GraphRepresentationBitMatrix::add_edges(const std::vector<std::pair<int, int>>& pairs) {
+    GraphRepresentation::add_edges(pairs);
+    if(!topology->edges.empty()) build_bits();
+}
+
+/*
+Builds the index of neighbors: the set bits of each row are found a word
+at a time, and the edges are matched through the lists of edges.
+*/
+void GraphRepresentationBitMatrix::build_index() const {
+    std::shared_ptr<AdjacencyIndex> i = std::make_shared<AdjacencyIndex>();
+    i->offsets.assign(static_cast<std::size_t>(nb_vertices)+1, 0);
+    if(!bits) {
+        index = i;
+        return;
+    }
+    for(int v=0 ; v<nb_vertices ; v++) {
+        i->offsets[v+1] = i->offsets[v]+row_count(row(v), words);
+    }
+    i->neighbors.resize(i->offsets.back());
+    /* lists the neighbors of each vertex in the order of the rows */
+    std::size_t next = 0;
+    for(int v=0 ; v<nb_vertices ; v++) {
+        const std::uint64_t* r = row(v);
+        for(std::size_t w=0 ; w<words ; w++) {
+            for(std::uint64_t word=r[w] ; word ; word&=word-1) {
+                i->neighbors[next++].vertex = topology->vertices[w*64+__builtin_ctzll(word)];
+            }
+        }
+    }
+    /* finds the edge of each neighbor */
+    for(Edge* e : topology->edges) {
+        for(int k=0 ; k<2 ; k++) {
+            int       v     = k ? e->getV2Id() : e->getV1Id();
+            int       n     = k ? e->getV1Id() : e->getV2Id();
+            Neighbor* first = i->neighbors.data()+i->offsets[v];
+            Neighbor* last  = i->neighbors.data()+i->offsets[v+1];
+            Neighbor* it    = std::lower_bound(first, last, n, [](const Neighbor& a, int id) { return a.vertex->getId()<id; });
+            it->edge = e;
+        }
+    }
+    index = i;
+}
+
+/*
+Finds the path that links v1 to v2 and returns the edge.
+*/
+Edge* GraphRepresentationBitMatrix::get_edge_from_to(const Vertex* v1, const Vertex* v2) const {
+    return edge(v1->getId(), v2->getId());
+}
+Edge* GraphRepresentationBitMatrix::get_edge_from_to(int id1, int id2) const {
+    return edge(id1, id2);
+}
+
+/*
+Finds the path that links v1 to v2 and returns its capacity (and not v2 to v1).
+*/
+Weight GraphRepresentationBitMatrix::get_capacity_from_to(const Vertex* v1, const Vertex* v2) const {
+    return capacity(v1->getId(), v2->getId());
+}
+Weight GraphRepresentationBitMatrix::get_capacity_from_to(int id1, int id2) const {
+    return capacity(id1, id2);
+}
+
+/*
+Sets the capacity from a Vertex to another one.
+*/
+void GraphRepresentationBitMatrix::set_capacity_from_to(const Vertex* v1, const Vertex* v2, Weight c) {
+    set_capacity(v1->getId(), v2->getId(), c);
+}
@@ -0,0 +1,216 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GraphRepresentationBitMatrix_hpp
+#define GraphRepresentationBitMatrix_hpp
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
+
+#include "GraphRepresentation.hpp"
+#include "components/Vertex.hpp"
+
+/*
+Graph stored as a matrix of bits: bit j of row i is set if vertices i
+and j are linked. Rows start on a cache line and are a whole number of
+cache lines long, so that they can be combined with SIMD instructions.
+The matrix is allocated with the first edge, the rows can only be used
+once the graph has edges. The edges are found through the index of
+neighbors, by binary search. The matrix is shared between copies, like
+the topology.
+The inline functions below are the ones used by the algorithm templates
+(see graph/algorithms.hpp), the virtual ones are built on them.
+*/
+class GraphRepresentationBitMatrix final : public GraphRepresentation {
+
+    public:
+    
+        GraphRepresentation& operator=(const GraphRepresentation&);
+    
+        GraphRepresentationBitMatrix(int nb_vertices);
+        GraphRepresentationBitMatrix(const GraphRepresentationBitMatrix&);
+        ~GraphRepresentationBitMatrix();
+        GraphRepresentationBitMatrix& operator=(const GraphRepresentationBitMatrix&);
+    
+ static MemoryFootprint estimate_footprint(int, int);
+        MemoryFootprint memory_footprint() const;
+    
+        using GraphRepresentation::add_edge;
+    
+        bool                 adjacent(int i, int j)   const { return bits && (row(i)[j/64]>>(j%64))&1; }
+        Weight               capacity(int, int)       const;
+        Edge*                edge(int, int)           const;
+        NeighborRange        neighbors(const Vertex*) const;
+        const std::uint64_t* row(int i)               const;
+        std::size_t          row_words()              const { return words; }
+        void                 set_capacity(int, int, Weight);
+    
+ static void        row_and(const std::uint64_t*, const std::uint64_t*, std::uint64_t*, std::size_t);
+ static void        row_andnot(const std::uint64_t*, const std::uint64_t*, std::uint64_t*, std::size_t);
+ static std::size_t row_count(const std::uint64_t*, std::size_t);
+ static bool        row_empty(const std::uint64_t*, std::size_t);
+ static int         row_first(const std::uint64_t*, std::size_t);
+    
+        Edge*  add_edge(const Vertex*, const Vertex*, Weight, Weight, unsigned char, unsigned char, unsigned char);
+        void   add_edges(const std::vector<std::pair<int, int>>&);
+        Edge*  get_edge_from_to(int, int)                                  const;
+        Edge*  get_edge_from_to(const Vertex*, const Vertex*)              const;
+        Weight get_capacity_from_to(const Vertex*, const Vertex*)          const;
+        Weight get_capacity_from_to(int, int)                              const;
+        void   set_capacity_from_to(const Vertex*, const Vertex*, Weight);
+    
+    private:
+    
+ static const std::size_t WORDS_PER_LINE = 8;   /* number of 64 bits words in a cache line */
+    
+ static MemoryFootprint bits_footprint(int);
+    
+        void build_bits();
+        void build_index() const;
+    
+        std::shared_ptr<std::vector<std::uint64_t>> bits;    /* rows of the matrix, with room to align them on a cache line, shared with the copies */
+  const std::size_t                                 words;   /* number of words in a row */
+
+};
+
+/*
+Capacity of the arc from vertex id1 to vertex id2.
+*/
+inline Weight GraphRepresentationBitMatrix::capacity(int id1, int id2) const {
+    Edge* e = edge(id1, id2);
+    if(e) {
+        if(id1==get_v1_id(e) && id2==get_v2_id(e))      return get_capacity_v1_to_v2(e);
+        else if(id1==get_v2_id(e) && id2==get_v1_id(e)) return get_capacity_v2_to_v1(e);
+        else return 0;
+    }
+    else {
+        return 0;
+    }
+}
+
+/*
+Edge linking vertices id1 and id2, or 0. The bit is tested first, the
+edge is then searched among the neighbors of id1.
+*/
+inline Edge* GraphRepresentationBitMatrix::edge(int id1, int id2) const {
+    if(!adjacent(id1, id2)) return 0;
+    NeighborRange   n  = neighbors(topology->vertices[id1]);
+    const Neighbor* it = std::lower_bound(n.begin(), n.end(), id2, [](const Neighbor& a, int id) { return a.vertex->getId()<id; });
+    return it->edge;
+}
+
+/*
+Returns the vertices connected to v or to which v is connected (both
+ways), by increasing identifier. Builds the index on the first call.
+*/
+inline NeighborRange GraphRepresentationBitMatrix::neighbors(const Vertex* v) const {
+    if(!index) build_index();
+    return indexed_neighbors(v->getId());
+}
+
+/*
+Row of vertex i.
+*/
+inline const std::uint64_t* GraphRepresentationBitMatrix::row(int i) const {
+    std::uintptr_t first = (reinterpret_cast<std::uintptr_t>(bits->data())+WORDS_PER_LINE*8-1) & ~static_cast<std::uintptr_t>(WORDS_PER_LINE*8-1);
+    return reinterpret_cast<const std::uint64_t*>(first)+static_cast<std::size_t>(i)*words;
+}
+
+/*
+Bitwise and of two rows of n words, n being a whole number of cache lines.
+*/
+inline void GraphRepresentationBitMatrix::row_and(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* result, std::size_t n) {
+#if defined(__SSE2__)
+    for(std::size_t i=0 ; i<n ; i+=2) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a+i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b+i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result+i), _mm_and_si128(x, y));
+    }
+#elif defined(__ARM_NEON)
+    for(std::size_t i=0 ; i<n ; i+=2) vst1q_u64(result+i, vandq_u64(vld1q_u64(a+i), vld1q_u64(b+i)));
+#else
+    for(std::size_t i=0 ; i<n ; i++) result[i] = a[i] & b[i];
+#endif
+}
+
+/*
+Bits of row a that are not in row b, for rows of n words, n being a whole
+number of cache lines.
+*/
+inline void GraphRepresentationBitMatrix::row_andnot(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* result, std::size_t n) {
+#if defined(__SSE2__)
+    for(std::size_t i=0 ; i<n ; i+=2) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a+i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b+i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result+i), _mm_andnot_si128(y, x));
+    }
+#elif defined(__ARM_NEON)
+    for(std::size_t i=0 ; i<n ; i+=2) vst1q_u64(result+i, vbicq_u64(vld1q_u64(a+i), vld1q_u64(b+i)));
+#else
+    for(std::size_t i=0 ; i<n ; i++) result[i] = a[i] & ~b[i];
+#endif
+}
+
+/*
+Number of bits set in a row of n words.
+*/
+inline std::size_t GraphRepresentationBitMatrix::row_count(const std::uint64_t* a, std::size_t n) {
+    std::size_t count = 0;
+    for(std::size_t i=0 ; i<n ; i++) count += __builtin_popcountll(a[i]);
+    return count;
+}
+
+/*
+True if no bit is set in a row of n words.
+*/
+inline bool GraphRepresentationBitMatrix::row_empty(const std::uint64_t* a, std::size_t n) {
+    for(std::size_t i=0 ; i<n ; i++) if(a[i]) return false;
+    return true;
+}
+
+/*
+Index of the first bit set in a row of n words, or -1.
+*/
+inline int GraphRepresentationBitMatrix::row_first(const std::uint64_t* a, std::size_t n) {
+    for(std::size_t i=0 ; i<n ; i++) if(a[i]) return static_cast<int>(i*64)+__builtin_ctzll(a[i]);
+    return -1;
+}
+
+/*
+Sets the capacity of the arc from vertex id1 to vertex id2.
+*/
+inline void GraphRepresentationBitMatrix::set_capacity(int id1, int id2, Weight c) {
+    Edge* e = edge(id1, id2);
+    if(e) {
+        if(id1==get_v1_id(e) && id2==get_v2_id(e))      set_capacity_v1_to_v2(e, c);
+        else if(id1==get_v2_id(e) && id2==get_v1_id(e)) set_capacity_v2_to_v1(e, c);
+    }
+}
+
+#endif
@@ -0,0 +1,64 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NeighborRange_hpp
+#define NeighborRange_hpp
+
+#include <cstddef>
+
+#include "components/Edge.hpp"
+#include "components/Vertex.hpp"
+
+/*
+A neighbor of a vertex, and the edge linking them.
+*/
+struct Neighbor {
+    Vertex* vertex;   /* neighbor */
+    Edge*   edge;     /* edge linking the vertex to the neighbor */
+};
+
+/*
+Neighbors of a vertex, as a range over an array owned by the graph
+representation. Iterating over it does not allocate. The range is
+invalidated when a vertex or an edge is added to the representation.
+*/
+class NeighborRange {
+
+    public:
+    
+        NeighborRange()                                     : first(0), last(0) {}
+        NeighborRange(const Neighbor* f, const Neighbor* l) : first(f), last(l) {}
+    
+        const Neighbor* begin() const { return first; }
+        const Neighbor* end()   const { return last; }
+        bool            empty() const { return first==last; }
+        std::size_t     size()  const { return static_cast<std::size_t>(last-first); }
+    
+    private:
+    
+        const Neighbor* first;   /* first neighbor */
+        const Neighbor* last;    /* past the last neighbor */
+
+};
+
+#endif
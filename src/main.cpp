@@ -22,16 +22,60 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <iostream>
+#include <vector>
 
+#include "concurrency/ThreadPool.hpp"
 #include "graph/Graph.hpp"
 #include "components/Vertex.hpp"
 #include "rendering/Window.hpp"
 
 int main(int argc, const char * argv[]) {
 
-    /* rand initialization */
-    srand(static_cast<unsigned int>(time(NULL)));
+    /* arguments, see README.md */
+    bool                         bench      = false;
+    std::vector<GRAPH_GENERATOR> generators;
+    std::vector<VERTEX_ORDERING> orderings;
+    uint64_t                     seed       = static_cast<uint64_t>(time(NULL));
+    std::vector<int>             sizes;
+    GRAPH_TYPE                   type       = ADJACENCY_MATRIX;
+    for(int i=1 ; i<argc ; i++) {
+        GRAPH_GENERATOR generator;
+        VERTEX_ORDERING ordering;
+        if(!strcmp(argv[i], "--bench"))                      bench = true;
+        else if(!strcmp(argv[i], "--bit-matrix"))            type  = ADJACENCY_BIT_MATRIX;
+        else if(!strcmp(argv[i], "--seed") && i+1<argc)     seed  = strtoull(argv[++i], 0, 10);
+        else if(!strcmp(argv[i], "--threads") && i+1<argc)   ThreadPool::setNbThreads(atoi(argv[++i]));
+        else if(!strcmp(argv[i], "--generator") && i+1<argc) {
+            if(Graph::parse_generator(argv[++i], &generator)) generators.push_back(generator);
+            else std::cerr << "unknown generator: " << argv[i] << std::endl;
+        }
+        else if(!strcmp(argv[i], "--reorder") && i+1<argc) {
+            if(Graph::parse_ordering(argv[++i], &ordering)) orderings.push_back(ordering);
+            else std::cerr << "unknown ordering: " << argv[i] << std::endl;
+        }
+        else if(!strcmp(argv[i], "--vertices") && i+1<argc) {
+            for(char* s=const_cast<char*>(argv[++i]) ; *s ; ) {
+                sizes.push_back(static_cast<int>(strtol(s, &s, 10)));
+                if(*s==',') s++;
+                else break;
+            }
+        }
+        else std::cerr << "unknown argument: " << argv[i] << std::endl;
+    }
+    std::cout << "seed: " << seed << std::endl;
+    Graph::setSeed(seed);
+    if(sizes.empty()) sizes.push_back(60);
+    
+    /* benchmark of the algorithms, on all the generators if none is given */
+    if(bench) {
+        if(generators.empty()) generators = {GABRIEL, GRID, GEOMETRIC, ERDOS_RENYI, RMAT};
+        for(GRAPH_GENERATOR g : generators) Graph::benchmark(type, g, sizes, orderings);
+        return 0;
+    }
     
     /* rendering */
     Window window;
@@ -39,7 +83,8 @@ int main(int argc, const char * argv[]) {
     Graph::setWindow(&window);
     
     /* graph creation */
-    Graph *graph = new Graph(ADJACENCY_MATRIX, 60);
+    Graph *graph = new Graph(type, sizes.front());
+    if(!generators.empty()) graph->setGenerator(generators.front());
     graph->generate();
     graph->display();
 
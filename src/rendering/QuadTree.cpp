@@ -0,0 +1,189 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "constants/Constants.hpp"
+#include "QuadTree.hpp"
+
+/*
+Builds the tree over the vertices' coordinates. Every vertex is stored
+in a leaf and every edge in the smallest node that contains it entirely.
+Both arrays are sorted in pre-order so that the content of a subtree is
+a contiguous range, which makes fully visible subtrees a single copy.
+*/
+QuadTree::QuadTree(const std::vector<Vertex*>* graph_vertices, const std::vector<Edge*>* graph_edges) {
+    by_id.assign(graph_vertices->begin(), graph_vertices->end());
+    vertices = by_id;
+    double min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+    if(!vertices.empty()) {
+        min_x = max_x = vertices[0]->getX();
+        min_y = max_y = vertices[0]->getY();
+        for(const Vertex* v : vertices) {
+            min_x = std::min(min_x, v->getX()); max_x = std::max(max_x, v->getX());
+            min_y = std::min(min_y, v->getY()); max_y = std::max(max_y, v->getY());
+        }
+    }
+    double size = std::max(max_x-min_x, max_y-min_y)*0.5 + 1e-9;
+    double cx   = 0.5*(min_x+max_x);
+    double cy   = 0.5*(min_y+max_y);
+    build(cx-size, cy-size, cx+size, cy+size, 0, static_cast<int>(vertices.size()), 0);
+    /* sorts the edges by node with a counting sort */
+    std::vector<int> location(graph_edges->size());
+    std::vector<int> count(nodes.size()+1, 0);
+    for(unsigned long int i=0 ; i<graph_edges->size() ; i++) {
+        location[i] = locate(graph_edges->at(i));
+        count[location[i]+1]++;
+    }
+    for(unsigned long int i=0 ; i<nodes.size() ; i++) {
+        count[i+1]          += count[i];
+        nodes[i].e_begin     = count[i];
+        nodes[i].e_own_end   = count[i+1];
+        nodes[i].e_end       = count[i+1];
+    }
+    edges.resize(graph_edges->size());
+    for(unsigned long int i=0 ; i<graph_edges->size() ; i++) {
+        edges[count[location[i]]++] = graph_edges->at(i);
+    }
+    for(int i=static_cast<int>(nodes.size())-1 ; i>=0 ; i--) {
+        for(int c : nodes[i].children) {
+            if(c>=0) nodes[i].e_end = std::max(nodes[i].e_end, nodes[c].e_end);
+        }
+    }
+}
+
+/*
+Recursively creates the node covering the given area and the vertices
+in [begin, end). Returns the index of the node.
+*/
+int QuadTree::build(double min_x, double min_y, double max_x, double max_y, int begin, int end, int depth) {
+    int index = static_cast<int>(nodes.size());
+    Node node = {min_x, min_y, max_x, max_y, {-1, -1, -1, -1}, begin, end, 0, 0, 0};
+    nodes.push_back(node);
+    if(end-begin>Constants::RENDER_QUADTREE_LEAF_SIZE && depth<Constants::RENDER_QUADTREE_MAX_DEPTH) {
+        double mid_x = 0.5*(min_x+max_x);
+        double mid_y = 0.5*(min_y+max_y);
+        std::vector<const Vertex*>::iterator first  = vertices.begin()+begin;
+        std::vector<const Vertex*>::iterator last   = vertices.begin()+end;
+        std::vector<const Vertex*>::iterator top    = std::partition(first, last, [=](const Vertex* v) { return v->getY()<mid_y; });
+        std::vector<const Vertex*>::iterator bottom = std::partition(first, top,  [=](const Vertex* v) { return v->getX()<mid_x; });
+        std::vector<const Vertex*>::iterator upper  = std::partition(top, last,   [=](const Vertex* v) { return v->getX()<mid_x; });
+        int b = static_cast<int>(bottom-vertices.begin());
+        int t = static_cast<int>(top-vertices.begin());
+        int u = static_cast<int>(upper-vertices.begin());
+        int c0 = build(min_x, min_y, mid_x, mid_y, begin, b, depth+1);
+        int c1 = build(mid_x, min_y, max_x, mid_y, b, t, depth+1);
+        int c2 = build(min_x, mid_y, mid_x, max_y, t, u, depth+1);
+        int c3 = build(mid_x, mid_y, max_x, max_y, u, end, depth+1);
+        nodes[index].children[0] = c0;
+        nodes[index].children[1] = c1;
+        nodes[index].children[2] = c2;
+        nodes[index].children[3] = c3;
+    }
+    return index;
+}
+
+/*
+Returns the smallest node that entirely contains the edge.
+*/
+int QuadTree::locate(const Edge* e) const {
+    const Vertex* v1    = by_id[e->getV1Id()];
+    const Vertex* v2    = by_id[e->getV2Id()];
+    double        min_x = std::min(v1->getX(), v2->getX());
+    double        max_x = std::max(v1->getX(), v2->getX());
+    double        min_y = std::min(v1->getY(), v2->getY());
+    double        max_y = std::max(v1->getY(), v2->getY());
+    int           index = 0;
+    bool          found = true;
+    while(found) {
+        found = false;
+        for(int c : nodes[index].children) {
+            if(c>=0 && nodes[c].min_x<=min_x && max_x<=nodes[c].max_x && nodes[c].min_y<=min_y && max_y<=nodes[c].max_y) {
+                index = c;
+                found = true;
+                break;
+            }
+        }
+    }
+    return index;
+}
+
+/*
+Appends the vertices inside the rectangle and the edges whose bounding
+box intersects it. The cost depends on the number of visible elements,
+not on the size of the graph.
+*/
+void QuadTree::query(double min_x, double min_y, double max_x, double max_y, std::vector<const Vertex*>* visible_vertices, std::vector<const Edge*>* visible_edges) const {
+    if(nodes.empty()) return;
+    std::vector<int> stack(1, 0);
+    while(!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if(node.max_x<min_x || node.min_x>max_x || node.max_y<min_y || node.min_y>max_y) continue;
+        if(min_x<=node.min_x && node.max_x<=max_x && min_y<=node.min_y && node.max_y<=max_y) {
+            visible_vertices->insert(visible_vertices->end(), vertices.begin()+node.v_begin, vertices.begin()+node.v_end);
+            visible_edges->insert(visible_edges->end(), edges.begin()+node.e_begin, edges.begin()+node.e_end);
+            continue;
+        }
+        for(int i=node.e_begin ; i<node.e_own_end ; i++) {
+            const Edge* e = edges[i];
+            double x1 = by_id[e->getV1Id()]->getX(), y1 = by_id[e->getV1Id()]->getY();
+            double x2 = by_id[e->getV2Id()]->getX(), y2 = by_id[e->getV2Id()]->getY();
+            if(std::max(x1, x2)>=min_x && std::min(x1, x2)<=max_x && std::max(y1, y2)>=min_y && std::min(y1, y2)<=max_y) {
+                visible_edges->push_back(e);
+            }
+        }
+        if(node.children[0]<0) {
+            for(int i=node.v_begin ; i<node.v_end ; i++) {
+                const Vertex* v = vertices[i];
+                if(v->getX()>=min_x && v->getX()<=max_x && v->getY()>=min_y && v->getY()<=max_y) visible_vertices->push_back(v);
+            }
+        }
+        else {
+            for(int c : node.children) stack.push_back(c);
+        }
+    }
+}
+
+/*
+Appends the non empty nodes intersecting the rectangle whose size is at
+most tile_size, or the leaves if they are bigger. Used to draw the graph
+as density tiles when it is too zoomed out for the details to be visible.
+*/
+void QuadTree::tiles(double min_x, double min_y, double max_x, double max_y, double tile_size, std::vector<Tile>* visible_tiles) const {
+    if(nodes.empty()) return;
+    std::vector<int> stack(1, 0);
+    while(!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if(node.v_begin==node.v_end) continue;
+        if(node.max_x<min_x || node.min_x>max_x || node.max_y<min_y || node.min_y>max_y) continue;
+        if(node.children[0]<0 || node.max_x-node.min_x<=tile_size) {
+            Tile tile = {node.min_x, node.min_y, node.max_x, node.max_y, node.v_end-node.v_begin};
+            visible_tiles->push_back(tile);
+        }
+        else {
+            for(int c : node.children) stack.push_back(c);
+        }
+    }
+}
@@ -0,0 +1,78 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef QuadTree_hpp
+#define QuadTree_hpp
+
+#include <vector>
+
+#include "components/Edge.hpp"
+#include "components/Vertex.hpp"
+
+class QuadTree {
+
+    public:
+    
+        struct Tile {
+            double min_x;          /* left bound of the tile */
+            double min_y;          /* bottom bound of the tile */
+            double max_x;          /* right bound of the tile */
+            double max_y;          /* top bound of the tile */
+            int    nb_vertices;    /* number of vertices inside the tile */
+        };
+    
+        QuadTree(const std::vector<Vertex*>*, const std::vector<Edge*>*);
+        ~QuadTree() {}
+    
+        int  getNbEdges()    const { return static_cast<int>(edges.size()); }
+        int  getNbVertices() const { return static_cast<int>(vertices.size()); }
+    
+        void query(double, double, double, double, std::vector<const Vertex*>*, std::vector<const Edge*>*) const;
+        void tiles(double, double, double, double, double, std::vector<Tile>*)                             const;
+    
+    private:
+    
+        struct Node {
+            double min_x;          /* left bound of the node */
+            double min_y;          /* bottom bound of the node */
+            double max_x;          /* right bound of the node */
+            double max_y;          /* top bound of the node */
+            int    children[4];    /* index of the child nodes, -1 for a leaf */
+            int    v_begin;        /* first vertex of the subtree in the vertices array */
+            int    v_end;          /* end of the vertices of the subtree */
+            int    e_begin;        /* first edge stored in this node in the edges array */
+            int    e_own_end;      /* end of the edges stored in this node */
+            int    e_end;          /* end of the edges of the subtree */
+        };
+    
+        int  build(double, double, double, double, int, int, int);
+        int  locate(const Edge*) const;
+    
+        std::vector<const Vertex*> by_id;      /* vertices by identifier, to find the end points of the edges */
+        std::vector<const Edge*>   edges;      /* edges sorted by node, in pre-order */
+        std::vector<Node>          nodes;      /* nodes of the tree, in pre-order, root first */
+        std::vector<const Vertex*> vertices;   /* vertices sorted so that each subtree is contiguous */
+
+};
+
+#endif
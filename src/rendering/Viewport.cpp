@@ -0,0 +1,93 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cross_platform/GLUT.hpp"
+
+#include "constants/Constants.hpp"
+#include "Viewport.hpp"
+
+/*
+Initializes the view on the default [-1,1] area.
+*/
+Viewport::Viewport() :
+    center_x(0),
+    center_y(0),
+    zoom(1) {
+}
+
+/*
+Multiplies the current matrix by the projection of the view.
+*/
+void Viewport::apply() const {
+    glOrtho(getMinX(), getMaxX(), getMinY(), getMaxY(), -1, 1);
+}
+
+/*
+Returns the size of a pixel in world coordinates, given the
+size of the window in pixels along the considered axis.
+*/
+double Viewport::pixel_size(int window_size) const {
+    return window_size>0 ? 2/(zoom*window_size) : 2/zoom;
+}
+
+/*
+Converts window coordinates (origin at the top left corner) to world
+coordinates, given the size of the window in pixels.
+*/
+void Viewport::to_world(int px, int py, int width, int height, double* x, double* y) const {
+    *x = getMinX() + (getMaxX()-getMinX())*(px+0.5)/width;
+    *y = getMaxY() - (getMaxY()-getMinY())*(py+0.5)/height;
+}
+
+/*
+Moves the view. The offsets are given as fractions of the view size.
+*/
+void Viewport::pan(double dx, double dy) {
+    center_x += 2*dx/zoom;
+    center_y += 2*dy/zoom;
+}
+
+/*
+Goes back to the default view.
+*/
+void Viewport::reset() {
+    center_x = 0;
+    center_y = 0;
+    zoom     = 1;
+}
+
+/*
+Zooms in, up to the maximum zoom factor.
+*/
+void Viewport::zoom_in() {
+    zoom *= Constants::RENDER_ZOOM_STEP;
+    if(zoom>Constants::RENDER_ZOOM_MAX) zoom = Constants::RENDER_ZOOM_MAX;
+}
+
+/*
+Zooms out, down to the minimum zoom factor.
+*/
+void Viewport::zoom_out() {
+    zoom /= Constants::RENDER_ZOOM_STEP;
+    if(zoom<Constants::RENDER_ZOOM_MIN) zoom = Constants::RENDER_ZOOM_MIN;
+}
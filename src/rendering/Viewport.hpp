@@ -0,0 +1,56 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef Viewport_hpp
+#define Viewport_hpp
+
+class Viewport {
+
+    public:
+    
+        Viewport();
+    
+        double getMinX()  const { return center_x - 1/zoom; }
+        double getMaxX()  const { return center_x + 1/zoom; }
+        double getMinY()  const { return center_y - 1/zoom; }
+        double getMaxY()  const { return center_y + 1/zoom; }
+        double getScale() const { return 1/zoom; }
+        double getZoom()  const { return zoom; }
+    
+        void   apply()                                        const;
+        double pixel_size(int)                                const;
+        void   to_world(int, int, int, int, double*, double*) const;
+        void   pan(double, double);
+        void   reset();
+        void   zoom_in();
+        void   zoom_out();
+    
+    private:
+    
+        double center_x;   /* x coordinate of the center of the view */
+        double center_y;   /* y coordinate of the center of the view */
+        double zoom;       /* zoom factor, 1 shows the [-1,1] area */
+
+};
+
+#endif
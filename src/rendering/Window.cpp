@@ -31,6 +31,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "cross_platform/GLUT.hpp"
 
 #include "graph/Graph.hpp"
+#include "stats/Trace.hpp"
 #include "Window.hpp"
 
 /*
@@ -87,11 +88,16 @@ void Window::hide(int window_id) {
 }
 
 /*
-Calls the Graph draw() function.
+Publishes the result of the algorithm running in the background, if it
+is over, advances the animated algorithm, if any, and calls the Graph
+draw() function.
 */
 void Window::draw() {
+    TRACE_SCOPE("Window::draw");
     for(const Graph* graph : *graphs) {
         if(glutGetWindow()==graph->getWindowId()) {
+            const_cast<Graph*>(graph)->collect_job();
+            const_cast<Graph*>(graph)->advance_animation();
             graph->draw();
         }
     }
@@ -109,6 +115,30 @@ void Window::keyboard(unsigned char key, int x, int y) {
     }
 }
 
+/*
+Calls the Graph mouse() function.
+*/
+void Window::mouse(int button, int state, int x, int y) {
+    for(const Graph* graph : *graphs) {
+        if(glutGetWindow()==graph->getWindowId()) {
+            const_cast<Graph*>(graph)->mouse(button, state, x, y);
+            break;
+        }
+    }
+}
+
+/*
+Calls the Graph special() function.
+*/
+void Window::special(int key, int x, int y) {
+    for(const Graph* graph : *graphs) {
+        if(glutGetWindow()==graph->getWindowId()) {
+            const_cast<Graph*>(graph)->special(key, x, y);
+            break;
+        }
+    }
+}
+
 /*
 Initializes new windows.
 */
@@ -119,6 +149,8 @@ void Window::launch(int window_id) const {
     glutReshapeFunc(reshape);
     glutDisplayFunc(draw);
     glutKeyboardFunc(keyboard);
+    glutMouseFunc(mouse);
+    glutSpecialFunc(special);
     glutMainLoop();
 }
 
@@ -131,6 +163,16 @@ void Window::reshape(int width, int height) {
     glLoadIdentity();
 }
 
+/*
+Sets the title of the window.
+*/
+void Window::setTitle(int window_id, const std::string& title) const {
+    int current_window = glutGetWindow();
+    glutSetWindow(window_id);
+    glutSetWindowTitle(title.c_str());
+    if(current_window) glutSetWindow(current_window);
+}
+
 /*
 Updates the Graph handler with the new Graph.
 */
@@ -24,6 +24,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef Window_hpp
 #define Window_hpp
 
+#include <string>
+#include <vector>
+
 class Graph;
 
 class Window {
@@ -39,8 +42,11 @@ class Window {
         void launch(int)                        const;
  static void draw();
  static void keyboard(unsigned char, int, int);
+ static void mouse(int, int, int, int);
  static void reshape(int, int);
+ static void special(int, int, int);
         void replaceGraph(const Graph*, const Graph*);
+        void setTitle(int, const std::string&)  const;
     
     private:
     
@@ -0,0 +1,191 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+#include "constants/Constants.hpp"
+#include "LoadGenerator.hpp"
+
+/*
+Prepares the given number of connections to the daemon listening on
+path, each with pipeline requests in flight, as frames or as lines.
+*/
+LoadGenerator::LoadGenerator(const std::string& path, int nb_connections, int pipeline, bool binary) :
+    binary(binary),
+    nb_connections(std::max(nb_connections, 1)),
+    nb_vertices(0),
+    path(path),
+    pipeline(std::max(pipeline, 1)) {
+}
+
+/*
+Sends the given number of random requests of a kind, and prints the
+throughput and the percentiles of the latency. Returns false if the
+daemon cannot be reached.
+*/
+bool LoadGenerator::run(QueryProtocol::Opcode kind, int nb_queries, uint64_t seed) {
+    /* the number of vertices gives the range of the random requests */
+    int connection = connect_socket();
+    if(connection<0) return false;
+    std::string answer;
+    char        buffer[256];
+    ssize_t     n;
+    if(write(connection, "info\n", 5)!=5) answer = "";
+    while(answer.find('\n')==std::string::npos && (n=read(connection, buffer, sizeof(buffer)))>0) answer.append(buffer, n);
+    close(connection);
+    if(sscanf(answer.c_str(), "ok %d", &nb_vertices)!=1 || nb_vertices<2) {
+        std::cerr << "unexpected answer from the daemon: " << answer << std::endl;
+        return false;
+    }
+    /* the connections run concurrently, each on its own stream of random numbers */
+    std::vector<Client>                   clients(nb_connections);
+    std::vector<std::thread>              threads;
+    Philox                                rng(seed);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(int i=0 ; i<nb_connections ; i++) {
+        int quota = nb_queries/nb_connections+(i<nb_queries%nb_connections ? 1 : 0);
+        threads.push_back(std::thread(&LoadGenerator::load, this, kind, quota, rng.stream(i), &clients[i]));
+    }
+    for(std::thread& t : threads) t.join();
+    double              seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    std::vector<double> latencies;
+    int                 errors  = 0;
+    int                 misses  = 0;
+    for(const Client& c : clients) {
+        if(!c.ok) return false;
+        latencies.insert(latencies.end(), c.latencies.begin(), c.latencies.end());
+        errors += c.errors;
+        misses += c.misses;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) { return latencies.empty() ? 0 : latencies[std::min(latencies.size()-1, static_cast<std::size_t>(p*latencies.size()))]; };
+    std::cout << "queries: " << latencies.size() << " (" << errors << " errors, " << misses << " not found), " << nb_connections << " connections, " << pipeline << " in flight each" << std::endl;
+    std::cout << "throughput: " << latencies.size()/seconds << " queries/s" << std::endl;
+    std::cout << "latency: p50 " << percentile(0.5) << " us, p90 " << percentile(0.9) << " us, p99 " << percentile(0.99) << " us, max " << percentile(1) << " us" << std::endl;
+    return true;
+}
+
+/*
+Connects to the daemon. Returns the socket, or -1 if it cannot be
+reached.
+*/
+int LoadGenerator::connect_socket() const {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path)-1);
+    int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(connection<0 || connect(connection, reinterpret_cast<sockaddr*>(&address), sizeof(address))<0) {
+        std::cerr << "cannot connect to " << path << ": " << std::strerror(errno) << std::endl;
+        if(connection>=0) close(connection);
+        return -1;
+    }
+    return connection;
+}
+
+/*
+Sends the given number of requests on a new connection, keeping
+pipeline of them in flight, and records their latencies.
+*/
+void LoadGenerator::load(QueryProtocol::Opcode kind, int nb_queries, Philox rng, Client* client) const {
+    typedef std::chrono::steady_clock Clock;
+    std::deque<Clock::time_point> in_flight;
+    std::string                   input;
+    std::string                   output;
+    std::vector<char>             buffer(Constants::SERVER_READ_SIZE);
+    int                           connection = connect_socket();
+    int                           nb_sent    = 0;
+    QueryProtocol::Query          query;
+    client->errors = 0;
+    client->misses = 0;
+    client->ok     = connection>=0;
+    while(client->ok && (nb_sent<nb_queries || !in_flight.empty())) {
+        /* fills the pipeline */
+        output.clear();
+        while(nb_sent<nb_queries && static_cast<int>(in_flight.size())<pipeline) {
+            random_query(kind, &rng, &query);
+            QueryProtocol::encode(query, &output);
+            in_flight.push_back(Clock::now());
+            nb_sent++;
+        }
+        for(std::size_t sent=0 ; sent<output.size() && client->ok ; ) {
+            ssize_t n = write(connection, output.data()+sent, output.size()-sent);
+            if(n<0 && errno==EINTR) continue;
+            client->ok = n>0;
+            sent      += n>0 ? n : 0;
+        }
+        /* reads the responses that arrived, at least one */
+        ssize_t n = client->ok ? read(connection, buffer.data(), buffer.size()) : -1;
+        if(n<0 && errno==EINTR) continue;
+        if(n<=0) {
+            client->ok = false;
+            break;
+        }
+        input.append(buffer.data(), n);
+        std::size_t           position = 0;
+        QueryProtocol::Status status;
+        while(QueryProtocol::decode_status(input, &position, binary, &status)) {
+            if(status==QueryProtocol::ROW) continue;
+            client->latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now()-in_flight.front()).count());
+            in_flight.pop_front();
+            if(status==QueryProtocol::ERROR) client->errors++;
+            if(status==QueryProtocol::NONE)  client->misses++;
+        }
+        input.erase(0, position);
+    }
+    if(!client->ok) std::cerr << "connection to the daemon lost" << std::endl;
+    if(connection>=0) close(connection);
+}
+
+/*
+Draws a request of the given kind. Routes and flows go between two
+different vertices, and the coordinates of the nearest vertex requests
+are drawn in the area of the generated graphs.
+*/
+void LoadGenerator::random_query(QueryProtocol::Opcode kind, Philox* rng, QueryProtocol::Query* query) const {
+    int nb_sources = kind==QueryProtocol::TABLE ? Constants::SERVER_LOAD_TABLE_SIZE : 1;
+    query->binary = binary;
+    query->kind   = kind;
+    query->sources.clear();
+    query->destinations.clear();
+    for(int i=0 ; i<nb_sources ; i++) {
+        query->sources.push_back(static_cast<int>(rng->uniform_int(nb_vertices)));
+        int destination;
+        do {
+            destination = static_cast<int>(rng->uniform_int(nb_vertices));
+        } while(destination==query->sources.back());
+        query->destinations.push_back(destination);
+    }
+    query->x = static_cast<double>(static_cast<int>(rng->uniform_int(Constants::AREA_WIDTH))-Constants::AREA_WIDTH/2)/1000;
+    query->y = static_cast<double>(static_cast<int>(rng->uniform_int(Constants::AREA_HEIGHT))-Constants::AREA_HEIGHT/2)/1000;
+}
@@ -0,0 +1,73 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LoadGenerator_hpp
+#define LoadGenerator_hpp
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "graph/Philox.hpp"
+#include "QueryProtocol.hpp"
+
+/*
+Client of the query daemon measuring its throughput and its latency.
+Each connection runs on its own thread and keeps a number of requests
+in flight: the latency of a request goes from the moment it is written
+to the moment its response is complete. The requests are random, drawn
+from the seed, and all of the same kind.
+*/
+class LoadGenerator {
+
+    public:
+    
+        LoadGenerator(const std::string&, int, int, bool);
+    
+        bool run(QueryProtocol::Opcode, int, uint64_t);
+    
+    private:
+    
+        /*
+        Results of a connection.
+        */
+        struct Client {
+            int                 errors;      /* requests answered with an error */
+            std::vector<double> latencies;   /* latency of each request, in microseconds */
+            int                 misses;      /* requests answered with "none" */
+            bool                ok;          /* false if the connection failed */
+        };
+    
+        int  connect_socket() const;
+        void load(QueryProtocol::Opcode, int, Philox, Client*) const;
+        void random_query(QueryProtocol::Opcode, Philox*, QueryProtocol::Query*) const;
+    
+        bool        binary;           /* true to send frames, false to send lines */
+        int         nb_connections;   /* number of connections, and threads */
+        int         nb_vertices;      /* number of vertices of the graph of the daemon */
+        std::string path;             /* path of the socket of the daemon */
+        int         pipeline;         /* number of requests in flight on a connection */
+
+};
+
+#endif
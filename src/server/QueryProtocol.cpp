@@ -0,0 +1,211 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+
+#include "constants/Constants.hpp"
+#include "QueryProtocol.hpp"
+
+/*
+Reads a list of vertices separated by commas.
+*/
+static bool parse_list(const std::string& word, std::vector<int>* list) {
+    const char* s = word.c_str();
+    while(*s) {
+        char* end;
+        long  v = std::strtol(s, &end, 10);
+        if(end==s) return false;
+        list->push_back(static_cast<int>(v));
+        s = end;
+        if(*s==',') s++;
+        else if(*s) return false;
+    }
+    return !list->empty();
+}
+
+/*
+Decodes the words of a request line.
+*/
+static bool parse_line(const std::string& line, QueryProtocol::Query* query) {
+    std::istringstream       in(line);
+    std::string              command;
+    std::vector<std::string> words;
+    std::string              word;
+    in >> command;
+    while(in >> word) words.push_back(word);
+    query->sources.clear();
+    query->destinations.clear();
+    if(command=="info") {
+        query->kind = QueryProtocol::INFO;
+        return words.empty();
+    }
+    if(command=="route" || command=="flow") {
+        query->kind = command=="route" ? QueryProtocol::ROUTE : QueryProtocol::FLOW;
+        return words.size()==2 && parse_list(words[0], &query->sources) && query->sources.size()==1 && parse_list(words[1], &query->destinations) && query->destinations.size()==1;
+    }
+    if(command=="table") {
+        query->kind = QueryProtocol::TABLE;
+        return words.size()==2 && parse_list(words[0], &query->sources) && parse_list(words[1], &query->destinations);
+    }
+    if(command=="nearest") {
+        char* end_x;
+        char* end_y;
+        query->kind = QueryProtocol::NEAREST;
+        if(words.size()!=2) return false;
+        query->x = std::strtod(words[0].c_str(), &end_x);
+        query->y = std::strtod(words[1].c_str(), &end_y);
+        return !*end_x && !*end_y;
+    }
+    return false;
+}
+
+/*
+Decodes the payload of a request frame, between position and end.
+*/
+static bool parse_frame(const std::string& input, std::size_t position, std::size_t end, QueryProtocol::Query* query) {
+    std::int32_t  v;
+    std::uint32_t n;
+    query->sources.clear();
+    query->destinations.clear();
+    switch(query->kind) {
+        case QueryProtocol::INFO    : break;
+        case QueryProtocol::ROUTE   :
+        case QueryProtocol::FLOW    : if(!QueryProtocol::get(input, &position, end, &v)) return false;
+                                      query->sources.push_back(v);
+                                      if(!QueryProtocol::get(input, &position, end, &v)) return false;
+                                      query->destinations.push_back(v);
+                                      break;
+        case QueryProtocol::TABLE   : for(std::vector<int>* list : {&query->sources, &query->destinations}) {
+                                          if(!QueryProtocol::get(input, &position, end, &n) || n==0 || n>(end-position)/sizeof(v)) return false;
+                                          for(std::uint32_t i=0 ; i<n ; i++) {
+                                              QueryProtocol::get(input, &position, end, &v);
+                                              list->push_back(v);
+                                          }
+                                      }
+                                      break;
+        case QueryProtocol::NEAREST : if(!QueryProtocol::get(input, &position, end, &query->x) || !QueryProtocol::get(input, &position, end, &query->y)) return false;
+                                      break;
+        default                     : return false;
+    }
+    return position==end;
+}
+
+/*
+Decodes the request at *position in the input, and moves after it. The
+input cannot be decoded further once a request is too large. The kind
+of request (line or frame) is set even if it is malformed or too large.
+*/
+QueryProtocol::Decoded QueryProtocol::decode(const std::string& input, std::size_t* position, Query* query) {
+    if(*position>=input.size()) return INCOMPLETE;
+    unsigned char first = static_cast<unsigned char>(input[*position]);
+    if(first<32 && first!='\n' && first!='\r' && first!='\t') {
+        std::size_t   start = *position+1;
+        std::uint32_t size;
+        query->binary = true;
+        if(!get(input, &start, input.size(), &size)) return INCOMPLETE;
+        if(size>static_cast<std::uint32_t>(Constants::SERVER_MAX_REQUEST)) return TOO_LARGE;
+        if(start+size>input.size()) return INCOMPLETE;
+        query->kind = static_cast<Opcode>(first);
+        *position   = start+size;
+        return parse_frame(input, start, start+size, query) ? DECODED : MALFORMED;
+    }
+    std::size_t end = input.find('\n', *position);
+    query->binary = false;
+    if(end==std::string::npos) return input.size()-*position>static_cast<std::size_t>(Constants::SERVER_MAX_REQUEST) ? TOO_LARGE : INCOMPLETE;
+    std::string line = input.substr(*position, end-*position);
+    *position = end+1;
+    if(!line.empty() && line.back()=='\r') line.pop_back();
+    return parse_line(line, query) ? DECODED : MALFORMED;
+}
+
+/*
+Decodes the row or the status of a response at *position in the input,
+and moves after it. Returns false if the input does not hold it whole.
+*/
+bool QueryProtocol::decode_status(const std::string& input, std::size_t* position, bool binary, Status* status) {
+    if(binary) {
+        std::size_t   start = *position+1;
+        std::uint32_t size;
+        if(*position>=input.size() || !get(input, &start, input.size(), &size) || start+size>input.size()) return false;
+        *status   = static_cast<Status>(input[*position]);
+        *position = start+size;
+        return true;
+    }
+    std::size_t end = input.find('\n', *position);
+    if(end==std::string::npos) return false;
+    if(!input.compare(*position, 4, "row "))        *status = ROW;
+    else if(!input.compare(*position, 2, "ok"))     *status = OK;
+    else if(!input.compare(*position, 4, "none"))   *status = NONE;
+    else                                            *status = ERROR;
+    *position = end+1;
+    return true;
+}
+
+/*
+Appends the request as a line or as a frame, depending on query.binary.
+*/
+void QueryProtocol::encode(const Query& query, std::string* output) {
+    if(query.binary) {
+        std::string payload;
+        switch(query.kind) {
+            case ROUTE   :
+            case FLOW    : put<std::int32_t>(&payload, query.sources[0]);
+                           put<std::int32_t>(&payload, query.destinations[0]);
+                           break;
+            case TABLE   : for(const std::vector<int>* list : {&query.sources, &query.destinations}) {
+                               put<std::uint32_t>(&payload, static_cast<std::uint32_t>(list->size()));
+                               for(int v : *list) put<std::int32_t>(&payload, v);
+                           }
+                           break;
+            case NEAREST : put(&payload, query.x);
+                           put(&payload, query.y);
+                           break;
+            default      : break;
+        }
+        output->push_back(static_cast<char>(query.kind));
+        put<std::uint32_t>(output, static_cast<std::uint32_t>(payload.size()));
+        output->append(payload);
+        return;
+    }
+    std::ostringstream line;
+    line.precision(std::numeric_limits<double>::max_digits10);
+    switch(query.kind) {
+        case INFO    : line << "info";
+                       break;
+        case ROUTE   : line << "route " << query.sources[0] << " " << query.destinations[0];
+                       break;
+        case FLOW    : line << "flow " << query.sources[0] << " " << query.destinations[0];
+                       break;
+        case TABLE   : line << "table";
+                       for(const std::vector<int>* list : {&query.sources, &query.destinations}) {
+                           for(std::size_t i=0 ; i<list->size() ; i++) line << (i ? "," : " ") << list->at(i);
+                       }
+                       break;
+        case NEAREST : line << "nearest " << query.x << " " << query.y;
+                       break;
+    }
+    line << "\n";
+    output->append(line.str());
+}
@@ -0,0 +1,111 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef QueryProtocol_hpp
+#define QueryProtocol_hpp
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/*
+Requests of the query daemon, see server/QueryServer.hpp. A request is
+either a line of text, or a binary frame: an opcode byte, the size of
+the payload on 4 bytes and the payload. Opcodes are below 32, so the
+first byte tells which one it is, and both can be mixed on a connection.
+Numbers are in the byte order of the host, the socket being local.
+
+    line                      frame payload
+    info                      -
+    route s d                 int32 s, int32 d
+    table s1,s2,... d1,...    uint32 n, int32 sources[n], uint32 m, int32 destinations[m]
+    flow s t                  int32 s, int32 t
+    nearest x y               double x, double y
+
+A response is made of rows, streamed as soon as they are computed, and
+a final status. In text, rows are lines starting with "row", and the
+status is a line starting with "ok", "none" or "error". In binary, each
+of them is a frame: a status byte, the size of the payload on 4 bytes
+and the payload.
+
+    request   rows                         ok payload
+    info      -                            int32 number of vertices
+    route     -                            double length, uint32 k, int32 vertices[k]
+    table     one per source: double[m]    -
+    flow      -                            WeightSum value of the maximum flow
+    nearest   -                            int32 vertex
+
+The flow is a sum of capacities, see components/Weight.hpp: an int64
+when graphsd is compiled with integer capacities, a double otherwise.
+
+Route gives "none" if the destination cannot be reached, and table gives
+infinity (inf in text) for the destinations a source cannot reach.
+*/
+namespace QueryProtocol {
+
+    enum Opcode {INFO=1, ROUTE=2, TABLE=3, FLOW=4, NEAREST=5};   /* kind of request, and its opcode in binary */
+    enum Status {OK=0, NONE=1, ERROR=2, ROW=3};                  /* kind of response frame */
+    enum Decoded {INCOMPLETE, DECODED, MALFORMED, TOO_LARGE};    /* result of the decoding of a request */
+    
+    /*
+    Request, decoded from a line or a frame.
+    */
+    struct Query {
+        bool             binary;         /* true if the request came as a frame, and is answered with frames */
+        std::vector<int> destinations;   /* destination, sink, or destinations of a table */
+        Opcode           kind;           /* kind of request */
+        std::vector<int> sources;        /* source, or sources of a table */
+        double           x;              /* coordinates of a nearest vertex request */
+        double           y;              /* coordinates of a nearest vertex request */
+    };
+    
+    const std::size_t HEADER_SIZE = 5;   /* size of the opcode or status and of the payload size of a frame */
+    
+    Decoded decode(const std::string&, std::size_t*, Query*);
+    bool    decode_status(const std::string&, std::size_t*, bool, Status*);
+    void    encode(const Query&, std::string*);
+    
+    /*
+    Appends a number to a frame.
+    */
+    template<typename T>
+    void put(std::string* frame, T value) {
+        frame->append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    
+    /*
+    Reads a number of a frame at *position, and moves after it. Returns
+    false if the frame is too short.
+    */
+    template<typename T>
+    bool get(const std::string& frame, std::size_t* position, std::size_t end, T* value) {
+        if(*position+sizeof(T)>end) return false;
+        std::memcpy(value, frame.data()+*position, sizeof(T));
+        *position += sizeof(T);
+        return true;
+    }
+
+}
+
+#endif
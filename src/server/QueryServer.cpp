@@ -0,0 +1,430 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <limits>
+#include <poll.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "constants/Constants.hpp"
+#include "QueryServer.hpp"
+
+/*
+Fields of a row or of a status of a response, as text or in binary.
+*/
+class Fields {
+
+    public:
+    
+        Fields(bool binary) : binary(binary) { text.precision(std::numeric_limits<double>::max_digits10); }
+    
+        Fields& operator<<(double v)       { if(binary) QueryProtocol::put(&payload, v); else text << " " << v; return *this; }
+        Fields& operator<<(std::int32_t v) { if(binary) QueryProtocol::put(&payload, v); else text << " " << v; return *this; }
+        Fields& operator<<(std::int64_t v) { if(binary) QueryProtocol::put(&payload, v); else text << " " << v; return *this; }
+    
+        /*
+        Number of values that follow, only written in binary.
+        */
+        Fields& count(std::size_t n) { if(binary) QueryProtocol::put(&payload, static_cast<std::uint32_t>(n)); return *this; }
+    
+        /*
+        Appends the row or the status to the output.
+        */
+        void write(QueryProtocol::Status status, std::string* output) const {
+            static const char* words[] = {"ok", "none", "error", "row"};
+            if(binary) {
+                output->push_back(static_cast<char>(status));
+                QueryProtocol::put(output, static_cast<std::uint32_t>(payload.size()));
+                output->append(payload);
+            }
+            else {
+                output->append(words[status]);
+                output->append(text.str());
+                output->push_back('\n');
+            }
+        }
+    
+    private:
+    
+        bool               binary;    /* true for a frame, false for a line */
+        std::string        payload;   /* fields of a frame */
+        std::ostringstream text;      /* fields of a line */
+
+};
+
+/*
+Appends an error status with its message to the output.
+*/
+static void write_error(std::string* output, bool binary, const std::string& message) {
+    if(binary) {
+        output->push_back(static_cast<char>(QueryProtocol::ERROR));
+        QueryProtocol::put(output, static_cast<std::uint32_t>(message.size()));
+        output->append(message);
+    }
+    else {
+        output->append("error "+message+"\n");
+    }
+}
+
+/*
+Writes the whole output on the socket. Returns false if the connection
+was closed by the client.
+*/
+static bool write_all(int socket, const std::string& output) {
+    std::size_t sent = 0;
+    while(sent<output.size()) {
+        ssize_t n = write(socket, output.data()+sent, output.size()-sent);
+        if(n<0 && errno==EINTR) continue;
+        if(n<=0) return false;
+        sent += n;
+    }
+    return true;
+}
+
+/*
+Closes the socket of the connection.
+*/
+QueryServer::Connection::~Connection() {
+    close(socket);
+}
+
+/*
+Server answering on the graph, each of the given number of workers on
+its own snapshots.
+*/
+QueryServer::QueryServer(const Graph& graph, const std::string& path, int nb_workers) :
+    QueryServer(&graph, 0, path, nb_workers) {
+}
+
+/*
+Server answering on the graph held by the cluster.
+*/
+QueryServer::QueryServer(ShardCluster* cluster, const std::string& path, int nb_workers) :
+    QueryServer(0, cluster, path, nb_workers) {
+}
+
+/*
+Prepares the given number of workers, with snapshots of the graph if
+there is no cluster. The requests in progress are cancelled when the
+server stops.
+*/
+QueryServer::QueryServer(const Graph* graph, ShardCluster* cluster, const std::string& path, int nb_workers) :
+    cluster(cluster),
+    nb_vertices(cluster ? cluster->getNbVertices() : static_cast<int>(graph->getGraphRepresentation()->getVertices()->size())),
+    path(path),
+    stopping(false) {
+    for(int i=0 ; i<nb_workers ; i++) {
+        workers.push_back(new Worker(cluster ? 0 : graph));
+        if(cluster) continue;
+        workers.back()->flows->setCancelFlag(&stopping);
+        workers.back()->routes->setCancelFlag(&stopping);
+    }
+    if(pipe(wake)<0) wake[0] = wake[1] = -1;
+    for(int end : wake) {
+        if(end>=0) fcntl(end, F_SETFL, fcntl(end, F_GETFL)|O_NONBLOCK);
+    }
+}
+
+/*
+QueryServer destructor.
+*/
+QueryServer::~QueryServer() {
+    for(Worker* w : workers) delete w;
+    for(int end : wake) {
+        if(end>=0) close(end);
+    }
+}
+
+/*
+Listens on the socket, reads the requests of the connections and queues
+them for the workers, until stop() is called. A connection is not read
+while SERVER_MAX_QUEUED of its requests wait for their responses.
+Returns false if the socket cannot be opened.
+*/
+bool QueryServer::run() {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(path.size()>=sizeof(address.sun_path)) {
+        std::cerr << "socket path too long: " << path << std::endl;
+        return false;
+    }
+    std::strcpy(address.sun_path, path.c_str());
+    unlink(path.c_str());
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listener<0 || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address))<0 || listen(listener, Constants::SERVER_BACKLOG)<0) {
+        std::cerr << "cannot listen on " << path << ": " << std::strerror(errno) << std::endl;
+        if(listener>=0) close(listener);
+        return false;
+    }
+    for(Worker* w : workers) threads.push_back(std::thread(&QueryServer::work, this, w));
+    std::cout << "listening on " << path << " with " << workers.size() << " workers" << std::endl;
+    std::vector<std::shared_ptr<Connection>> connections;
+    std::vector<int>                         polled;
+    std::vector<pollfd>                      fds;
+    std::vector<char>                        buffer(Constants::SERVER_READ_SIZE);
+    while(!stopping) {
+        fds.clear();
+        polled.clear();
+        fds.push_back(pollfd{listener, POLLIN, 0});
+        fds.push_back(pollfd{wake[0], POLLIN, 0});
+        for(std::size_t i=0 ; i<connections.size() ; i++) {
+            if(connections[i]->nb_queued>=Constants::SERVER_MAX_QUEUED) continue;
+            fds.push_back(pollfd{connections[i]->socket, POLLIN, 0});
+            polled.push_back(static_cast<int>(i));
+        }
+        if(poll(fds.data(), fds.size(), Constants::SERVER_POLL_DELAY)<=0) continue;
+        char drained[64];
+        if(fds[1].revents) while(read(wake[0], drained, sizeof(drained))>0) {}
+        for(std::size_t i=0 ; i<polled.size() ; i++) {
+            if(fds[i+2].revents && !receive(connections[polled[i]], &buffer)) connections[polled[i]].reset();
+        }
+        connections.erase(std::remove_if(connections.begin(), connections.end(), [](const std::shared_ptr<Connection>& c) { return !c || !c->open; }), connections.end());
+        if(fds[0].revents&POLLIN) {
+            int connection = accept(listener, 0, 0);
+            if(connection>=0) connections.push_back(std::make_shared<Connection>(connection));
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        request_ready.notify_all();
+    }
+    for(std::thread& t : threads) t.join();
+    threads.clear();
+    connections.clear();
+    ready.clear();
+    close(listener);
+    unlink(path.c_str());
+    return true;
+}
+
+/*
+Answers a request, in the encoding it came with, or the error found
+while decoding it. The rows of a table are sent as soon as they are
+computed, the other responses are only appended to the output of the
+worker.
+*/
+void QueryServer::answer(Worker* w, Connection* c, const Request& request) {
+    const QueryProtocol::Query& query = request.query;
+    std::vector<double>         distances;
+    std::vector<int>            path;
+    Fields                      fields(query.binary);
+    if(request.decoded==QueryProtocol::MALFORMED) {
+        write_error(&w->output, query.binary, "malformed request");
+        return;
+    }
+    if(request.decoded==QueryProtocol::TOO_LARGE) {
+        write_error(&w->output, query.binary, "request too large");
+        return;
+    }
+    for(const std::vector<int>* list : {&query.sources, &query.destinations}) {
+        for(int v : *list) {
+            if(v<0 || v>=nb_vertices) {
+                write_error(&w->output, query.binary, "unknown vertex "+std::to_string(v));
+                return;
+            }
+        }
+    }
+    switch(query.kind) {
+        case QueryProtocol::INFO : {
+            fields << static_cast<std::int32_t>(nb_vertices);
+            fields.write(QueryProtocol::OK, &w->output);
+            break;
+        }
+        case QueryProtocol::ROUTE : {
+            if(!shortest_paths(w, query.sources[0], query.destinations, &distances, &path)) {
+                if(!stopping) write_error(&w->output, query.binary, "shards unavailable");
+                break;
+            }
+            if(path.empty()) {
+                fields.write(QueryProtocol::NONE, &w->output);
+                break;
+            }
+            fields << distances[0];
+            fields.count(path.size());
+            for(int v : path) fields << static_cast<std::int32_t>(v);
+            fields.write(QueryProtocol::OK, &w->output);
+            break;
+        }
+        case QueryProtocol::TABLE : {
+            bool complete = true;
+            for(int source : query.sources) {
+                if(!(complete = shortest_paths(w, source, query.destinations, &distances, 0))) break;
+                Fields row(query.binary);
+                for(double d : distances) row << d;
+                row.write(QueryProtocol::ROW, &w->output);
+                if(!send(w, c, request.number, false)) return;
+            }
+            if(complete)       fields.write(QueryProtocol::OK, &w->output);
+            else if(!stopping) write_error(&w->output, query.binary, "shards unavailable");
+            break;
+        }
+        case QueryProtocol::FLOW : {
+            if(query.sources[0]==query.destinations[0]) {
+                write_error(&w->output, query.binary, "the source and the sink must be different");
+                return;
+            }
+            WeightSum flow;
+            if(cluster) {
+                flow = cluster->max_flow(query.sources[0], query.destinations[0], &stopping);
+            }
+            else {
+                const std::vector<Vertex*>* vertices = w->flows->getGraphRepresentation()->getVertices();
+                flow = w->flows->max_flow(vertices->at(query.sources[0]), vertices->at(query.destinations[0]));
+            }
+            if(stopping) break;
+            fields << flow;
+            fields.write(QueryProtocol::OK, &w->output);
+            break;
+        }
+        case QueryProtocol::NEAREST : {
+            const Vertex* v = cluster ? cluster->nearest(query.x, query.y) : w->routes->nearest_vertex(query.x, query.y);
+            if(v) fields << static_cast<std::int32_t>(v->getId());
+            fields.write(v ? QueryProtocol::OK : QueryProtocol::NONE, &w->output);
+            break;
+        }
+    }
+    if(stopping) write_error(&w->output, query.binary, "server stopping");
+}
+
+/*
+Takes the next request to answer and its connection, the connections
+with waiting requests taking turns. Returns false if the server stops.
+*/
+bool QueryServer::next_request(std::shared_ptr<Connection>* c, Request* request) {
+    std::unique_lock<std::mutex> lock(mutex);
+    request_ready.wait(lock, [this]() { return stopping || !ready.empty(); });
+    if(stopping) return false;
+    *c = ready.front();
+    ready.pop_front();
+    *request = (*c)->requests.front();
+    (*c)->requests.pop_front();
+    if(!(*c)->requests.empty()) ready.push_back(*c);
+    return true;
+}
+
+/*
+Reads what the client sent and queues the requests it completes for the
+workers. Returns false once the connection must not be read anymore: the
+client closed its side, or sent a request too large.
+*/
+bool QueryServer::receive(const std::shared_ptr<Connection>& c, std::vector<char>* buffer) {
+    ssize_t n = read(c->socket, buffer->data(), buffer->size());
+    if(n<0 && errno==EINTR) return true;
+    if(n<=0) return false;
+    c->input.append(buffer->data(), n);
+    std::vector<Request> received;
+    std::size_t          position = 0;
+    Request              request;
+    while((request.decoded = QueryProtocol::decode(c->input, &position, &request.query))!=QueryProtocol::INCOMPLETE) {
+        request.number = c->next_request++;
+        received.push_back(request);
+        if(request.decoded==QueryProtocol::TOO_LARGE) break;
+    }
+    c->input.erase(0, position);
+    if(received.empty()) return true;
+    std::lock_guard<std::mutex> lock(mutex);
+    if(c->requests.empty()) ready.push_back(c);
+    c->requests.insert(c->requests.end(), received.begin(), received.end());
+    c->nb_queued += static_cast<int>(received.size());
+    request_ready.notify_all();
+    return received.back().decoded!=QueryProtocol::TOO_LARGE;
+}
+
+/*
+Adds the output of the worker to the response to the given request,
+complete if done is true, and sends the responses whose turn has come:
+the one of the oldest request not answered yet as it is written, and the
+complete ones after it. Returns false if the client cannot be written to.
+*/
+bool QueryServer::send(Worker* w, Connection* c, unsigned long number, bool done) {
+    std::lock_guard<std::mutex> lock(c->mutex);
+    if(c->open) {
+        Response& response = c->pending[number];
+        response.output.append(w->output);
+        response.done = done;
+    }
+    w->output.clear();
+    std::map<unsigned long, Response>::iterator next;
+    while(c->open && (next=c->pending.find(c->next_response))!=c->pending.end()) {
+        if(!write_all(c->socket, next->second.output)) c->open = false;
+        next->second.output.clear();
+        if(!next->second.done) break;
+        c->pending.erase(next);
+        c->next_response++;
+    }
+    if(!c->open) c->pending.clear();
+    return c->open;
+}
+
+/*
+Lengths of the shortest paths from source to the destinations, and if
+path is given the vertices of the path to the first destination, empty
+if it cannot be reached. They are searched by the cluster if there is
+one. Returns false if the search was cancelled, or if a shard cannot
+be reached.
+*/
+bool QueryServer::shortest_paths(Worker* w, int source, const std::vector<int>& destinations, std::vector<double>* distances, std::vector<int>* path) {
+    if(cluster) return cluster->shortest_paths(source, destinations, distances, path);
+    std::vector<double> tree;
+    std::vector<int>    predecessors;
+    distances->clear();
+    if(!w->routes->shortest_path_tree(w->routes->getGraphRepresentation()->getVertices()->at(source), &tree, &predecessors)) return false;
+    for(int d : destinations) distances->push_back(tree[d]);
+    if(path) {
+        int destination = destinations[0];
+        path->clear();
+        if(source!=destination && predecessors[destination]==-1) return true;
+        path->push_back(destination);
+        while(path->back()!=source) path->push_back(predecessors[path->back()]);
+        std::reverse(path->begin(), path->end());
+    }
+    return true;
+}
+
+/*
+Answers the queued requests until the server stops. Wakes run() up when
+a connection it stopped reading can queue requests again.
+*/
+void QueryServer::work(Worker* w) {
+    std::shared_ptr<Connection> c;
+    Request                     request;
+    while(next_request(&c, &request)) {
+        if(c->open) {
+            answer(w, c.get(), request);
+            send(w, c.get(), request.number, true);
+        }
+        if(c->nb_queued--==Constants::SERVER_MAX_QUEUED && wake[1]>=0) {
+            char byte = 0;
+            if(write(wake[1], &byte, 1)<0) {}
+        }
+        c.reset();
+    }
+}
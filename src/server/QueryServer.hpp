@@ -0,0 +1,142 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef QueryServer_hpp
+#define QueryServer_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "graph/Graph.hpp"
+#include "QueryProtocol.hpp"
+#include "ShardCluster.hpp"
+
+/*
+Daemon answering shortest path, distance table, maximum flow and
+nearest vertex requests on a graph, over a Unix domain socket. The
+requests of a connection can be pipelined, and are answered in order.
+See server/QueryProtocol.hpp for the protocol. The thread of run()
+reads all the connections and queues their requests; the workers take
+them from the connections in turn, so that a connection waiting for
+requests, or sending many, does not hold up the others. Each worker
+answers on its own snapshots of the graph: the graph is never written,
+so the workers do not share anything but the pages of the copies. The
+flow requests run on a snapshot with directions and capacities, set as
+the 'f' key does. Given a cluster of shards instead of a graph, there
+are no snapshots: the routes and tables are searched by the shards, one
+at a time, and the flows and nearest vertices are found on the indexes
+of the coordinator, see server/ShardCluster.hpp.
+*/
+class QueryServer {
+
+    public:
+    
+        QueryServer(const Graph&, const std::string&, int);
+        QueryServer(ShardCluster*, const std::string&, int);
+        ~QueryServer();
+    
+        bool run();
+        void stop() { stopping = true; }
+    
+    private:
+    
+        /*
+        Request of a connection, numbered in the order it was received.
+        */
+        struct Request {
+            QueryProtocol::Decoded decoded;   /* DECODED, or the error to answer */
+            unsigned long          number;    /* rank of the request on its connection */
+            QueryProtocol::Query   query;     /* request, if it was decoded */
+        };
+        
+        /*
+        Response that cannot be sent yet, as the ones before it are not.
+        */
+        struct Response {
+            bool        done;     /* true once the request is answered */
+            std::string output;   /* part of the response not sent yet */
+        };
+        
+        /*
+        Connection of a client. Its requests can be answered by several
+        workers at once: each response is sent once the ones before it
+        are, and waits in pending until then. The socket is closed with
+        the last reference to the connection, once the client closed its
+        side and every request is answered.
+        */
+        struct Connection {
+            Connection(int socket) : nb_queued(0), next_request(0), next_response(0), open(true), socket(socket) {}
+            ~Connection();
+            std::string                       input;           /* bytes read but not decoded yet, by the thread of run() */
+            std::mutex                        mutex;           /* protects the responses and the writes */
+            std::atomic<int>                  nb_queued;       /* requests read but not answered yet */
+            unsigned long                     next_request;    /* number of the next request read */
+            unsigned long                     next_response;   /* number of the next response to send */
+            std::atomic<bool>                 open;            /* false once the client cannot be written to */
+            std::map<unsigned long, Response> pending;         /* responses waiting for the ones before them, by request number */
+            std::deque<Request>               requests;        /* requests waiting for a worker, protected by the mutex of the server */
+            int                               socket;          /* socket of the connection */
+        };
+        
+        /*
+        State of a worker: its snapshots, if it has a graph, and the
+        response being written.
+        */
+        struct Worker {
+            Worker(const Graph* g) : flows(g ? new Graph(*g) : 0), routes(g ? new Graph(*g) : 0) {}
+            ~Worker() { delete flows; delete routes; }
+            Graph*      flows;    /* snapshot for the maximum flows, 0 with a cluster */
+            std::string output;   /* response not sent yet */
+            Graph*      routes;   /* snapshot for the other requests, 0 with a cluster */
+        };
+    
+        QueryServer(const Graph*, ShardCluster*, const std::string&, int);
+    
+        void answer(Worker*, Connection*, const Request&);
+        bool next_request(std::shared_ptr<Connection>*, Request*);
+        bool receive(const std::shared_ptr<Connection>&, std::vector<char>*);
+        bool send(Worker*, Connection*, unsigned long, bool);
+        bool shortest_paths(Worker*, int, const std::vector<int>&, std::vector<double>*, std::vector<int>*);
+        void work(Worker*);
+    
+        ShardCluster*                           cluster;         /* shards holding the graph, 0 to answer on the snapshots of the workers */
+        std::mutex                              mutex;           /* protects ready and the requests of the connections */
+        int                                     nb_vertices;     /* number of vertices of the graph */
+        std::string                             path;            /* path of the socket */
+        std::deque<std::shared_ptr<Connection>> ready;           /* connections with requests waiting for a worker, in turn */
+        std::condition_variable                 request_ready;   /* signaled when a request is queued or the server stops */
+        std::atomic<bool>                       stopping;        /* set to stop the server, also cancels the running requests */
+        std::vector<std::thread>                threads;         /* threads of the workers */
+        int                                     wake[2];         /* pipe waking run() up when a connection can queue requests again */
+        std::vector<Worker*>                    workers;         /* state of each worker */
+
+};
+
+#endif
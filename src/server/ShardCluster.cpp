@@ -0,0 +1,362 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <csignal>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <utility>
+
+#include "constants/Constants.hpp"
+#include "QueryProtocol.hpp"
+#include "ShardCluster.hpp"
+#include "ShardWorker.hpp"
+
+/*
+Cluster of the given number of shards. The workers are started by
+start().
+*/
+ShardCluster::ShardCluster(int nb_shards) :
+    nb_shards(std::max(nb_shards, 1)),
+    flows(0),
+    kdtree(0),
+    nb_boundary(0),
+    nb_last_rounds(0) {
+}
+
+/*
+Stops the workers and waits for them, and frees the vertices and the
+indexes of the coordinator.
+*/
+ShardCluster::~ShardCluster() {
+    std::string answer;
+    for(int s=0 ; s<static_cast<int>(sockets.size()) ; s++) {
+        exchange(s, ShardProtocol::STOP, "", &answer);
+        close(sockets[s]);
+    }
+    for(pid_t pid : workers) waitpid(pid, 0, 0);
+    delete flows;
+    delete kdtree;
+    for(Vertex* v : vertices) delete v;
+}
+
+/*
+Splits the vertices between first and last in nb_shards shards, numbered
+from shard, cutting them in two across the longer side of their bounding
+box.
+*/
+static void bisect_range(std::vector<const Vertex*>::iterator first, std::vector<const Vertex*>::iterator last, int shard, int nb_shards, std::vector<int>* owners) {
+    if(nb_shards<=1 || last-first<=1) {
+        for(std::vector<const Vertex*>::iterator it=first ; it!=last ; ++it) (*owners)[(*it)->getId()] = shard;
+        return;
+    }
+    double min_x = (*first)->getX(), max_x = min_x;
+    double min_y = (*first)->getY(), max_y = min_y;
+    for(std::vector<const Vertex*>::iterator it=first ; it!=last ; ++it) {
+        min_x = std::min(min_x, (*it)->getX()); max_x = std::max(max_x, (*it)->getX());
+        min_y = std::min(min_y, (*it)->getY()); max_y = std::max(max_y, (*it)->getY());
+    }
+    bool                                 by_x   = max_x-min_x>=max_y-min_y;
+    int                                  left   = nb_shards/2;
+    std::vector<const Vertex*>::iterator middle = first+(last-first)*left/nb_shards;
+    std::nth_element(first, middle, last, [by_x](const Vertex* a, const Vertex* b) {
+        double ka = by_x ? a->getX() : a->getY();
+        double kb = by_x ? b->getX() : b->getY();
+        return ka<kb || (ka==kb && a->getId()<b->getId());
+    });
+    bisect_range(first, middle, shard, left, owners);
+    bisect_range(middle, last, shard+left, nb_shards-left, owners);
+}
+
+/*
+Writes the shard of each vertex, by recursive coordinate bisection in
+nb_shards shards of the same size, within one vertex.
+*/
+void ShardCluster::bisect(const std::vector<Vertex*>& vertices, int nb_shards, std::vector<int>* owners) {
+    std::vector<const Vertex*> order(vertices.begin(), vertices.end());
+    owners->assign(vertices.size(), 0);
+    bisect_range(order.begin(), order.end(), 0, std::max(nb_shards, 1), owners);
+}
+
+/*
+Sends a message to a worker and reads its answer. Returns false if the
+worker cannot be reached.
+*/
+bool ShardCluster::exchange(int shard, ShardProtocol::Opcode opcode, const std::string& payload, std::string* answer) {
+    return ShardProtocol::send(sockets[shard], opcode, payload) && receive(shard, opcode, answer);
+}
+
+/*
+Draws the graph of the given generator and number of vertices, as
+Graph::generate() does with the seed of the graphs, without building its
+representation, and sends each worker its shard. The flow network gets
+random directions and capacities, drawn after the topology as the 'f'
+key does. Returns false if a worker cannot be reached.
+*/
+bool ShardCluster::load(GRAPH_GENERATOR generator, int nb_vertices) {
+    std::lock_guard<std::mutex>            lock(mutex);
+    Philox                                 rng(Graph::getSeed());
+    std::vector<std::pair<double, double>> points;
+    std::vector<std::pair<int, int>>       edges;
+    std::vector<Weight>                    capacities;
+    Graph::generate_topology(generator, nb_vertices, &rng, &points, &edges, &capacities);
+    for(std::size_t i=0 ; i<points.size() ; i++) vertices.push_back(new Vertex(points[i].first, points[i].second, static_cast<int>(i)));
+    std::vector<std::pair<double, double>>().swap(points);
+    kdtree = new KdTree(&vertices);
+    /* flow network, with the draws of Graph::prepare_flow() */
+    std::vector<std::pair<int, int>> arcs(edges);
+    for(std::pair<int, int>& a : arcs) {
+        if(rng.uniform_int(2)) std::swap(a.first, a.second);
+    }
+    if(capacities.empty()) {
+        capacities.resize(arcs.size());
+        for(Weight& c : capacities) c = rng.uniform_int(Constants::EDGE_MAXIMUM_CAPACITY) + 1;
+    }
+    flows = new FlowNetwork(static_cast<int>(vertices.size()), arcs, capacities);
+    std::vector<std::pair<int, int>>().swap(arcs);
+    std::vector<Weight>().swap(capacities);
+    return load_shards(&edges);
+}
+
+/*
+Splits the edges between the shards and sends each worker its shard:
+its vertices, the arcs leaving them, both ways, and the boundary
+vertices at the other end. The edges are freed once split. Returns
+false if a worker cannot be reached.
+*/
+bool ShardCluster::load_shards(std::vector<std::pair<int, int>>* edges) {
+    bisect(vertices, nb_shards, &owners);
+    /* arcs of each shard, by tail */
+    std::vector<std::vector<std::pair<int, int>>> arcs(nb_shards);
+    for(const std::pair<int, int>& e : *edges) {
+        arcs[owners[e.first]].push_back(e);
+        arcs[owners[e.second]].push_back(std::make_pair(e.second, e.first));
+    }
+    std::vector<std::pair<int, int>>().swap(*edges);
+    /* vertices of each shard first, then its boundary vertices */
+    std::vector<std::vector<int>> shards(nb_shards);
+    for(std::size_t v=0 ; v<vertices.size() ; v++) shards[owners[v]].push_back(static_cast<int>(v));
+    std::vector<int>  position(vertices.size(), -1);
+    std::vector<char> boundary(vertices.size(), 0);
+    std::string       answer;
+    for(int s=0 ; s<nb_shards ; s++) {
+        std::vector<int>& list     = shards[s];
+        std::size_t       nb_owned = list.size();
+        for(std::size_t i=0 ; i<list.size() ; i++) position[list[i]] = static_cast<int>(i);
+        for(const std::pair<int, int>& a : arcs[s]) {
+            if(owners[a.second]==s) continue;
+            boundary[a.first] = boundary[a.second] = 1;
+            if(position[a.second]<0) {
+                position[a.second] = static_cast<int>(list.size());
+                list.push_back(a.second);
+            }
+        }
+        std::string payload;
+        QueryProtocol::put(&payload, static_cast<std::uint32_t>(list.size()));
+        for(std::size_t i=0 ; i<list.size() ; i++) {
+            QueryProtocol::put(&payload, static_cast<std::int32_t>(list[i]));
+            QueryProtocol::put(&payload, static_cast<std::uint8_t>(i<nb_owned));
+        }
+        QueryProtocol::put(&payload, static_cast<std::uint32_t>(arcs[s].size()));
+        for(const std::pair<int, int>& a : arcs[s]) {
+            QueryProtocol::put(&payload, static_cast<std::uint32_t>(position[a.first]));
+            QueryProtocol::put(&payload, static_cast<std::uint32_t>(position[a.second]));
+            QueryProtocol::put(&payload, vertices[a.first]->distanceTo(vertices[a.second]));
+        }
+        for(int v : list) position[v] = -1;
+        std::vector<std::pair<int, int>>().swap(arcs[s]);
+        if(!exchange(s, ShardProtocol::LOAD, payload, &answer)) return false;
+    }
+    nb_boundary = static_cast<int>(std::count(boundary.begin(), boundary.end(), 1));
+    return true;
+}
+
+/*
+Maximum flow from source to sink, on the flow network kept by the
+coordinator. Several can run at once. Returns the flow sent so far if
+cancel_flag becomes true.
+*/
+WeightSum ShardCluster::max_flow(int source, int sink, const std::atomic<bool>* cancel_flag) const {
+    return flows ? flows->max_flow(source, sink, cancel_flag) : 0;
+}
+
+/*
+Vertex closest to the point, 0 if the graph has none.
+*/
+const Vertex* ShardCluster::nearest(double x, double y) const {
+    return kdtree ? kdtree->nearest(x, y) : 0;
+}
+
+/*
+Builds the path from the source of the last search to the destination,
+asking each shard it goes through for its part.
+*/
+bool ShardCluster::path(int destination, std::vector<int>* vertices) {
+    std::string answer;
+    vertices->clear();
+    for(int v=destination ; vertices->size()<=owners.size() ; ) {
+        std::string   payload;
+        std::size_t   position = 0;
+        std::uint32_t k        = 0;
+        std::int32_t  u        = v;
+        QueryProtocol::put(&payload, static_cast<std::int32_t>(v));
+        if(!exchange(owners[v], ShardProtocol::PATH, payload, &answer)) return false;
+        QueryProtocol::get(answer, &position, answer.size(), &k);
+        if(k==0) return false;
+        for(std::uint32_t i=0 ; i<k && QueryProtocol::get(answer, &position, answer.size(), &u) ; i++) {
+            if(i>0 || vertices->empty()) vertices->push_back(u);
+        }
+        /* the part stops at the source, or at a vertex of another shard */
+        if(owners[u]==owners[v]) {
+            std::reverse(vertices->begin(), vertices->end());
+            return true;
+        }
+        v = u;
+    }
+    return false;
+}
+
+/*
+Reads the answer of a worker to a message. Returns false if it cannot
+be reached or answers something else.
+*/
+bool ShardCluster::receive(int shard, ShardProtocol::Opcode opcode, std::string* answer) {
+    ShardProtocol::Opcode received;
+    if(ShardProtocol::receive(sockets[shard], &received, answer) && received==opcode) return true;
+    std::cerr << "shard " << shard << " does not answer" << std::endl;
+    return false;
+}
+
+/*
+Lengths of the shortest paths from source to the destinations, infinity
+for the ones that cannot be reached, and if path is given the vertices
+of the path to the first destination, empty if it cannot be reached.
+Returns false if a worker cannot be reached.
+*/
+bool ShardCluster::shortest_paths(int source, const std::vector<int>& destinations, std::vector<double>* distances, std::vector<int>* path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string                 answer;
+    if(source<0 || source>=static_cast<int>(owners.size())) return false;
+    for(int s=0 ; s<nb_shards ; s++) {
+        std::string payload;
+        QueryProtocol::put(&payload, static_cast<std::int32_t>(owners[source]==s ? source : -1));
+        if(!exchange(s, ShardProtocol::START, payload, &answer)) return false;
+    }
+    /* rounds, the shards of a round searching in parallel */
+    std::vector<std::string>   updates(nb_shards);
+    std::vector<std::uint32_t> counts(nb_shards, 0);
+    std::vector<int>           active(1, owners[source]);
+    nb_last_rounds = 0;
+    while(!active.empty()) {
+        nb_last_rounds++;
+        for(int s : active) {
+            std::string payload;
+            QueryProtocol::put(&payload, counts[s]);
+            payload.append(updates[s]);
+            updates[s].clear();
+            counts[s] = 0;
+            if(!ShardProtocol::send(sockets[s], ShardProtocol::ROUND, payload)) return false;
+        }
+        for(int s : active) {
+            std::size_t   position = 0;
+            std::uint32_t k        = 0;
+            if(!receive(s, ShardProtocol::ROUND, &answer)) return false;
+            QueryProtocol::get(answer, &position, answer.size(), &k);
+            for(std::uint32_t i=0 ; i<k ; i++) {
+                std::int32_t v, p;
+                double       d;
+                if(!QueryProtocol::get(answer, &position, answer.size(), &v) || !QueryProtocol::get(answer, &position, answer.size(), &d) || !QueryProtocol::get(answer, &position, answer.size(), &p)) break;
+                std::string& u = updates[owners[v]];
+                QueryProtocol::put(&u, v);
+                QueryProtocol::put(&u, d);
+                QueryProtocol::put(&u, p);
+                counts[owners[v]]++;
+            }
+        }
+        active.clear();
+        for(int s=0 ; s<nb_shards ; s++) if(counts[s]) active.push_back(s);
+    }
+    /* distances, asked to the shards owning the destinations */
+    std::vector<std::vector<int>> asked(nb_shards);
+    distances->assign(destinations.size(), std::numeric_limits<double>::infinity());
+    for(std::size_t i=0 ; i<destinations.size() ; i++) {
+        if(destinations[i]<0 || destinations[i]>=static_cast<int>(owners.size())) return false;
+        asked[owners[destinations[i]]].push_back(static_cast<int>(i));
+    }
+    for(int s=0 ; s<nb_shards ; s++) {
+        if(asked[s].empty()) continue;
+        std::string payload;
+        std::size_t position = 0;
+        QueryProtocol::put(&payload, static_cast<std::uint32_t>(asked[s].size()));
+        for(int i : asked[s]) QueryProtocol::put(&payload, static_cast<std::int32_t>(destinations[i]));
+        if(!exchange(s, ShardProtocol::DISTANCES, payload, &answer)) return false;
+        for(int i : asked[s]) QueryProtocol::get(answer, &position, answer.size(), &(*distances)[i]);
+    }
+    if(path) {
+        path->clear();
+        if(!destinations.empty() && (*distances)[0]<std::numeric_limits<double>::infinity()) return this->path(destinations[0], path);
+    }
+    return true;
+}
+
+/*
+Forks the workers, each one talking to the coordinator on its own pair
+of sockets. Must be called before the graph is built, so that the
+workers do not keep a copy of it. Returns false if a worker cannot be
+started.
+*/
+bool ShardCluster::start() {
+    /* a worker that died must not kill the coordinator when it is written to */
+    signal(SIGPIPE, SIG_IGN);
+    for(int s=0 ; s<nb_shards ; s++) {
+        int ends[2];
+        if(socketpair(AF_UNIX, SOCK_STREAM, 0, ends)<0) {
+            std::cerr << "cannot create the socket of shard " << s << std::endl;
+            return false;
+        }
+        pid_t pid = fork();
+        if(pid<0) {
+            std::cerr << "cannot start the worker of shard " << s << std::endl;
+            close(ends[0]);
+            close(ends[1]);
+            return false;
+        }
+        if(pid==0) {
+            /* the worker stops when the coordinator closes its socket, not on a ^C to both */
+            signal(SIGINT, SIG_IGN);
+            for(int socket : sockets) close(socket);
+            close(ends[0]);
+            ShardWorker worker(ends[1]);
+            worker.run();
+            _exit(0);
+        }
+        close(ends[1]);
+        sockets.push_back(ends[0]);
+        workers.push_back(pid);
+    }
+    return true;
+}
@@ -0,0 +1,108 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ShardCluster_hpp
+#define ShardCluster_hpp
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+#include "components/Vertex.hpp"
+#include "components/Weight.hpp"
+#include "graph/FlowNetwork.hpp"
+#include "graph/Graph.hpp"
+#include "graph/KdTree.hpp"
+#include "ShardProtocol.hpp"
+
+/*
+Shortest paths on a graph split in shards, each held by its own process,
+to spread a graph over several processes or, later, machines. The graph
+is split by recursive coordinate bisection: the vertices are cut in two
+halves across the longer side of their bounding box, and so on, so that
+few edges link two shards. Each worker process gets the vertices of its
+shard, the arcs leaving them and their ends in the other shards, the
+boundary vertices, see server/ShardWorker.hpp.
+
+A search runs in rounds. In each round the shards with better distances
+for some of their vertices run Dijkstra inside the shard, in parallel,
+and send back the better distances they found for boundary vertices,
+which the coordinator hands to the shards owning them. The search stops
+when a round finds nothing better. Every distance is then the one
+Dijkstra finds on the whole graph, arcs being summed in the same order.
+
+The workers are forked by start(), before the graph is built, so that
+they hold nothing but their shard. They talk to the coordinator over
+local sockets, so that one machine simulates a cluster. The searches
+run one at a time.
+
+The coordinator does not build the representation of the graph: load()
+draws its topology as a list of edges, splits it into the payloads of
+the shards, and only keeps the vertices, in a k-d tree for the nearest
+vertex requests, and the arcs of the flow network, see
+graph/FlowNetwork.hpp. The flows run in the coordinator, several at a
+time.
+*/
+class ShardCluster {
+
+    public:
+    
+        ShardCluster(int);
+        ~ShardCluster();
+    
+        int getNbBoundary()   const { return nb_boundary; }
+        int getNbLastRounds() const { return nb_last_rounds; }
+        int getNbShards()     const { return nb_shards; }
+        int getNbVertices()   const { return static_cast<int>(vertices.size()); }
+    
+ static void bisect(const std::vector<Vertex*>&, int, std::vector<int>*);
+    
+        bool          load(GRAPH_GENERATOR, int);
+        WeightSum     max_flow(int, int, const std::atomic<bool>* =0) const;
+        const Vertex* nearest(double, double)                         const;
+        bool          shortest_paths(int, const std::vector<int>&, std::vector<double>*, std::vector<int>* =0);
+        bool          start();
+    
+    private:
+    
+        bool exchange(int, ShardProtocol::Opcode, const std::string&, std::string*);
+        bool load_shards(std::vector<std::pair<int, int>>*);
+        bool path(int, std::vector<int>*);
+        bool receive(int, ShardProtocol::Opcode, std::string*);
+    
+  const int                  nb_shards;        /* number of worker processes */
+        FlowNetwork*         flows;            /* arcs of the graph with their directions and capacities, for the maximum flows */
+        KdTree*              kdtree;           /* spatial index of the vertices, for the nearest vertex requests */
+        int                  nb_boundary;      /* vertices linked to another shard */
+        int                  nb_last_rounds;   /* rounds of the last search */
+        std::mutex           mutex;            /* lets one search run at a time */
+        std::vector<int>     owners;           /* shard of each vertex */
+        std::vector<int>     sockets;          /* socket to each worker */
+        std::vector<Vertex*> vertices;         /* coordinates of the vertices, the graph being held by the shards */
+        std::vector<pid_t>   workers;          /* process of each worker */
+
+};
+
+#endif
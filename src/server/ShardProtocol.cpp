@@ -0,0 +1,81 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cerrno>
+#include <cstdint>
+#include <unistd.h>
+
+#include "QueryProtocol.hpp"
+#include "ShardProtocol.hpp"
+
+/*
+Reads exactly size bytes. Returns false if the socket is closed.
+*/
+static bool read_all(int fd, char* data, std::size_t size) {
+    while(size>0) {
+        ssize_t n = read(fd, data, size);
+        if(n<0 && errno==EINTR) continue;
+        if(n<=0) return false;
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+/*
+Writes exactly size bytes. Returns false if the socket is closed.
+*/
+static bool write_all(int fd, const char* data, std::size_t size) {
+    while(size>0) {
+        ssize_t n = write(fd, data, size);
+        if(n<0 && errno==EINTR) continue;
+        if(n<=0) return false;
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+/*
+Reads a message. Returns false if the socket is closed.
+*/
+bool ShardProtocol::receive(int fd, Opcode* opcode, std::string* payload) {
+    std::string   header(QueryProtocol::HEADER_SIZE, '\0');
+    std::size_t   position = 1;
+    std::uint32_t size;
+    if(!read_all(fd, &header[0], header.size())) return false;
+    QueryProtocol::get(header, &position, header.size(), &size);
+    *opcode = static_cast<Opcode>(header[0]);
+    payload->resize(size);
+    return size==0 || read_all(fd, &(*payload)[0], size);
+}
+
+/*
+Writes a message. Returns false if the socket is closed.
+*/
+bool ShardProtocol::send(int fd, Opcode opcode, const std::string& payload) {
+    std::string frame(1, static_cast<char>(opcode));
+    QueryProtocol::put(&frame, static_cast<std::uint32_t>(payload.size()));
+    frame.append(payload);
+    return write_all(fd, frame.data(), frame.size());
+}
@@ -0,0 +1,58 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ShardProtocol_hpp
+#define ShardProtocol_hpp
+
+#include <string>
+
+/*
+Messages between the coordinator of a sharded graph and the processes
+of its shards, see server/ShardCluster.hpp. They go over a local socket
+as frames laid out like the ones of the query daemon: an opcode byte,
+the size of the payload on 4 bytes and the payload, written with
+QueryProtocol::put(). Each request is answered with a frame of the same
+opcode. Vertices are given by their identifier in the whole graph.
+
+    request     payload                                          answer
+    load        uint32 n, n times (int32 vertex, uint8 owned),   -
+                uint32 m, m times (uint32 from, uint32 to,
+                double length), from and to being positions
+                in the list of vertices
+    start       int32 source, -1 if the shard does not own it    -
+    round       uint32 k, k times (int32 vertex, double          same layout, better distances
+                distance, int32 previous vertex)                 found for the boundary vertices
+    distances   uint32 k, int32 vertices[k]                      double distances[k]
+    path        int32 vertex                                     uint32 k, int32 vertices[k]
+    stop        -                                                -
+*/
+namespace ShardProtocol {
+
+    enum Opcode {LOAD=1, START=2, ROUND=3, DISTANCES=4, PATH=5, STOP=6};   /* kind of message */
+    
+    bool receive(int, Opcode*, std::string*);
+    bool send(int, Opcode, const std::string&);
+
+}
+
+#endif
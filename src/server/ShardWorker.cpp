@@ -0,0 +1,203 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "QueryProtocol.hpp"
+#include "ShardProtocol.hpp"
+#include "ShardWorker.hpp"
+
+/*
+Worker talking to the coordinator on the given socket.
+*/
+ShardWorker::ShardWorker(int fd) :
+    fd(fd) {
+}
+
+/*
+Answers the messages of the coordinator until it sends stop or closes
+the socket.
+*/
+void ShardWorker::run() {
+    ShardProtocol::Opcode opcode;
+    std::string           input;
+    std::string           output;
+    while(ShardProtocol::receive(fd, &opcode, &input)) {
+        output.clear();
+        switch(opcode) {
+            case ShardProtocol::LOAD      : load(input);
+                                            break;
+            case ShardProtocol::START     : start(input);
+                                            break;
+            case ShardProtocol::ROUND     : round(input, &output);
+                                            break;
+            case ShardProtocol::DISTANCES : {
+                std::size_t   position = 0;
+                std::uint32_t n        = 0;
+                std::int32_t  v;
+                QueryProtocol::get(input, &position, input.size(), &n);
+                for(std::uint32_t i=0 ; i<n && QueryProtocol::get(input, &position, input.size(), &v) ; i++) {
+                    std::unordered_map<int, int>::const_iterator it = local.find(v);
+                    QueryProtocol::put(&output, it==local.end() ? std::numeric_limits<double>::infinity() : distances[it->second]);
+                }
+                break;
+            }
+            case ShardProtocol::PATH      : path(input, &output);
+                                            break;
+            case ShardProtocol::STOP      : ShardProtocol::send(fd, opcode, output);
+                                            return;
+        }
+        if(!ShardProtocol::send(fd, opcode, output)) return;
+    }
+}
+
+/*
+Builds the shard from a load message.
+*/
+void ShardWorker::load(const std::string& input) {
+    std::size_t   position = 0;
+    std::uint32_t n        = 0;
+    std::uint32_t m        = 0;
+    ids.clear();
+    owned.clear();
+    local.clear();
+    QueryProtocol::get(input, &position, input.size(), &n);
+    for(std::uint32_t i=0 ; i<n ; i++) {
+        std::int32_t v;
+        std::uint8_t o;
+        if(!QueryProtocol::get(input, &position, input.size(), &v) || !QueryProtocol::get(input, &position, input.size(), &o)) break;
+        local[v] = static_cast<int>(ids.size());
+        ids.push_back(v);
+        owned.push_back(o);
+    }
+    /* the arcs come in any order, they are sorted by tail */
+    QueryProtocol::get(input, &position, input.size(), &m);
+    std::vector<std::pair<std::uint32_t, Arc>> list;
+    list.reserve(m);
+    for(std::uint32_t i=0 ; i<m ; i++) {
+        std::uint32_t from;
+        Arc           a;
+        if(!QueryProtocol::get(input, &position, input.size(), &from) || !QueryProtocol::get(input, &position, input.size(), &a.to) || !QueryProtocol::get(input, &position, input.size(), &a.length)) break;
+        if(from<ids.size() && a.to<ids.size()) list.push_back(std::make_pair(from, a));
+    }
+    offsets.assign(ids.size()+1, 0);
+    for(const std::pair<std::uint32_t, Arc>& a : list) offsets[a.first+1]++;
+    for(std::size_t i=0 ; i<ids.size() ; i++) offsets[i+1] += offsets[i];
+    arcs.resize(list.size());
+    std::vector<std::size_t> next(offsets.begin(), offsets.end()-1);
+    for(const std::pair<std::uint32_t, Arc>& a : list) arcs[next[a.first]++] = a.second;
+    distances.assign(ids.size(), std::numeric_limits<double>::infinity());
+    marked.assign(ids.size(), 0);
+    previous.assign(ids.size(), -1);
+    seeds.clear();
+}
+
+/*
+Builds the path to a vertex of the shard backwards, until the source or
+a vertex of another shard.
+*/
+void ShardWorker::path(const std::string& input, std::string* output) {
+    std::size_t               position = 0;
+    std::int32_t              v        = -1;
+    std::vector<std::int32_t> vertices;
+    QueryProtocol::get(input, &position, input.size(), &v);
+    std::unordered_map<int, int>::const_iterator it = local.find(v);
+    vertices.push_back(v);
+    while(it!=local.end() && owned[it->second] && previous[it->second]>=0) {
+        v  = previous[it->second];
+        it = local.find(v);
+        vertices.push_back(v);
+    }
+    QueryProtocol::put(output, static_cast<std::uint32_t>(vertices.size()));
+    for(std::int32_t u : vertices) QueryProtocol::put(output, u);
+}
+
+/*
+Takes the better distances found for the vertices of the shard, runs
+Dijkstra from the vertices whose distance changed, and writes the better
+distances found for the boundary vertices. The boundary vertices are not
+searched from: their arcs belong to their own shard.
+*/
+void ShardWorker::round(const std::string& input, std::string* output) {
+    typedef std::pair<double, std::uint32_t> Entry;
+    std::size_t                                                         position = 0;
+    std::uint32_t                                                       n        = 0;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> search;
+    std::vector<std::uint32_t>                                          boundary;
+    QueryProtocol::get(input, &position, input.size(), &n);
+    for(std::uint32_t i=0 ; i<n ; i++) {
+        std::int32_t v, p;
+        double       d;
+        if(!QueryProtocol::get(input, &position, input.size(), &v) || !QueryProtocol::get(input, &position, input.size(), &d) || !QueryProtocol::get(input, &position, input.size(), &p)) break;
+        std::unordered_map<int, int>::const_iterator it = local.find(v);
+        if(it==local.end() || !owned[it->second] || d>=distances[it->second]) continue;
+        distances[it->second] = d;
+        previous[it->second]  = p;
+        seeds.push_back(it->second);
+    }
+    for(std::uint32_t s : seeds) search.push(Entry(distances[s], s));
+    seeds.clear();
+    while(!search.empty()) {
+        Entry e = search.top();
+        search.pop();
+        if(e.first>distances[e.second]) continue;
+        for(std::size_t i=offsets[e.second] ; i<offsets[e.second+1] ; i++) {
+            const Arc& a = arcs[i];
+            double     d = distances[e.second]+a.length;
+            if(d<distances[a.to]) {
+                distances[a.to] = d;
+                previous[a.to]  = ids[e.second];
+                if(owned[a.to])        search.push(Entry(d, a.to));
+                else if(!marked[a.to]) { marked[a.to] = 1; boundary.push_back(a.to); }
+            }
+        }
+    }
+    QueryProtocol::put(output, static_cast<std::uint32_t>(boundary.size()));
+    for(std::uint32_t b : boundary) {
+        QueryProtocol::put(output, ids[b]);
+        QueryProtocol::put(output, distances[b]);
+        QueryProtocol::put(output, previous[b]);
+        marked[b] = 0;
+    }
+}
+
+/*
+Forgets the last search, and starts a new one from the source if the
+shard owns it.
+*/
+void ShardWorker::start(const std::string& input) {
+    std::size_t  position = 0;
+    std::int32_t source   = -1;
+    QueryProtocol::get(input, &position, input.size(), &source);
+    distances.assign(ids.size(), std::numeric_limits<double>::infinity());
+    previous.assign(ids.size(), -1);
+    seeds.clear();
+    std::unordered_map<int, int>::const_iterator it = local.find(source);
+    if(it!=local.end() && owned[it->second]) {
+        distances[it->second] = 0;
+        seeds.push_back(it->second);
+    }
+}
@@ -0,0 +1,77 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ShardWorker_hpp
+#define ShardWorker_hpp
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+Process serving a shard of a graph, see server/ShardCluster.hpp. It
+holds the vertices of the shard, the boundary vertices of the other
+shards they are linked to, and the arcs leaving the vertices of the
+shard. A shortest path search runs in rounds: the worker takes the
+better distances found by the other shards for its vertices, runs
+Dijkstra from them inside the shard, and sends back the better
+distances it found for the boundary vertices.
+*/
+class ShardWorker {
+
+    public:
+    
+        ShardWorker(int);
+    
+        void run();
+    
+    private:
+    
+        /*
+        Arc leaving a vertex of the shard.
+        */
+        struct Arc {
+            std::uint32_t to;       /* head of the arc, as a position in the list of vertices */
+            double        length;   /* length of the arc */
+        };
+    
+        void load(const std::string&);
+        void round(const std::string&, std::string*);
+        void path(const std::string&, std::string*);
+        void start(const std::string&);
+    
+        std::vector<Arc>             arcs;        /* arcs leaving each vertex, by vertex */
+        std::vector<double>          distances;   /* distance of each vertex from the source of the search */
+        int                          fd;          /* socket to the coordinator */
+        std::vector<std::int32_t>    ids;         /* identifier of each vertex in the whole graph */
+        std::unordered_map<int, int> local;       /* position of each vertex in the list, by identifier */
+        std::vector<char>            marked;      /* 1 for the boundary vertices already in the answer of the round */
+        std::vector<std::size_t>     offsets;     /* position of the first arc of each vertex */
+        std::vector<char>            owned;       /* 1 for the vertices of the shard, 0 for the boundary vertices */
+        std::vector<std::int32_t>    previous;    /* identifier of the vertex before each one on its path, -1 if none */
+        std::vector<std::uint32_t>   seeds;       /* vertices of the shard whose distance changed since the last round */
+
+};
+
+#endif
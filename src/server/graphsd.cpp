@@ -0,0 +1,151 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "concurrency/ThreadPool.hpp"
+#include "graph/Graph.hpp"
+#include "LoadGenerator.hpp"
+#include "QueryServer.hpp"
+#include "ShardCluster.hpp"
+
+static QueryServer* server = 0;   /* server to stop on SIGINT and SIGTERM */
+
+/*
+Stops the server, from a signal handler.
+*/
+static void stop_server(int) {
+    if(server) server->stop();
+}
+
+/*
+Reads the name of a kind of request.
+*/
+static bool parse_query(const char* name, QueryProtocol::Opcode* kind) {
+    if(!strcmp(name, "route"))        *kind = QueryProtocol::ROUTE;
+    else if(!strcmp(name, "table"))   *kind = QueryProtocol::TABLE;
+    else if(!strcmp(name, "flow"))    *kind = QueryProtocol::FLOW;
+    else if(!strcmp(name, "nearest")) *kind = QueryProtocol::NEAREST;
+    else return false;
+    return true;
+}
+
+int main(int argc, const char * argv[]) {
+
+    /* arguments, see README.md */
+    bool                  binary      = false;
+    int                   connections = 4;
+    GRAPH_GENERATOR       generator   = GABRIEL;
+    QueryProtocol::Opcode kind        = QueryProtocol::ROUTE;
+    bool                  load        = false;
+    int                   nb_queries  = 10000;
+    std::string           path        = Constants::SERVER_SOCKET_PATH;
+    int                   pipeline    = 16;
+    uint64_t              seed        = static_cast<uint64_t>(time(NULL));
+    int                   shards      = 0;
+    int                   threads     = 1;
+    GRAPH_TYPE            type        = ADJACENCY_MATRIX;
+    int                   vertices    = 1000;
+    int                   workers     = static_cast<int>(std::thread::hardware_concurrency());
+    for(int i=1 ; i<argc ; i++) {
+        if(!strcmp(argv[i], "--load"))                             load        = true;
+        else if(!strcmp(argv[i], "--binary"))                      binary      = true;
+        else if(!strcmp(argv[i], "--bit-matrix"))                  type        = ADJACENCY_BIT_MATRIX;
+        else if(!strcmp(argv[i], "--connections") && i+1<argc)    connections = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--pipeline") && i+1<argc)       pipeline    = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--queries") && i+1<argc)        nb_queries  = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--seed") && i+1<argc)           seed        = strtoull(argv[++i], 0, 10);
+        else if(!strcmp(argv[i], "--shards") && i+1<argc)         shards      = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--socket") && i+1<argc)         path        = argv[++i];
+        else if(!strcmp(argv[i], "--threads") && i+1<argc)        threads     = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--vertices") && i+1<argc)       vertices    = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--workers") && i+1<argc)        workers     = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--generator") && i+1<argc) {
+            if(!Graph::parse_generator(argv[++i], &generator)) std::cerr << "unknown generator: " << argv[i] << std::endl;
+        }
+        else if(!strcmp(argv[i], "--query") && i+1<argc) {
+            if(!parse_query(argv[++i], &kind)) std::cerr << "unknown query: " << argv[i] << std::endl;
+        }
+        else std::cerr << "unknown argument: " << argv[i] << std::endl;
+    }
+    std::cout << "seed: " << seed << std::endl;
+    
+    /* load generator */
+    if(load) {
+        LoadGenerator client(path, connections, pipeline, binary);
+        return client.run(kind, nb_queries, seed) ? 0 : 1;
+    }
+    
+    /* the shard processes are forked first, so that they only get their shard */
+    ShardCluster* cluster = 0;
+    if(shards>0) {
+        cluster = new ShardCluster(shards);
+        if(!cluster->start()) {
+            delete cluster;
+            return 1;
+        }
+    }
+    
+    /* the requests run in parallel on the workers, each one on a single thread by default */
+    ThreadPool::setNbThreads(threads);
+    Graph::setSeed(seed);
+    Graph*       graph  = 0;
+    QueryServer* daemon = 0;
+    if(cluster) {
+        /* the graph is only held by the shards, the daemon does not build it */
+        if(!cluster->load(generator, vertices)) {
+            delete cluster;
+            return 1;
+        }
+        std::cout << "graph: " << Graph::generator_name(generator) << ", " << cluster->getNbVertices() << " vertices" << std::endl;
+        std::cout << "shards: " << cluster->getNbShards() << ", " << cluster->getNbBoundary() << " boundary vertices" << std::endl;
+        daemon = new QueryServer(cluster, path, std::max(workers, 1));
+    }
+    else {
+        graph = new Graph(type, vertices);
+        graph->setGenerator(generator);
+        graph->generate();
+        std::cout << "graph: " << Graph::generator_name(generator) << ", " << graph->getGraphRepresentation()->getVertices()->size() << " vertices" << std::endl;
+        daemon = new QueryServer(*graph, path, std::max(workers, 1));
+    }
+    
+    /* daemon */
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT,  stop_server);
+    signal(SIGTERM, stop_server);
+    server  = daemon;
+    bool ok = daemon->run();
+    server  = 0;
+    delete daemon;
+    delete graph;
+    delete cluster;
+    return ok ? 0 : 1;
+
+}
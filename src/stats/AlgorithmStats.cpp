@@ -0,0 +1,129 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <sstream>
+
+#include "AlgorithmStats.hpp"
+#include "AllocationCounter.hpp"
+#include "StatsRegistry.hpp"
+
+/*
+Initializes the counters.
+*/
+AlgorithmStats::AlgorithmStats() {
+    reset("");
+}
+
+/*
+Adds the counters of another run. The peak is the maximum of both.
+*/
+AlgorithmStats& AlgorithmStats::operator+=(const AlgorithmStats& s) {
+    wall_time        += s.wall_time;
+    vertices_settled += s.vertices_settled;
+    edges_relaxed    += s.edges_relaxed;
+    heap_pushes      += s.heap_pushes;
+    heap_pops        += s.heap_pops;
+    augmenting_paths += s.augmenting_paths;
+    recursion_nodes  += s.recursion_nodes;
+    bytes_allocated  += s.bytes_allocated;
+    peak_bytes        = std::max(peak_bytes, s.peak_bytes);
+    return *this;
+}
+
+/*
+Resets the counters for a new run of the given algorithm.
+*/
+void AlgorithmStats::reset(const std::string& name) {
+    algorithm        = name;
+    wall_time        = 0;
+    vertices_settled = 0;
+    edges_relaxed    = 0;
+    heap_pushes      = 0;
+    heap_pops        = 0;
+    augmenting_paths = 0;
+    recursion_nodes  = 0;
+    bytes_allocated  = 0;
+    peak_bytes       = 0;
+}
+
+/*
+Short description of the run, small enough for a window title.
+*/
+std::string AlgorithmStats::summary() const {
+    std::ostringstream s;
+    s.precision(3);
+    s << algorithm << " " << std::fixed << wall_time << " ms";
+    if(vertices_settled) s << ", " << vertices_settled << " settled";
+    if(edges_relaxed)    s << ", " << edges_relaxed << " relaxed";
+    if(augmenting_paths) s << ", " << augmenting_paths << " paths";
+    if(recursion_nodes)  s << ", " << recursion_nodes << " nodes";
+    if(peak_bytes)       s << ", " << peak_bytes/1024 << " kB peak";
+    return s.str();
+}
+
+/*
+Prints all the counters.
+*/
+std::ostream& operator<<(std::ostream& os, const AlgorithmStats& s) {
+    os << s.algorithm << ": "
+       << s.wall_time        << " ms, "
+       << s.vertices_settled << " vertices settled, "
+       << s.edges_relaxed    << " edges relaxed, "
+       << s.heap_pushes      << " heap pushes, "
+       << s.heap_pops        << " heap pops, "
+       << s.augmenting_paths << " augmenting paths, "
+       << s.recursion_nodes  << " recursion nodes, "
+       << s.bytes_allocated  << " bytes allocated, "
+       << s.peak_bytes       << " bytes peak";
+    return os;
+}
+
+/*
+Starts the measure if this is the outermost algorithm.
+*/
+StatsScope::StatsScope(AlgorithmStats* stats, int* depth, const char* name) :
+    allocated(AllocationCounter::thread_allocated_bytes()),
+    live(AllocationCounter::live_bytes()),
+    depth(depth),
+    start(std::chrono::steady_clock::now()),
+    stats(stats) {
+    if((*depth)++==0) {
+        stats->reset(name);
+        AllocationCounter::reset_peak();
+    }
+}
+
+/*
+Ends the measure and records the run if this is the outermost algorithm.
+*/
+StatsScope::~StatsScope() {
+    if(--(*depth)==0) {
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now()-start;
+        stats->wall_time       = elapsed.count();
+        stats->bytes_allocated = AllocationCounter::thread_allocated_bytes()-allocated;
+        unsigned long long peak = AllocationCounter::peak_bytes();
+        stats->peak_bytes      = peak>live ? peak-live : 0;
+        StatsRegistry::record(*stats);
+    }
+}
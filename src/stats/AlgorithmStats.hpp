@@ -0,0 +1,92 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AlgorithmStats_hpp
+#define AlgorithmStats_hpp
+
+#include <chrono>
+#include <ostream>
+#include <string>
+
+/*
+Counters of an algorithm run. The counters are only updated when the
+project is compiled with GRAPHS_STATS, otherwise the macros below expand
+to nothing and the algorithms are not slowed down.
+*/
+#ifdef GRAPHS_STATS
+    #define STATS_COUNT(stats, counter)   ((stats).counter++)
+    #define STATS_ADD(stats, counter, n)  ((stats).counter += (n))
+    #define STATS_SCOPE(stats, depth, name) StatsScope stats_scope(&(stats), &(depth), name)
+#else
+    #define STATS_COUNT(stats, counter)
+    #define STATS_ADD(stats, counter, n)
+    #define STATS_SCOPE(stats, depth, name)
+#endif
+
+struct AlgorithmStats {
+
+        AlgorithmStats();
+    
+        AlgorithmStats& operator+=(const AlgorithmStats&);
+    
+        void        reset(const std::string&);
+        std::string summary() const;
+    
+        std::string        algorithm;          /* name of the algorithm */
+        double             wall_time;          /* duration of the run, in milliseconds */
+        unsigned long long vertices_settled;   /* vertices extracted from the search structure */
+        unsigned long long edges_relaxed;      /* edges studied */
+        unsigned long long heap_pushes;        /* insertions in the priority structure */
+        unsigned long long heap_pops;          /* extractions from the priority structure */
+        unsigned long long augmenting_paths;   /* augmenting paths found (flow) */
+        unsigned long long recursion_nodes;    /* calls of the recursive search (Bron-Kerbosch, Traveling Salesman, Ford-Fulkerson) */
+        unsigned long long bytes_allocated;    /* memory allocated by the thread during the run */
+        unsigned long long peak_bytes;         /* sum of the peaks of the memory allocated by each thread during the run, above the level of the process at the start */
+
+};
+
+std::ostream& operator<<(std::ostream&, const AlgorithmStats&);
+
+/*
+Measures an algorithm run. Only the outermost scope of nested algorithms
+(A* called by the Traveling Salesman for instance) resets the counters,
+measures the time and records the run in the StatsRegistry.
+*/
+class StatsScope {
+
+    public:
+    
+        StatsScope(AlgorithmStats*, int*, const char*);
+        ~StatsScope();
+    
+    private:
+    
+        unsigned long long                    allocated;   /* bytes allocated by the thread when the run started */
+        unsigned long long                    live;        /* bytes allocated by the process when the run started */
+        int*                                  depth;       /* nesting level of the algorithms */
+        std::chrono::steady_clock::time_point start;       /* start of the run */
+        AlgorithmStats*                       stats;       /* counters of the run */
+
+};
+
+#endif
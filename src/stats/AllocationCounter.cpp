@@ -0,0 +1,210 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.hpp"
+
+/*
+Memory counters of a thread. Only the owning thread writes them, without
+read-modify-write operations, so that allocating never contends on a
+shared cache line; the readers sum the counters of all the threads. A
+block is released when its thread exits and reused by the next thread,
+which keeps the sums exact. The live bytes are signed since a thread can
+free blocks allocated by another one.
+*/
+struct ThreadBlock {
+    std::atomic<unsigned>  epoch;   /* peak measure the peak belongs to */
+    std::atomic<long long> live;    /* bytes allocated minus bytes freed by the thread */
+    ThreadBlock*           next;    /* next block of the list */
+    std::atomic<long long> peak;    /* maximum of live since the start of the peak measure */
+    std::atomic<bool>      used;    /* true while a thread owns the block */
+};
+
+/*
+Owner of the block of the current thread, releasing it when the thread
+exits. The memory freed by the thread after that goes to orphan_live.
+*/
+struct ThreadCounters {
+    unsigned long long allocated;   /* bytes allocated by the thread */
+    ThreadBlock*       block;       /* block owned by the thread */
+    bool               exited;      /* true once the thread released its block */
+    ~ThreadCounters();
+};
+
+/*
+Blocks of all the threads, the current peak measure, and the bytes freed
+by exiting threads after they released their block.
+*/
+static std::atomic<ThreadBlock*>  blocks(0);
+static std::atomic<unsigned>      epoch(0);
+static std::atomic<long long>     orphan_live(0);
+static thread_local ThreadCounters counters = {0, 0, false};
+
+/*
+Releases the block of the exiting thread.
+*/
+ThreadCounters::~ThreadCounters() {
+    if(block) block->used = false;
+    block  = 0;
+    exited = true;
+}
+
+/*
+Returns the number of bytes currently allocated by the process.
+*/
+unsigned long long AllocationCounter::live_bytes() {
+    long long live = orphan_live;
+    for(ThreadBlock* b=blocks.load() ; b ; b=b->next) live += b->live.load(std::memory_order_relaxed);
+    return live>0 ? live : 0;
+}
+
+/*
+Returns the sum of the peaks of the memory allocated by each thread since
+the last call to reset_peak(). The threads rarely peak together, so this
+is an upper bound of the peak of the process.
+*/
+unsigned long long AllocationCounter::peak_bytes() {
+    unsigned  current = epoch;
+    long long peak    = orphan_live;
+    for(ThreadBlock* b=blocks.load() ; b ; b=b->next) {
+        if(b->epoch.load(std::memory_order_relaxed)==current) peak += b->peak.load(std::memory_order_relaxed);
+        else                                                  peak += b->live.load(std::memory_order_relaxed);
+    }
+    return peak>0 ? peak : 0;
+}
+
+/*
+Starts a new peak measure from the current allocated memory. Each thread
+restarts its own peak on its next allocation or release.
+*/
+void AllocationCounter::reset_peak() {
+    ++epoch;
+}
+
+/*
+Returns the number of bytes allocated by the current thread so far.
+*/
+unsigned long long AllocationCounter::thread_allocated_bytes() {
+    return counters.allocated;
+}
+
+#ifdef GRAPHS_STATS
+
+/*
+Size of the header storing the size of each allocation. It keeps the
+alignment guaranteed by malloc.
+*/
+static const std::size_t HEADER_SIZE = 16;
+
+/*
+Returns the block of the current thread, taking a free block of the list
+or appending a new one on the first allocation of the thread. Returns
+null once the thread has exited.
+*/
+static ThreadBlock* thread_block() {
+    if(counters.block || counters.exited) return counters.block;
+    for(ThreadBlock* b=blocks.load() ; b ; b=b->next) {
+        bool used = false;
+        if(!b->used.load(std::memory_order_relaxed) && b->used.compare_exchange_strong(used, true)) {
+            counters.block = b;
+            return b;
+        }
+    }
+    ThreadBlock* b = static_cast<ThreadBlock*>(std::malloc(sizeof(ThreadBlock)));
+    if(!b) return 0;
+    new(b) ThreadBlock();
+    b->epoch = epoch.load();
+    b->live  = 0;
+    b->peak  = 0;
+    b->used  = true;
+    b->next  = blocks.load();
+    while(!blocks.compare_exchange_weak(b->next, b)) {}
+    counters.block = b;
+    return b;
+}
+
+/*
+Adds size bytes, negative when they are freed, to the live bytes of the
+current thread and updates its peak.
+*/
+static void count(long long size) {
+    ThreadBlock* b = thread_block();
+    if(!b) {
+        orphan_live.fetch_add(size, std::memory_order_relaxed);
+        return;
+    }
+    long long live    = b->live.load(std::memory_order_relaxed);
+    unsigned  current = epoch.load(std::memory_order_relaxed);
+    if(b->epoch.load(std::memory_order_relaxed)!=current) {
+        b->epoch.store(current, std::memory_order_relaxed);
+        b->peak.store(live, std::memory_order_relaxed);
+    }
+    live += size;
+    b->live.store(live, std::memory_order_relaxed);
+    if(live>b->peak.load(std::memory_order_relaxed)) b->peak.store(live, std::memory_order_relaxed);
+}
+
+/*
+Allocates the block with its header and updates the counters.
+*/
+static void* counted_malloc(std::size_t size) {
+    char* p = static_cast<char*>(std::malloc(size+HEADER_SIZE));
+    if(!p) return 0;
+    *reinterpret_cast<std::size_t*>(p) = size;
+    counters.allocated += size;
+    count(static_cast<long long>(size));
+    return p+HEADER_SIZE;
+}
+
+/*
+Frees the block allocated by counted_malloc() and updates the counters.
+*/
+static void counted_free(void* p) {
+    if(!p) return;
+    char* block = static_cast<char*>(p)-HEADER_SIZE;
+    count(-static_cast<long long>(*reinterpret_cast<std::size_t*>(block)));
+    std::free(block);
+}
+
+/*
+Replacements of the global allocation operators.
+*/
+void* operator new(std::size_t size) {
+    void* p = counted_malloc(size);
+    if(!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return counted_malloc(size);
+}
+void operator delete(void* p) noexcept {
+    counted_free(p);
+}
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    counted_free(p);
+}
+
+#endif
@@ -0,0 +1,46 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef AllocationCounter_hpp
+#define AllocationCounter_hpp
+
+/*
+Counts the bytes allocated with operator new by each thread, and the
+bytes currently allocated by the whole process with their peak. Each
+thread keeps its own counters, merged when they are read, so allocating
+does not contend with the other threads. The global allocation operators
+are only replaced when the project is compiled with GRAPHS_STATS,
+otherwise the counters stay at zero.
+*/
+class AllocationCounter {
+
+    public:
+    
+ static unsigned long long live_bytes();
+ static unsigned long long peak_bytes();
+ static void               reset_peak();
+ static unsigned long long thread_allocated_bytes();
+
+};
+
+#endif
@@ -0,0 +1,96 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "CacheCounter.hpp"
+
+#ifdef __linux__
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+Opens a counter, disabled, on each thread of the process, listed in
+/proc/self/task. It stays unavailable if the system does not provide
+the counters.
+*/
+CacheCounter::CacheCounter() {
+#ifdef __linux__
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.inherit        = 1;
+    DIR* tasks = opendir("/proc/self/task");
+    if(!tasks) return;
+    while(dirent* entry = readdir(tasks)) {
+        if(entry->d_name[0]=='.') continue;
+        int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, atoi(entry->d_name), -1, -1, 0));
+        if(fd>=0) fds.push_back(fd);
+    }
+    closedir(tasks);
+#endif
+}
+
+/*
+Closes the counters.
+*/
+CacheCounter::~CacheCounter() {
+#ifdef __linux__
+    for(int fd : fds) close(fd);
+#endif
+}
+
+/*
+Resets the counters and starts counting.
+*/
+void CacheCounter::start() {
+#ifdef __linux__
+    for(int fd : fds) ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    for(int fd : fds) ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+}
+
+/*
+Stops counting and returns the number of cache misses of all the
+threads since start(), 0 if the counters are not available.
+*/
+unsigned long long CacheCounter::stop() {
+    unsigned long long total = 0;
+#ifdef __linux__
+    for(int fd : fds) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    for(int fd : fds) {
+        unsigned long long count = 0;
+        if(read(fd, &count, sizeof(count))==static_cast<ssize_t>(sizeof(count))) total += count;
+    }
+#endif
+    return total;
+}
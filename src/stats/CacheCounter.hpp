@@ -0,0 +1,55 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CacheCounter_hpp
+#define CacheCounter_hpp
+
+#include <vector>
+
+/*
+Counts the cache misses of the process with the hardware counters of the
+processor. A counter is opened on each thread running when the counter
+is created, the ones of the ThreadPool included, and follows the threads
+they start; the misses of all of them are summed. Only available on
+Linux, when the kernel lets the process read its own counters (see
+perf_event_paranoid).
+*/
+class CacheCounter {
+
+    public:
+    
+        CacheCounter();
+        ~CacheCounter();
+    
+        bool available() const { return !fds.empty(); }
+    
+        void               start();
+        unsigned long long stop();
+    
+    private:
+    
+        std::vector<int> fds;   /* file descriptors of the counters of the threads, empty if they are not available */
+
+};
+
+#endif
@@ -0,0 +1,87 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "MemoryFootprint.hpp"
+
+/*
+Initializes the counters.
+*/
+MemoryFootprint::MemoryFootprint() :
+    index_bytes(0),
+    vertex_bytes(0),
+    edge_bytes(0),
+    allocator_overhead_bytes(0) {
+}
+
+/*
+Adds the memory of another structure.
+*/
+MemoryFootprint& MemoryFootprint::operator+=(const MemoryFootprint& f) {
+    index_bytes              += f.index_bytes;
+    vertex_bytes             += f.vertex_bytes;
+    edge_bytes               += f.edge_bytes;
+    allocator_overhead_bytes += f.allocator_overhead_bytes;
+    return *this;
+}
+
+/*
+Size of the heap chunk used for an allocation of the given size. This
+models glibc malloc on 64-bit systems: a size field of 8 bytes, chunks
+aligned on 16 bytes and no smaller than 32 bytes. With GRAPHS_STATS, the
+allocation counter adds its own header to every operator new.
+*/
+std::size_t MemoryFootprint::heap_chunk(std::size_t size) {
+    #ifdef GRAPHS_STATS
+        size += 16;
+    #endif
+    std::size_t chunk = (size+8+15) & ~static_cast<std::size_t>(15);
+    return chunk<32 ? 32 : chunk;
+}
+
+/*
+Accounts for the overhead of n allocations of the given size, and adds
+their payload to the given counter.
+*/
+void MemoryFootprint::add_allocations(unsigned long long n, std::size_t size, unsigned long long* payload) {
+    *payload                 += n*size;
+    allocator_overhead_bytes += n*(heap_chunk(size)-size);
+}
+
+/*
+Total memory, in bytes.
+*/
+unsigned long long MemoryFootprint::total() const {
+    return index_bytes+vertex_bytes+edge_bytes+allocator_overhead_bytes;
+}
+
+/*
+Prints the memory by category.
+*/
+std::ostream& operator<<(std::ostream& os, const MemoryFootprint& f) {
+    os << f.total()                  << " bytes ("
+       << f.index_bytes              << " index, "
+       << f.vertex_bytes             << " vertices, "
+       << f.edge_bytes               << " edges, "
+       << f.allocator_overhead_bytes << " allocator overhead)";
+    return os;
+}
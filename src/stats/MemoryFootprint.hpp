@@ -0,0 +1,54 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MemoryFootprint_hpp
+#define MemoryFootprint_hpp
+
+#include <cstddef>
+#include <ostream>
+
+/*
+Memory used by a graph representation, in bytes. The payload is what
+the objects need, the allocator overhead is what the heap adds to each
+allocation for its bookkeeping and alignment.
+*/
+struct MemoryFootprint {
+
+        MemoryFootprint();
+    
+        MemoryFootprint& operator+=(const MemoryFootprint&);
+    
+ static std::size_t        heap_chunk(std::size_t);
+        void               add_allocations(unsigned long long, std::size_t, unsigned long long*);
+        unsigned long long total() const;
+
+        unsigned long long index_bytes;                /* index structures: adjacency matrix, lists of edges and vertices */
+        unsigned long long vertex_bytes;               /* Vertex objects */
+        unsigned long long edge_bytes;                 /* Edge objects */
+        unsigned long long allocator_overhead_bytes;   /* headers and padding added by the heap to each allocation */
+
+};
+
+std::ostream& operator<<(std::ostream&, const MemoryFootprint&);
+
+#endif
@@ -0,0 +1,52 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "StatsRegistry.hpp"
+
+/*
+Static variables.
+*/
+std::mutex                                            StatsRegistry::mutex;
+std::map<std::string, std::pair<int, AlgorithmStats>> StatsRegistry::totals;
+
+/*
+Prints the number of runs, the average time and the summed counters
+of each algorithm.
+*/
+void StatsRegistry::print(std::ostream& os) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for(const std::pair<const std::string, std::pair<int, AlgorithmStats>>& t : totals) {
+        os << t.second.first << " run(s), " << t.second.second.wall_time/t.second.first << " ms on average - " << t.second.second << std::endl;
+    }
+}
+
+/*
+Adds a run to the totals of its algorithm.
+*/
+void StatsRegistry::record(const AlgorithmStats& stats) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::pair<int, AlgorithmStats>& t = totals[stats.algorithm];
+    if(t.first==0) t.second.algorithm = stats.algorithm;
+    t.first++;
+    t.second += stats;
+}
@@ -0,0 +1,51 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef StatsRegistry_hpp
+#define StatsRegistry_hpp
+
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#include "AlgorithmStats.hpp"
+
+/*
+Process-wide aggregation of the algorithm runs, by algorithm name.
+*/
+class StatsRegistry {
+
+    public:
+    
+ static void print(std::ostream&);
+ static void record(const AlgorithmStats&);
+    
+    private:
+    
+ static std::mutex                                            mutex;   /* protects the totals, runs can end on any thread */
+ static std::map<std::string, std::pair<int, AlgorithmStats>> totals;  /* number of runs and summed counters of each algorithm */
+
+};
+
+#endif
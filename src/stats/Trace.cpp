@@ -0,0 +1,133 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+
+#include "Trace.hpp"
+
+/*
+Static variables.
+*/
+std::vector<Trace::ThreadBuffer*> Trace::buffers;
+std::mutex                        Trace::mutex;
+
+/*
+Returns true if the GRAPHS_TRACE environment variable is set. The first
+call registers the function that writes the trace at exit.
+*/
+bool Trace::enabled() {
+    static const bool trace_enabled = []() {
+        bool e = std::getenv("GRAPHS_TRACE")!=0;
+        if(e) {
+            now();
+            std::atexit(flush);
+        }
+        return e;
+    }();
+    return trace_enabled;
+}
+
+/*
+Returns the time elapsed since the start of the trace, in microseconds.
+*/
+double Trace::now() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now()-start;
+    return elapsed.count();
+}
+
+/*
+Returns the buffer of the current thread, created on first use.
+*/
+Trace::ThreadBuffer* Trace::thread_buffer() {
+    static thread_local ThreadBuffer* buffer = 0;
+    if(!buffer) {
+        buffer        = new ThreadBuffer;
+        buffer->first = new Chunk;
+        buffer->first->size = 0;
+        buffer->first->next = 0;
+        buffer->last  = buffer->first;
+        std::lock_guard<std::mutex> lock(mutex);
+        buffer->tid   = static_cast<int>(buffers.size())+1;
+        buffers.push_back(buffer);
+    }
+    return buffer;
+}
+
+/*
+Appends a span to the buffer of the current thread. This does not lock:
+the event is written first and then published by increasing the size.
+*/
+void Trace::record(const char* name, double start, double duration) {
+    ThreadBuffer* buffer = thread_buffer();
+    Chunk*        chunk  = buffer->last;
+    int           size   = chunk->size.load(std::memory_order_relaxed);
+    if(size==4096) {
+        Chunk* next = new Chunk;
+        next->size  = 0;
+        next->next  = 0;
+        chunk->next.store(next, std::memory_order_release);
+        buffer->last = chunk = next;
+        size         = 0;
+    }
+    chunk->events[size].name     = name;
+    chunk->events[size].start    = start;
+    chunk->events[size].duration = duration;
+    chunk->size.store(size+1, std::memory_order_release);
+}
+
+/*
+Writes the published events of all the threads to the file given by the
+GRAPHS_TRACE environment variable, in the Chrome trace-event format.
+*/
+void Trace::flush() {
+    const char*   path = std::getenv("GRAPHS_TRACE");
+    std::ofstream file(path && *path ? path : "trace.json");
+    if(!file) {
+        std::cerr << "cannot write the trace file" << std::endl;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    bool first = true;
+    int  pid   = static_cast<int>(getpid());
+    file << "{\"traceEvents\":[";
+    file.setf(std::ios::fixed);
+    file.precision(3);
+    for(const ThreadBuffer* buffer : buffers) {
+        for(const Chunk* chunk=buffer->first ; chunk ; chunk=chunk->next.load(std::memory_order_acquire)) {
+            int size = chunk->size.load(std::memory_order_acquire);
+            for(int i=0 ; i<size ; i++) {
+                const Event& e = chunk->events[i];
+                file << (first ? "" : ",") << std::endl
+                     << "{\"name\":\"" << e.name << "\",\"cat\":\"graphs\",\"ph\":\"X\",\"ts\":" << e.start
+                     << ",\"dur\":" << e.duration << ",\"pid\":" << pid << ",\"tid\":" << buffer->tid << "}";
+                first = false;
+            }
+        }
+    }
+    file << std::endl << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+}
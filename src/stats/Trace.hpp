@@ -0,0 +1,93 @@
+/*
+Graphs - Copyright (C) 2016 - Olivier Deiss - olivier.deiss@gmail.com
+
+Graphs is a toolbox for graph theory. It includes graph algorithms
+and an interface to visualize them, using OpengGL. The project
+comes with a function to generate random Gabriel graphs. These
+graphs look like road maps and are therefore nice for the study of
+lots of graph algorithms.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef Trace_hpp
+#define Trace_hpp
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/*
+Scoped tracing spans, written as a Chrome trace-event file that can be
+opened with chrome://tracing or Perfetto. Tracing is enabled by setting
+the GRAPHS_TRACE environment variable to the path of the output file;
+the file is written when the program exits. When it is not set, a span
+costs a single test.
+*/
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b)  TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name)   TraceSpan TRACE_CONCAT(trace_span_, __LINE__)(name)
+
+class Trace {
+
+    public:
+    
+ static bool   enabled();
+ static void   flush();
+ static void   record(const char*, double, double);
+ static double now();
+    
+    private:
+    
+        struct Event {
+            const char* name;        /* name of the span, a string literal */
+            double      start;       /* start of the span, in microseconds */
+            double      duration;    /* duration of the span, in microseconds */
+        };
+    
+        /* Events of a thread. Only the owner thread writes, the events are
+        published with the size so that flush() can read them at any time. */
+        struct Chunk {
+            Event               events[4096];   /* storage */
+            std::atomic<int>    size;           /* number of published events */
+            std::atomic<Chunk*> next;           /* next chunk, once this one is full */
+        };
+        struct ThreadBuffer {
+            int    tid;     /* identifier of the thread in the trace */
+            Chunk* first;   /* first chunk of events */
+            Chunk* last;    /* chunk being filled */
+        };
+    
+ static ThreadBuffer* thread_buffer();
+    
+ static std::vector<ThreadBuffer*> buffers;   /* buffers of all the threads that recorded a span */
+ static std::mutex                 mutex;     /* protects the list of buffers, only locked once per thread */
+
+};
+
+class TraceSpan {
+
+    public:
+    
+        TraceSpan(const char* name) : name(name), start(Trace::enabled() ? Trace::now() : -1) {}
+        ~TraceSpan() { if(start>=0) Trace::record(name, start, Trace::now()-start); }
+    
+    private:
+    
+        const char* name;    /* name of the span */
+        double      start;   /* start of the span, negative if tracing is disabled */
+
+};
+
+#endif